@@ -95,6 +95,7 @@ enum ItemRoles {
     kItemTreeViewExpandedRole = Qt::UserRole + 35,
     kItemTreeViewCanExpandRole = Qt::UserRole + 36, // item can expand
     kItemUpdateAndTransFileInfoRole = Qt::UserRole + 37,
+    kItemFilePinyinInitialsRole = Qt::UserRole + 38,
     kItemUnknowRole = Qt::UserRole + 999
 };
 
@@ -37,6 +37,7 @@ public:
     };
 
     explicit FilterAppender(const QString &fileName = QString());
+    ~FilterAppender() override;
 
     DatePattern datePattern() const;
     void setDatePattern(DatePattern datePattern);
@@ -51,6 +52,8 @@ public:
     const QStringList &getFilters() const;
     void clearFilters();
 
+    quint64 droppedRecords() const;
+
 protected:
     virtual void append(const QDateTime &timeStamp, DTK_CORE_NAMESPACE::Logger::LogLevel logLevel, const char *file, int line,
                         const char *function, const QString &category, const QString &message) override;
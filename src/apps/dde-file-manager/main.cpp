@@ -11,6 +11,7 @@
 #include <dfm-base/dfm_plugin_defines.h>
 #include <dfm-base/utils/sysinfoutils.h>
 #include <dfm-base/utils/loggerrules.h>
+#include <dfm-base/utils/tracer.h>
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
 
 #include <dfm-framework/dpf.h>
@@ -122,6 +123,7 @@ static QStringList buildBlackNames()
 
 static bool pluginsLoad()
 {
+    dfmTraceSpan("startup", "pluginsLoad");
     QString msg;
     if (!DConfigManager::instance()->addConfig(kPluginsDConfName, &msg))
         qCWarning(logAppFileManager) << "Load plugins but dconfig failed: " << msg;
@@ -163,13 +165,17 @@ static bool pluginsLoad()
         return false;
     if (!corePlugin->fileName().contains(kLibCore))
         return false;
-    if (!DPF_NAMESPACE::LifeCycle::loadPlugin(corePlugin))
-        return false;
+    {
+        dfmTraceSpan("startup", "loadCorePlugin");
+        if (!DPF_NAMESPACE::LifeCycle::loadPlugin(corePlugin))
+            return false;
+    }
 
     // start filemanager, must called it after core plugin loaded
     CommandParser::instance().bindEvents();
 
     // load plugins without core
+    dfmTraceSpan("startup", "loadPlugins");
     if (!DPF_NAMESPACE::LifeCycle::loadPlugins())
         return false;
 
@@ -317,6 +323,8 @@ int main(int argc, char *argv[])
         isSingleInstance = a.setSingleInstance(uniqueKey);
 
     if (isSingleInstance) {
+        Tracer::initialize();
+
         // check upgrade
         checkUpgrade(&a);
 
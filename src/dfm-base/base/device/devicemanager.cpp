@@ -68,35 +68,11 @@ QStringList DeviceManager::getAllBlockDevID(DeviceQueryOptions opts)
     if (opts.testFlag(DeviceQueryOption::kNoCondition))
         return ret;
 
-    QString errMsg;
     QStringList filteredRet;
     for (const auto &id : ret) {
         const auto &&data = d->watcher->getDevInfo(id, DeviceType::kBlockDevice, false);
-        if (opts.testFlag(DeviceQueryOption::kMounted)
-            && data.value(DeviceProperty::kMountPoint).toString().isEmpty())
-            continue;
-        if (opts.testFlag(DeviceQueryOption::kRemovable)
-            && !data.value(DeviceProperty::kRemovable).toBool())
-            continue;
-        if (opts.testFlag(DeviceQueryOption::kMountable)
-            && !DeviceHelper::isMountableBlockDev(data, errMsg))
-            continue;
-        if (opts.testFlag(DeviceQueryOption::kNotIgnored)
-            && data.value(DeviceProperty::kHintIgnore).toBool())
-            continue;
-        if (opts.testFlag(DeviceQueryOption::kNotMounted)
-            && !data.value(DeviceProperty::kMountPoint).toString().isEmpty())
-            continue;
-        if (opts.testFlag(DeviceQueryOption::kOptical)
-            && !data.value(DeviceProperty::kOptical).toBool())
-            continue;
-        if (opts.testFlag(DeviceQueryOption::kSystem)
-            && !DeviceUtils::isSystemDisk(data))
-            continue;
-        if (opts.testFlag(DeviceQueryOption::kLoop)
-            && !data.value(DeviceProperty::kIsLoopDevice).toBool())
-            continue;
-        filteredRet << id;
+        if (DeviceHelper::isMatchedQueryOptions(data, opts))
+            filteredRet << id;
     }
     return filteredRet;
 }
@@ -6,8 +6,10 @@
 #include "devicemanager.h"
 #include "deviceutils.h"
 #include "private/deviceproxymanager_p.h"
+#include "private/devicehelper.h"
 
 #include <QDBusServiceWatcher>
+#include <QDBusPendingReply>
 
 using namespace dfmbase;
 static constexpr char kDeviceService[] { "org.deepin.filemanager.server" };
@@ -26,10 +28,9 @@ const OrgDeepinFilemanagerServerDeviceManagerInterface *DeviceProxyManager::getD
 
 QStringList DeviceProxyManager::getAllBlockIds(GlobalServerDefines::DeviceQueryOptions opts)
 {
-    if (d->isDBusRuning() && d->devMngDBus) {
-        auto &&reply = d->devMngDBus->GetBlockDevicesIdList(opts);
-        reply.waitForFinished();
-        return reply.value();
+    if (d->isDBusConnected()) {
+        d->initReplica();
+        return d->replicaIds(true, opts);
     } else {
         return DevMngIns->getAllBlockDevID(opts);
     }
@@ -49,10 +50,9 @@ QStringList DeviceProxyManager::getAllBlockIdsByUUID(const QStringList &uuids, G
 
 QStringList DeviceProxyManager::getAllProtocolIds()
 {
-    if (d->isDBusRuning() && d->devMngDBus) {
-        auto &&reply = d->devMngDBus->GetProtocolDevicesIdList();
-        reply.waitForFinished();
-        return reply.value();
+    if (d->isDBusConnected()) {
+        d->initReplica();
+        return d->replicaIds(false);
     } else {
         return DevMngIns->getAllProtocolDevID();
     }
@@ -60,10 +60,19 @@ QStringList DeviceProxyManager::getAllProtocolIds()
 
 QVariantMap DeviceProxyManager::queryBlockInfo(const QString &id, bool reload)
 {
-    if (d->isDBusRuning() && d->devMngDBus) {
+    if (d->isDBusConnected()) {
+        QVariantMap info;
+        if (!reload) {
+            d->initReplica();
+            if (d->findReplica(id, true, &info))
+                return info;
+        }
+
         auto &&reply = d->devMngDBus->QueryBlockDeviceInfo(id, reload);
         reply.waitForFinished();
-        return reply.value();
+        info = reply.value();
+        d->setReplica(id, true, info);
+        return info;
     } else {
         return DevMngIns->getBlockDevInfo(id, reload);
     }
@@ -71,10 +80,19 @@ QVariantMap DeviceProxyManager::queryBlockInfo(const QString &id, bool reload)
 
 QVariantMap DeviceProxyManager::queryProtocolInfo(const QString &id, bool reload)
 {
-    if (d->isDBusRuning() && d->devMngDBus) {
+    if (d->isDBusConnected()) {
+        QVariantMap info;
+        if (!reload) {
+            d->initReplica();
+            if (d->findReplica(id, false, &info))
+                return info;
+        }
+
         auto &&reply = d->devMngDBus->QueryProtocolDeviceInfo(id, reload);
         reply.waitForFinished();
-        return reply.value();
+        info = reply.value();
+        d->setReplica(id, false, info);
+        return info;
     } else {
         return DevMngIns->getProtocolDevInfo(id, reload);
     }
@@ -82,7 +100,7 @@ QVariantMap DeviceProxyManager::queryProtocolInfo(const QString &id, bool reload
 
 void DeviceProxyManager::reloadOpticalInfo(const QString &id)
 {
-    if (d->isDBusRuning() && d->devMngDBus)
+    if (d->isDBusConnected())
         queryBlockInfo(id, true);
     else
         DevMngIns->getBlockDevInfo(id, true);
@@ -207,6 +225,7 @@ void DeviceProxyManagerPrivate::initConnection()
     });
     q->connect(dbusWatcher.data(), &QDBusServiceWatcher::serviceUnregistered, q, [this] {
         devMngDBus.reset();
+        resetReplica();
         connectToAPI();
         emit q->devMngDBusUnregistered();
         qCWarning(logDFMBase) << "server dbus unregistered, connected to API...";
@@ -258,9 +277,32 @@ void DeviceProxyManagerPrivate::connectToDBus()
     }
 
     disconnCurrentConnections();
+    resetReplica();
 
     devMngDBus.reset(new DeviceManagerInterface(kDeviceService, kDevMngPath, QDBusConnection::sessionBus(), this));
     auto ptr = devMngDBus.data();
+
+    // the replica must be updated before the signals are forwarded, the receivers may query the device at once.
+    connections << q->connect(ptr, &DeviceManagerInterface::BlockDeviceAdded, this, &DeviceProxyManagerPrivate::reloadBlockReplica);
+    connections << q->connect(ptr, &DeviceManagerInterface::BlockDeviceRemoved, this, &DeviceProxyManagerPrivate::removeBlockReplica);
+    connections << q->connect(ptr, &DeviceManagerInterface::BlockDeviceMounted, this, &DeviceProxyManagerPrivate::reloadBlockReplica);
+    connections << q->connect(ptr, &DeviceManagerInterface::BlockDeviceUnmounted, this, &DeviceProxyManagerPrivate::reloadBlockReplica);
+    connections << q->connect(ptr, &DeviceManagerInterface::BlockDeviceLocked, this, &DeviceProxyManagerPrivate::reloadBlockReplica);
+    connections << q->connect(ptr, &DeviceManagerInterface::BlockDeviceUnlocked, this, [this](const QString &id, const QString &cleartextId) {
+        reloadBlockReplica(id);
+        reloadBlockReplica(cleartextId);
+    });
+    connections << q->connect(ptr, &DeviceManagerInterface::BlockDeviceFilesystemAdded, this, &DeviceProxyManagerPrivate::reloadBlockReplica);
+    connections << q->connect(ptr, &DeviceManagerInterface::BlockDeviceFilesystemRemoved, this, &DeviceProxyManagerPrivate::reloadBlockReplica);
+    connections << q->connect(ptr, &DeviceManagerInterface::BlockDevicePropertyChanged, this, [this](const QString &id, const QString &property, const QDBusVariant &value) {
+        updateBlockReplicaProperty(id, property, value.variant());
+    });
+    connections << q->connect(ptr, &DeviceManagerInterface::SizeUsedChanged, this, &DeviceProxyManagerPrivate::updateReplicaSize);
+    connections << q->connect(ptr, &DeviceManagerInterface::ProtocolDeviceAdded, this, &DeviceProxyManagerPrivate::reloadProtocolReplica);
+    connections << q->connect(ptr, &DeviceManagerInterface::ProtocolDeviceRemoved, this, &DeviceProxyManagerPrivate::removeProtocolReplica);
+    connections << q->connect(ptr, &DeviceManagerInterface::ProtocolDeviceMounted, this, &DeviceProxyManagerPrivate::reloadProtocolReplica);
+    connections << q->connect(ptr, &DeviceManagerInterface::ProtocolDeviceUnmounted, this, &DeviceProxyManagerPrivate::reloadProtocolReplica);
+
     connections << q->connect(ptr, &DeviceManagerInterface::BlockDriveAdded, q, &DeviceProxyManager::blockDriveAdded);
     connections << q->connect(ptr, &DeviceManagerInterface::BlockDriveRemoved, q, &DeviceProxyManager::blockDriveRemoved);
     connections << q->connect(ptr, &DeviceManagerInterface::BlockDeviceAdded, q, &DeviceProxyManager::blockDevAdded);
@@ -345,6 +387,216 @@ void DeviceProxyManagerPrivate::disconnCurrentConnections()
     currentConnectionType = kNoneConnection;
 }
 
+bool DeviceProxyManagerPrivate::isDBusConnected() const
+{
+    return currentConnectionType == kDBusConnecting && devMngDBus;
+}
+
+/*!
+ * \brief fetch the snapshot of all devices. The queries are sent at once and
+ * waited together, so it costs about one round trip.
+ */
+void DeviceProxyManagerPrivate::initReplica()
+{
+    if (replicaReady || !isDBusConnected())
+        return;
+
+    QMutexLocker initLocker(&replicaInitMutex);
+    if (replicaReady)
+        return;
+
+    const int changes = replicaChanges;
+    auto blockIdsReply = devMngDBus->GetBlockDevicesIdList(GlobalServerDefines::DeviceQueryOption::kNoCondition);
+    auto protocolIdsReply = devMngDBus->GetProtocolDevicesIdList();
+    blockIdsReply.waitForFinished();
+    protocolIdsReply.waitForFinished();
+    if (blockIdsReply.isError() || protocolIdsReply.isError()) {
+        qCWarning(logDFMBase) << "failed to fetch devices from server:" << blockIdsReply.error().message();
+        return;
+    }
+
+    QList<QPair<QString, QDBusPendingReply<QVariantMap>>> blockReplies;
+    for (const auto &id : blockIdsReply.value())
+        blockReplies.append({ id, devMngDBus->QueryBlockDeviceInfo(id, false) });
+    QList<QPair<QString, QDBusPendingReply<QVariantMap>>> protocolReplies;
+    for (const auto &id : protocolIdsReply.value())
+        protocolReplies.append({ id, devMngDBus->QueryProtocolDeviceInfo(id, false) });
+
+    QMap<QString, QVariantMap> blocks;
+    for (auto &reply : blockReplies) {
+        reply.second.waitForFinished();
+        if (!reply.second.isError())
+            blocks.insert(reply.first, reply.second.value());
+    }
+    QMap<QString, QVariantMap> protocols;
+    for (auto &reply : protocolReplies) {
+        reply.second.waitForFinished();
+        if (!reply.second.isError())
+            protocols.insert(reply.first, reply.second.value());
+    }
+
+    QWriteLocker lk(&replicaLock);
+    blockReplica = blocks;
+    protocolReplica = protocols;
+    // the devices changed while fetching, fetch them again at the next query
+    replicaReady = (changes == replicaChanges);
+}
+
+void DeviceProxyManagerPrivate::resetReplica()
+{
+    QWriteLocker lk(&replicaLock);
+    replicaReady = false;
+    blockReplica.clear();
+    protocolReplica.clear();
+}
+
+bool DeviceProxyManagerPrivate::findReplica(const QString &id, bool isBlock, QVariantMap *info)
+{
+    if (!replicaReady)
+        return false;
+
+    QReadLocker lk(&replicaLock);
+    const auto &replica = isBlock ? blockReplica : protocolReplica;
+    auto iter = replica.constFind(id);
+    if (iter == replica.cend())
+        return false;
+
+    if (info)
+        *info = iter.value();
+    return true;
+}
+
+QStringList DeviceProxyManagerPrivate::replicaIds(bool isBlock, GlobalServerDefines::DeviceQueryOptions opts)
+{
+    if (!replicaReady) {
+        // fallback to the server
+        if (isBlock) {
+            auto &&reply = devMngDBus->GetBlockDevicesIdList(opts);
+            reply.waitForFinished();
+            return reply.value();
+        }
+        auto &&reply = devMngDBus->GetProtocolDevicesIdList();
+        reply.waitForFinished();
+        return reply.value();
+    }
+
+    QReadLocker lk(&replicaLock);
+    if (!isBlock)
+        return protocolReplica.keys();
+
+    // the keys are sorted as the server does
+    if (opts == GlobalServerDefines::DeviceQueryOption::kNoCondition)
+        return blockReplica.keys();
+
+    QStringList ids;
+    for (auto iter = blockReplica.cbegin(); iter != blockReplica.cend(); ++iter) {
+        if (DeviceHelper::isMatchedQueryOptions(iter.value(), opts))
+            ids << iter.key();
+    }
+    return ids;
+}
+
+void DeviceProxyManagerPrivate::setReplica(const QString &id, bool isBlock, const QVariantMap &info)
+{
+    if (id.isEmpty() || info.isEmpty())
+        return;
+
+    QWriteLocker lk(&replicaLock);
+    auto &replica = isBlock ? blockReplica : protocolReplica;
+    replica.insert(id, info);
+}
+
+void DeviceProxyManagerPrivate::reloadBlockReplica(const QString &id)
+{
+    ++replicaChanges;
+    if (!replicaReady || id.isEmpty() || !isDBusConnected())
+        return;
+
+    auto &&reply = devMngDBus->QueryBlockDeviceInfo(id, false);
+    reply.waitForFinished();
+    setReplica(id, true, reply.value());
+}
+
+void DeviceProxyManagerPrivate::reloadProtocolReplica(const QString &id)
+{
+    ++replicaChanges;
+    if (!replicaReady || id.isEmpty() || !isDBusConnected())
+        return;
+
+    auto &&reply = devMngDBus->QueryProtocolDeviceInfo(id, false);
+    reply.waitForFinished();
+    setReplica(id, false, reply.value());
+}
+
+void DeviceProxyManagerPrivate::removeBlockReplica(const QString &id)
+{
+    ++replicaChanges;
+    QWriteLocker lk(&replicaLock);
+    blockReplica.remove(id);
+}
+
+void DeviceProxyManagerPrivate::removeProtocolReplica(const QString &id)
+{
+    ++replicaChanges;
+    QWriteLocker lk(&replicaLock);
+    protocolReplica.remove(id);
+}
+
+/*!
+ * \brief keep the replica as the server keeps its device info, see DeviceWatcher::onBlkDevPropertiesChanged.
+ * The optical info is probed from the media on the server, the entry is reloaded when the media changes.
+ */
+void DeviceProxyManagerPrivate::updateBlockReplicaProperty(const QString &id, const QString &property, const QVariant &value)
+{
+    using namespace GlobalServerDefines;
+    ++replicaChanges;
+    if (!replicaReady)
+        return;
+
+    static const QStringList kMediaProperties { DeviceProperty::kMedia, DeviceProperty::kMediaAvailable,
+                                                DeviceProperty::kMediaCompatibility, DeviceProperty::kOpticalBlank };
+    if (kMediaProperties.contains(property) && isDBusConnected()) {
+        auto &&reply = devMngDBus->QueryBlockDeviceInfo(id, true);
+        reply.waitForFinished();
+        if (!reply.isError() && !reply.value().isEmpty()) {
+            setReplica(id, true, reply.value());
+            return;
+        }
+    }
+
+    QWriteLocker lk(&replicaLock);
+    auto iter = blockReplica.find(id);
+    if (iter == blockReplica.end())
+        return;
+
+    iter->insert(property, value);
+    // the unmounted path is kept until the device is unmounted
+    if (property == DeviceProperty::kMountPoints && !value.toStringList().isEmpty())
+        iter->insert(DeviceProperty::kMountPoint, value.toStringList().first());
+    if (property == DeviceProperty::kOptical && !value.toBool()) {
+        iter->insert(DeviceProperty::kOpticalMediaType, "");
+        iter->insert(DeviceProperty::kOpticalWriteSpeed, QStringList());
+        iter->insert(DeviceProperty::kSizeTotal, 0);
+        iter->insert(DeviceProperty::kSizeFree, 0);
+        iter->insert(DeviceProperty::kSizeUsed, 0);
+    }
+}
+
+void DeviceProxyManagerPrivate::updateReplicaSize(const QString &id, qint64 total, qint64 free)
+{
+    using namespace GlobalServerDefines;
+    ++replicaChanges;
+    QWriteLocker lk(&replicaLock);
+    auto &replica = id.startsWith(kBlockDeviceIdPrefix) ? blockReplica : protocolReplica;
+    auto iter = replica.find(id);
+    if (iter == replica.end())
+        return;
+
+    iter->insert(DeviceProperty::kSizeTotal, total);
+    iter->insert(DeviceProperty::kSizeFree, free);
+    iter->insert(DeviceProperty::kSizeUsed, total - free);
+}
+
 void DeviceProxyManagerPrivate::addMounts(const QString &id, const QString &mpt)
 {
     QString p = mpt.endsWith("/") ? mpt : mpt + "/";
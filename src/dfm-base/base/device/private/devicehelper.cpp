@@ -183,6 +183,41 @@ bool DeviceHelper::isMountableBlockDev(const BlockDevAutoPtr &dev, QString &why)
     return isMountableBlockDev(datas, why);
 }
 
+/*!
+ * \brief check if the block device matches all the conditions in opts
+ */
+bool DeviceHelper::isMatchedQueryOptions(const QVariantMap &infos, GlobalServerDefines::DeviceQueryOptions opts)
+{
+    using namespace GlobalServerDefines;
+
+    QString errMsg;
+    if (opts.testFlag(DeviceQueryOption::kMounted)
+        && infos.value(DeviceProperty::kMountPoint).toString().isEmpty())
+        return false;
+    if (opts.testFlag(DeviceQueryOption::kRemovable)
+        && !infos.value(DeviceProperty::kRemovable).toBool())
+        return false;
+    if (opts.testFlag(DeviceQueryOption::kMountable)
+        && !isMountableBlockDev(infos, errMsg))
+        return false;
+    if (opts.testFlag(DeviceQueryOption::kNotIgnored)
+        && infos.value(DeviceProperty::kHintIgnore).toBool())
+        return false;
+    if (opts.testFlag(DeviceQueryOption::kNotMounted)
+        && !infos.value(DeviceProperty::kMountPoint).toString().isEmpty())
+        return false;
+    if (opts.testFlag(DeviceQueryOption::kOptical)
+        && !infos.value(DeviceProperty::kOptical).toBool())
+        return false;
+    if (opts.testFlag(DeviceQueryOption::kSystem)
+        && !DeviceUtils::isSystemDisk(infos))
+        return false;
+    if (opts.testFlag(DeviceQueryOption::kLoop)
+        && !infos.value(DeviceProperty::kIsLoopDevice).toBool())
+        return false;
+    return true;
+}
+
 bool DeviceHelper::isMountableBlockDev(const QVariantMap &infos, QString &why)
 {
     using namespace GlobalServerDefines::DeviceProperty;
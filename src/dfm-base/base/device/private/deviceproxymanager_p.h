@@ -8,11 +8,16 @@
 #include "devicemanager_interface.h"
 
 #include <dfm-base/dfm_base_global.h>
+#include <dfm-base/dbusservice/global_server_defines.h>
 
 #include <QScopedPointer>
 #include <QList>
 #include <QtCore/qobjectdefs.h>
 #include <QReadWriteLock>
+#include <QMutex>
+#include <QMap>
+
+#include <atomic>
 
 using DeviceManagerInterface = OrgDeepinFilemanagerServerDeviceManagerInterface;
 class QDBusServiceWatcher;
@@ -36,10 +41,24 @@ public:
     void connectToAPI();
     void disconnCurrentConnections();
 
+    bool isDBusConnected() const;
+    void initReplica();
+    void resetReplica();
+    bool findReplica(const QString &id, bool isBlock, QVariantMap *info);
+    QStringList replicaIds(bool isBlock, GlobalServerDefines::DeviceQueryOptions opts = GlobalServerDefines::DeviceQueryOption::kNoCondition);
+    void setReplica(const QString &id, bool isBlock, const QVariantMap &info);
+
 private Q_SLOTS:
     void addMounts(const QString &id, const QString &mpt);
     void removeMounts(const QString &id);
 
+    void reloadBlockReplica(const QString &id);
+    void reloadProtocolReplica(const QString &id);
+    void removeBlockReplica(const QString &id);
+    void removeProtocolReplica(const QString &id);
+    void updateBlockReplicaProperty(const QString &id, const QString &property, const QVariant &value);
+    void updateReplicaSize(const QString &id, qint64 total, qint64 free);
+
 private:
     DeviceProxyManager *q { nullptr };
     QScopedPointer<DeviceManagerInterface> devMngDBus;
@@ -50,6 +69,15 @@ private:
     QMap<QString, QString> externalMounts;
     QMap<QString, QString> allMounts;
 
+    // the replica of the devices on the server, it's fetched once and kept current by the device signals,
+    // so the queries are answered without a DBus round trip.
+    QMutex replicaInitMutex;
+    QReadWriteLock replicaLock;
+    std::atomic_bool replicaReady { false };
+    std::atomic_int replicaChanges { 0 };
+    QMap<QString, QVariantMap> blockReplica;
+    QMap<QString, QVariantMap> protocolReplica;
+
     enum {
         kNoneConnection = -1,
         kAPIConnecting,
@@ -308,12 +308,19 @@ QString dfmbase::FileInfo::displayOf(const DisPlayInfoType type) const
                 .append(nameOf(FileNameInfoType::kSuffix));
         }
     case DisPlayInfoType::kFileDisplayPinyinName:
+    case DisPlayInfoType::kFileDisplayPinyinInitials:
+        // the full pinyin and the initials are converted together and cached for sorting and searching
         if (pinyinName.isEmpty()) {
             const QString &displayName = this->displayOf(DisplayInfoType::kFileDisplayName);
-            const_cast<FileInfo *>(this)->pinyinName = Pinyin::Chinese2Pinyin(displayName);
+            FileInfo *self = const_cast<FileInfo *>(this);
+            QString full;
+            QString initials;
+            Pinyin::Chinese2PinyinKeys(displayName, &full, &initials);
+            self->pinyinInitials = initials;
+            self->pinyinName = full;
         }
 
-        return pinyinName;
+        return type == DisPlayInfoType::kFileDisplayPinyinName ? pinyinName : pinyinInitials;
     default:
         return QString();
     }
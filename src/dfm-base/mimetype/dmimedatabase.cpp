@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dmimedatabase.h"
+#include "mimetypecache.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/schemefactory.h>
@@ -22,6 +23,39 @@ static QStringList officeSuffixList {
 };
 static const QStringList blackList { "/sys/kernel/security/apparmor/revision", "/sys/kernel/security/apparmor/policy/revision", "/sys/power/wakeup_count", "/proc/kmsg" };
 
+/*!
+ * \brief look up the detected mime type of a regular file in the process-wide cache,
+ * detect and cache it if the file is new or changed.
+ * The files matched by extension are detected directly, and the files on low speed
+ * devices are detected by extension on a miss, and never cached.
+ */
+template<typename Detector>
+static QMimeType cachedMimeType(const QMimeDatabase &db, const QString &filePath, QMimeDatabase::MatchMode mode, Detector detect)
+{
+    if (mode == QMimeDatabase::MatchExtension)
+        return detect();
+
+    MimeTypeCacheKey key;
+    if (!MimeTypeCache::makeKey(filePath, mode, &key))
+        return detect();
+
+    QString name;
+    if (MimeTypeCache::instance()->find(filePath, key, &name)) {
+        const QMimeType &type = db.mimeTypeForName(name);
+        if (type.isValid())
+            return type;
+    }
+
+    // the device is checked on a miss only, it is much slower than the lookup.
+    if (DeviceUtils::isLowSpeedDevice(QUrl::fromLocalFile(QFileInfo(filePath).path())))
+        return detect();
+
+    const QMimeType &result = detect();
+    if (result.isValid())
+        MimeTypeCache::instance()->insert(filePath, key, result.name());
+    return result;
+}
+
 DMimeDatabase::DMimeDatabase()
 {
 }
@@ -34,12 +68,19 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QUrl &url, QMimeDatabase::MatchMo
 
 QMimeType DMimeDatabase::mimeTypeForFile(const FileInfoPointer &fileInfo, QMimeDatabase::MatchMode mode) const
 {
-    // 如果是低速设备，则先从扩展名去获取mime信息；对于本地文件，保持默认的获取策略
-    QMimeType result;
-
     if (!fileInfo)
         return QMimeType();
 
+    return cachedMimeType(*this, fileInfo->pathOf(PathInfoType::kFilePath), mode, [this, &fileInfo, mode] {
+        return detectMimeType(fileInfo, mode);
+    });
+}
+
+QMimeType DMimeDatabase::detectMimeType(const FileInfoPointer &fileInfo, QMimeDatabase::MatchMode mode) const
+{
+    // 如果是低速设备，则先从扩展名去获取mime信息；对于本地文件，保持默认的获取策略
+    QMimeType result;
+
     QString path = fileInfo->pathOf(PathInfoType::kPath);
     bool isMatchExtension = mode == QMimeDatabase::MatchExtension;
     if (!isMatchExtension) {
@@ -99,7 +140,6 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QString &fileName, QMimeDatabase:
 QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabase::MatchMode mode, const QString &inod, const bool isGvfs) const
 {
     Q_UNUSED(isGvfs)
-    // 如果是低速设备，则先从扩展名去获取mime信息；对于本地文件，保持默认的获取策略
     bool canCache = !inod.isEmpty();
     if (!inod.isEmpty() && inodMimetypeCache.contains(inod)) {
         return inodMimetypeCache.value(inod);
@@ -107,6 +147,19 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     if (fileInfo.isDir()) {
         return QMimeDatabase::mimeTypeForFile(QFileInfo("/home"), mode);
     }
+
+    const QMimeType &result = cachedMimeType(*this, fileInfo.absoluteFilePath(), mode, [this, &fileInfo, mode] {
+        return detectMimeType(fileInfo, mode);
+    });
+    if (canCache) {
+        const_cast<DMimeDatabase *>(this)->inodMimetypeCache.insert(inod, result);
+    }
+    return result;
+}
+
+QMimeType DMimeDatabase::detectMimeType(const QFileInfo &fileInfo, QMimeDatabase::MatchMode mode) const
+{
+    // 如果是低速设备，则先从扩展名去获取mime信息；对于本地文件，保持默认的获取策略
     QMimeType result;
     QString path = fileInfo.path();
 
@@ -151,15 +204,9 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     if (officeSuffixList.contains(fileInfo.suffix()) && wrongMimeTypeNames.contains(result.name())) {
         QList<QMimeType> results = QMimeDatabase::mimeTypesForFileName(fileInfo.fileName());
         if (!results.isEmpty()) {
-            if (canCache) {
-                const_cast<DMimeDatabase *>(this)->inodMimetypeCache.insert(inod, results.first());
-            }
             return results.first();
         }
     }
-    if (canCache) {
-        const_cast<DMimeDatabase *>(this)->inodMimetypeCache.insert(inod, result);
-    }
     return result;
 }
 
@@ -26,6 +26,8 @@ public:
 
 private:
     QMimeType mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode, const QString &inod, const bool isGvfs = false) const;
+    QMimeType detectMimeType(const FileInfoPointer &fileInfo, MatchMode mode) const;
+    QMimeType detectMimeType(const QFileInfo &fileInfo, MatchMode mode) const;
 
 private:
     QHash<QString, QMimeType> inodMimetypeCache;
@@ -0,0 +1,271 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mimeappsindex.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDirIterator>
+#include <QDataStream>
+#include <QDateTime>
+#include <QLocale>
+#include <QSet>
+#include <QDebug>
+
+#include <algorithm>
+
+namespace dfmbase {
+
+static constexpr quint32 kIndexMagic { 0x44464d41 };   // "DFMA"
+static constexpr quint32 kIndexVersion { 1 };
+
+static QDataStream &operator<<(QDataStream &out, const MimeAppsIndexEntry &entry)
+{
+    out << entry.modifyTime << entry.createTime << entry.desktop;
+    return out;
+}
+
+static QDataStream &operator>>(QDataStream &in, MimeAppsIndexEntry &entry)
+{
+    in >> entry.modifyTime >> entry.createTime >> entry.desktop;
+    return in;
+}
+
+MimeAppsIndex::MimeAppsIndex(const QString &indexFile)
+    : indexFile(indexFile),
+      localeName(QLocale::system().name())
+{
+}
+
+/*!
+ * \brief load the index file written by any process, skip it if it is
+ * not changed since the last load.
+ * \return true if new data is loaded
+ */
+bool MimeAppsIndex::load()
+{
+    QFile file(indexFile);
+    if (!file.exists())
+        return false;
+
+    const qint64 stamp = QFileInfo(file).lastModified().toMSecsSinceEpoch();
+    if (stamp == loadedStamp)
+        return false;
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(logDFMBase) << "failed to open mime apps index:" << file.errorString();
+        return false;
+    }
+
+    uchar *mem = file.map(0, file.size());
+    if (!mem) {
+        qCWarning(logDFMBase) << "failed to map mime apps index:" << file.errorString();
+        return false;
+    }
+
+    const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char *>(mem), static_cast<int>(file.size()));
+    QDataStream in(raw);
+    in.setVersion(QDataStream::Qt_5_11);
+
+    quint32 magic { 0 };
+    quint32 version { 0 };
+    QString locale;
+    in >> magic >> version >> locale;
+
+    bool loaded = false;
+    if (magic == kIndexMagic && version == kIndexVersion && locale == localeName) {
+        QHash<QString, MimeAppsIndexEntry> entries;
+        QHash<QString, QStringList> mimeApps;
+        QMap<QString, QStringList> ddeMimeTypes;
+        in >> entries >> mimeApps >> ddeMimeTypes;
+        if (in.status() == QDataStream::Ok) {
+            indexEntries = std::move(entries);
+            mimeAppsIndex = std::move(mimeApps);
+            lastDDEMimeTypes = std::move(ddeMimeTypes);
+            loaded = true;
+        } else {
+            qCWarning(logDFMBase) << "mime apps index is corrupted:" << indexFile;
+        }
+    }
+
+    file.unmap(mem);
+    file.close();
+    loadedStamp = stamp;
+
+    return loaded;
+}
+
+/*!
+ * \brief write the index to a temporary file and rename it over the old one,
+ * so that the readers mapping the old file are never affected.
+ * The written file is what is loaded, the next load() skips it.
+ */
+bool MimeAppsIndex::save()
+{
+    QSaveFile file(indexFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDFMBase) << "failed to write mime apps index:" << file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_11);
+    out << kIndexMagic << kIndexVersion << localeName
+        << indexEntries << mimeAppsIndex << lastDDEMimeTypes;
+
+    if (!file.commit()) {
+        qCWarning(logDFMBase) << "failed to commit mime apps index:" << file.errorString();
+        return false;
+    }
+
+    loadedStamp = QFileInfo(indexFile).lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+/*!
+ * \brief bring the index up to date with the desktop files on disk.
+ * \param folders the applications folders
+ * \param ddeMimeTypes the extra mime types from dde-mimetype.list
+ * \param changedFiles the files reported by the watchers, scan all folders if it is empty
+ * \return true if the index is changed
+ */
+bool MimeAppsIndex::refresh(const QStringList &folders, const QMap<QString, QStringList> &ddeMimeTypes,
+                            const QStringList &changedFiles)
+{
+    bool changed = false;
+    // a changed folder may contain any number of new desktop files
+    bool needScan = changedFiles.isEmpty() || indexEntries.isEmpty();
+    if (!needScan) {
+        for (const QString &path : changedFiles) {
+            if (!path.endsWith(".desktop")) {
+                needScan = true;
+                break;
+            }
+            changed |= refreshFile(path);
+        }
+    }
+
+    if (needScan)
+        changed |= refreshAll(folders);
+
+    if (changed || ddeMimeTypes != lastDDEMimeTypes) {
+        rebuildMimeApps(ddeMimeTypes);
+        changed = true;
+    }
+
+    return changed;
+}
+
+const QHash<QString, MimeAppsIndexEntry> &MimeAppsIndex::entries() const
+{
+    return indexEntries;
+}
+
+const QHash<QString, QStringList> &MimeAppsIndex::mimeApps() const
+{
+    return mimeAppsIndex;
+}
+
+QStringList MimeAppsIndex::appsForMimeType(const QString &mimeType) const
+{
+    return mimeAppsIndex.value(mimeType);
+}
+
+bool MimeAppsIndex::refreshAll(const QStringList &folders)
+{
+    bool changed = false;
+    QSet<QString> existed;
+    existed.reserve(indexEntries.size());
+
+    for (const QString &folder : folders) {
+        QDirIterator it(folder, QStringList("*.desktop"), QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            const QString &filePath = it.filePath();
+            const QFileInfo &info = it.fileInfo();
+            const qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+            existed.insert(filePath);
+
+            auto iter = indexEntries.find(filePath);
+            if (iter != indexEntries.end() && iter->modifyTime == mtime)
+                continue;
+
+            MimeAppsIndexEntry entry;
+            entry.modifyTime = mtime;
+            entry.createTime = info.created().toMSecsSinceEpoch();
+            entry.desktop = DesktopFile(filePath);
+            indexEntries.insert(filePath, entry);
+            changed = true;
+        }
+    }
+
+    for (auto iter = indexEntries.begin(); iter != indexEntries.end();) {
+        if (!existed.contains(iter.key())) {
+            iter = indexEntries.erase(iter);
+            changed = true;
+        } else {
+            ++iter;
+        }
+    }
+
+    return changed;
+}
+
+bool MimeAppsIndex::refreshFile(const QString &filePath)
+{
+    const QFileInfo info(filePath);
+    if (!info.exists())
+        return indexEntries.remove(filePath) > 0;
+
+    const qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+    auto iter = indexEntries.find(filePath);
+    if (iter != indexEntries.end() && iter->modifyTime == mtime)
+        return false;
+
+    MimeAppsIndexEntry entry;
+    entry.modifyTime = mtime;
+    entry.createTime = info.created().toMSecsSinceEpoch();
+    entry.desktop = DesktopFile(filePath);
+    indexEntries.insert(filePath, entry);
+    return true;
+}
+
+void MimeAppsIndex::rebuildMimeApps(const QMap<QString, QStringList> &ddeMimeTypes)
+{
+    QHash<QString, QList<QPair<qint64, QString>>> mimeAppsSet;
+    for (auto iter = indexEntries.cbegin(); iter != indexEntries.cend(); ++iter) {
+        const DesktopFile &desktop = iter->desktop;
+        if (desktop.isNoShow())
+            continue;
+
+        QStringList mimeTypes = desktop.desktopMimeType();
+        const QString &fileName = QFileInfo(iter.key()).fileName();
+        if (ddeMimeTypes.contains(fileName))
+            mimeTypes.append(ddeMimeTypes.value(fileName));
+        mimeTypes.removeDuplicates();
+
+        for (const QString &mimeType : mimeTypes) {
+            if (!mimeType.isEmpty())
+                mimeAppsSet[mimeType].append({ iter->createTime, iter.key() });
+        }
+    }
+
+    mimeAppsIndex.clear();
+    mimeAppsIndex.reserve(mimeAppsSet.size());
+    for (auto iter = mimeAppsSet.begin(); iter != mimeAppsSet.end(); ++iter) {
+        auto &apps = iter.value();
+        std::sort(apps.begin(), apps.end());
+
+        QStringList orderApps;
+        orderApps.reserve(apps.size());
+        for (const auto &app : apps)
+            orderApps.append(app.second);
+        mimeAppsIndex.insert(iter.key(), orderApps);
+    }
+
+    lastDDEMimeTypes = ddeMimeTypes;
+}
+
+}
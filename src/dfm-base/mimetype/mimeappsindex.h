@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MIMEAPPSINDEX_H
+#define MIMEAPPSINDEX_H
+
+#include <dfm-base/dfm_base_global.h>
+#include <dfm-base/utils/desktopfile.h>
+
+#include <QHash>
+#include <QMap>
+#include <QStringList>
+
+namespace dfmbase {
+
+struct MimeAppsIndexEntry
+{
+    qint64 modifyTime { 0 };
+    qint64 createTime { 0 };
+    DesktopFile desktop;
+};
+
+/*!
+ * \brief The MimeAppsIndex class is a persistent index of the desktop files in the
+ * applications folders. Each entry is keyed by its file path and carries the mtime
+ * it was parsed at, so only added or modified desktop files are parsed again.
+ *
+ * The index file is mapped read-only when loading and replaced atomically when saving,
+ * so every process may share the result of a single parse.
+ */
+class MimeAppsIndex
+{
+public:
+    explicit MimeAppsIndex(const QString &indexFile);
+
+    bool load();
+    bool save();
+    bool refresh(const QStringList &folders, const QMap<QString, QStringList> &ddeMimeTypes,
+                 const QStringList &changedFiles = {});
+
+    const QHash<QString, MimeAppsIndexEntry> &entries() const;
+    const QHash<QString, QStringList> &mimeApps() const;
+    QStringList appsForMimeType(const QString &mimeType) const;
+
+private:
+    bool refreshAll(const QStringList &folders);
+    bool refreshFile(const QString &filePath);
+    void rebuildMimeApps(const QMap<QString, QStringList> &ddeMimeTypes);
+
+private:
+    QString indexFile;
+    QString localeName;
+    qint64 loadedStamp { 0 };
+    QHash<QString, MimeAppsIndexEntry> indexEntries;
+    QHash<QString, QStringList> mimeAppsIndex;
+    QMap<QString, QStringList> lastDDEMimeTypes;
+};
+
+}
+
+#endif   // MIMEAPPSINDEX_H
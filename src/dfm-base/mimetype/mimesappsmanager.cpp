@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "mimesappsmanager.h"
+#include "mimeappsindex.h"
 
 #include <dfm-base/mimetype/dmimedatabase.h>
 #include <dfm-base/mimetype/mimetypedisplaymanager.h>
@@ -22,6 +23,7 @@
 #include <QDebug>
 #include <QUrl>
 #include <QStandardPaths>
+#include <QMutex>
 
 #undef signals
 extern "C" {
@@ -68,8 +70,12 @@ void MimeAppsWorker::startWatch()
         AbstractFileWatcherPointer watcher { WatcherFactory::create<AbstractFileWatcher>(QUrl::fromLocalFile(path)) };
         watcherGroup.append(watcher);
         if (watcher) {
-            connect(watcher.data(), &AbstractFileWatcher::fileAttributeChanged, this, [this]() {
-                updateCacheTimer->start();
+            connect(watcher.data(), &AbstractFileWatcher::fileAttributeChanged, this, &MimeAppsWorker::onDesktopFileChanged);
+            connect(watcher.data(), &AbstractFileWatcher::subfileCreated, this, &MimeAppsWorker::onDesktopFileChanged);
+            connect(watcher.data(), &AbstractFileWatcher::fileDeleted, this, &MimeAppsWorker::onDesktopFileChanged);
+            connect(watcher.data(), &AbstractFileWatcher::fileRename, this, [this](const QUrl &oldUrl, const QUrl &newUrl) {
+                onDesktopFileChanged(oldUrl);
+                onDesktopFileChanged(newUrl);
             });
             watcher->startWatcher();
         }
@@ -78,7 +84,17 @@ void MimeAppsWorker::startWatch()
 
 void MimeAppsWorker::updateCache()
 {
-    MimesAppsManager::initMimeTypeApps();
+    const QStringList files = changedFiles;
+    changedFiles.clear();
+    MimesAppsManager::updateMimeTypeApps(files);
+}
+
+void MimeAppsWorker::onDesktopFileChanged(const QUrl &url)
+{
+    const QString &path = url.toLocalFile();
+    if (!path.isEmpty() && !changedFiles.contains(path))
+        changedFiles.append(path);
+    updateCacheTimer->start();
 }
 
 void MimeAppsWorker::writeData(const QString &path, const QByteArray &content)
@@ -459,6 +475,11 @@ QString MimesAppsManager::getDDEMimeTypeFile()
     return QString("%1/%2/%3").arg(getMimeInfoCacheFileRootPath(), "deepin", "dde-mimetype.list");
 }
 
+QString MimesAppsManager::getMimeAppsIndexFile()
+{
+    return QString("%1/%2").arg(StandardPaths::location(StandardPaths::kCachePath), "MimeApps.index");
+}
+
 QMap<QString, DesktopFile> MimesAppsManager::getDesktopObjs()
 {
     QMap<QString, DesktopFile> desktopObjs;
@@ -469,67 +490,56 @@ QMap<QString, DesktopFile> MimesAppsManager::getDesktopObjs()
 }
 
 void MimesAppsManager::initMimeTypeApps()
+{
+    updateMimeTypeApps({});
+}
+
+/*!
+ * \brief update the cached applications through the persistent index, only the
+ * desktop files changed since the last index update are parsed.
+ * \param changedFiles the changed files, all applications folders are checked if it is empty
+ */
+void MimesAppsManager::updateMimeTypeApps(const QStringList &changedFiles)
 {
     qCDebug(logDFMBase) << "getMimeTypeApps in" << QThread::currentThread() << qApp->thread();
-    DesktopFiles.clear();
-    DesktopObjs.clear();
-    DDE_MimeTypes.clear();
+    static QMutex mutex;
+    static MimeAppsIndex index(getMimeAppsIndexFile());
+    static bool inited = false;
+    QMutexLocker locker(&mutex);
+
+    // the index may be updated by another process
+    const bool loaded = index.load();
 
-    QMap<QString, QSet<QString>> mimeAppsSet;
+    DDE_MimeTypes.clear();
     loadDDEMimeTypes();
-    for (const QString &desktopFolder : getApplicationsFolders()) {
-        QDirIterator it(desktopFolder, QStringList("*.desktop"), QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
-        while (it.hasNext()) {
-            it.next();
-            const QString &filePath = it.filePath();
-            DesktopFile desktopFile(filePath);
-            if (desktopFile.isNoShow())
-                continue;
+    const bool changed = index.refresh(getApplicationsFolders(), DDE_MimeTypes, changedFiles);
+    if (changed)
+        index.save();
 
-            DesktopFiles.append(filePath);
-            DesktopObjs.insert(filePath, desktopFile);
-            QStringList mimeTypes = desktopFile.desktopMimeType();
-            QString fileName = QFileInfo(filePath).fileName();
-            if (DDE_MimeTypes.contains(fileName)) {
-                mimeTypes.append(DDE_MimeTypes.value(fileName));
-            }
+    if (inited && !loaded && !changed)
+        return;
+    inited = true;
 
-            for (const QString &mimeType : mimeTypes) {
-                if (!mimeType.isEmpty()) {
-                    QSet<QString> apps;
-                    if (mimeAppsSet.contains(mimeType)) {
-                        apps = mimeAppsSet.value(mimeType);
-                        apps.insert(filePath);
-                    } else {
-                        apps.insert(filePath);
-                    }
-                    mimeAppsSet.insert(mimeType, apps);
-                }
-            }
-        }
+    DesktopFiles.clear();
+    DesktopObjs.clear();
+    const auto &entries = index.entries();
+    for (auto iter = entries.cbegin(); iter != entries.cend(); ++iter) {
+        if (iter->desktop.isNoShow())
+            continue;
+        DesktopFiles.append(iter.key());
+        DesktopObjs.insert(iter.key(), iter->desktop);
     }
 
-    for (const QString &key : mimeAppsSet.keys()) {
-        QSet<QString> apps = mimeAppsSet.value(key);
-        QStringList orderApps;
-        if (apps.count() > 1) {
-            QFileInfoList fileInfos;
-            for (const QString &app : apps) {
-                QFileInfo info(app);
-                fileInfos.append(info);
-            }
+    MimeApps.clear();
+    const auto &mimeApps = index.mimeApps();
+    for (auto iter = mimeApps.cbegin(); iter != mimeApps.cend(); ++iter)
+        MimeApps.insert(iter.key(), iter.value());
 
-            std::sort(fileInfos.begin(), fileInfos.end(), MimesAppsManager::lessByDateTime);
-
-            for (const QFileInfo &info : fileInfos) {
-                orderApps.append(info.absoluteFilePath());
-            }
-        } else {
-            orderApps.append(apps.toList());
-        }
-        MimeApps.insert(key, orderApps);
-    }
+    loadMimeInfoCacheApps();
+}
 
+void MimesAppsManager::loadMimeInfoCacheApps()
+{
     //check mime apps from cache
     QFile f(getMimeInfoCacheFilePath());
     if (!f.open(QIODevice::ReadOnly)) {
@@ -569,37 +579,44 @@ void MimesAppsManager::initMimeTypeApps()
     }
     f.close();
 
+    // desktop files in the index are already parsed
+    auto desktopFile = [](const QString &path) {
+        auto iter = DesktopObjs.constFind(path);
+        return iter != DesktopObjs.cend() ? iter.value() : DesktopFile(path);
+    };
+
+    AudioMimeApps.clear();
+    ImageMimeApps.clear();
+    TextMimeApps.clear();
+    VideoMimeApps.clear();
+
     const QString &mimeInfoCacheRootPath = getMimeInfoCacheFileRootPath();
     for (const QString &desktop : audioDesktopList) {
         const QString path = QString("%1/%2").arg(mimeInfoCacheRootPath, desktop);
         if (!QFile::exists(path))
             continue;
-        DesktopFile df(path);
-        AudioMimeApps.insert(path, df);
+        AudioMimeApps.insert(path, desktopFile(path));
     }
 
     for (const QString &desktop : imageDeksopList) {
         const QString path = QString("%1/%2").arg(mimeInfoCacheRootPath, desktop);
         if (!QFile::exists(path))
             continue;
-        DesktopFile df(path);
-        ImageMimeApps.insert(path, df);
+        ImageMimeApps.insert(path, desktopFile(path));
     }
 
     for (const QString &desktop : textDekstopList) {
         const QString path = QString("%1/%2").arg(mimeInfoCacheRootPath, desktop);
         if (!QFile::exists(path))
             continue;
-        DesktopFile df(path);
-        TextMimeApps.insert(path, df);
+        TextMimeApps.insert(path, desktopFile(path));
     }
 
     for (const QString &desktop : videoDesktopList) {
         const QString path = QString("%1/%2").arg(mimeInfoCacheRootPath, desktop);
         if (!QFile::exists(path))
             continue;
-        DesktopFile df(path);
-        VideoMimeApps.insert(path, df);
+        VideoMimeApps.insert(path, desktopFile(path));
     }
 
     return;
@@ -37,12 +37,14 @@ public:
 public Q_SLOTS:
     void startWatch();
     void updateCache();
+    void onDesktopFileChanged(const QUrl &url);
     void writeData(const QString &path, const QByteArray &content);
     QByteArray readData(const QString &path);
 
 private:
     QTimer *updateCacheTimer = nullptr;
     QList<AbstractFileWatcherPointer> watcherGroup;
+    QStringList changedFiles;
 };
 
 class MimesAppsManager : public QObject
@@ -86,8 +88,10 @@ public:
     static QString getDesktopFilesCacheFile();
     static QString getDesktopIconsCacheFile();
     static QString getDDEMimeTypeFile();
+    static QString getMimeAppsIndexFile();
     static QMap<QString, DesktopFile> getDesktopObjs();
     static void initMimeTypeApps();
+    static void updateMimeTypeApps(const QStringList &changedFiles);
     static void loadDDEMimeTypes();
     static bool lessByDateTime(const QFileInfo &f1, const QFileInfo &f2);
     static bool removeOneDupFromList(QStringList &list, const QString desktopFilePath);
@@ -97,6 +101,7 @@ Q_SIGNALS:
 
 private:
     explicit MimesAppsManager(QObject *parent = nullptr);
+    static void loadMimeInfoCacheApps();
     MimeAppsWorker *mimeAppsWorker = nullptr;
     QThread mimeAppsThread;
 };
@@ -0,0 +1,280 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mimetypecache.h"
+
+#include <dfm-base/base/standardpaths.h>
+
+#include <QDir>
+#include <QFile>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QDebug>
+
+#include <sys/stat.h>
+
+using namespace dfmbase;
+
+static constexpr int kMaxMemoryEntries { 200000 };
+static constexpr int kMaxDirStates { 1024 };
+// a directory is persisted once this many files in it are detected
+static constexpr int kPersistThreshold { 512 };
+static constexpr int kPersistBatch { 128 };
+static constexpr qint64 kMaxDiskCacheFileSize { 8 * 1024 * 1024 };
+static constexpr quint32 kDiskCacheMagic { 0x44464d4d };   // "DFMM"
+static constexpr quint32 kDiskCacheVersion { 1 };
+
+uint dfmbase::qHash(const MimeTypeCacheKey &key, uint seed)
+{
+    auto combine = [&seed](uint h) {
+        seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+    combine(::qHash(key.device));
+    combine(::qHash(key.inode));
+    combine(::qHash(key.modifyTime));
+    combine(::qHash(key.size));
+    combine(key.nameHash);
+    combine(::qHash(key.mode));
+    return seed;
+}
+
+static QDataStream &operator<<(QDataStream &out, const MimeTypeCacheKey &key)
+{
+    out << key.device << key.inode << key.modifyTime << key.size << key.nameHash << static_cast<qint8>(key.mode);
+    return out;
+}
+
+static QDataStream &operator>>(QDataStream &in, MimeTypeCacheKey &key)
+{
+    qint8 mode { 0 };
+    in >> key.device >> key.inode >> key.modifyTime >> key.size >> key.nameHash >> mode;
+    key.mode = mode;
+    return in;
+}
+
+static QString dirPathOf(const QString &filePath)
+{
+    const int index = filePath.lastIndexOf('/');
+    return index > 0 ? filePath.left(index) : QStringLiteral("/");
+}
+
+MimeTypeCache *MimeTypeCache::instance()
+{
+    static MimeTypeCache ins;
+    return &ins;
+}
+
+MimeTypeCache::MimeTypeCache()
+    : entries(kMaxMemoryEntries),
+      diskCacheDir(StandardPaths::location(StandardPaths::kCachePath) + "/mimetypes")
+{
+}
+
+MimeTypeCache::~MimeTypeCache()
+{
+    flush();
+}
+
+/*!
+ * \brief make the cache key of a regular file.
+ * \return false if the file can not be cached, such as dirs, devices and fifos
+ */
+bool MimeTypeCache::makeKey(const QString &filePath, QMimeDatabase::MatchMode mode, MimeTypeCacheKey *key)
+{
+    if (filePath.isEmpty() || !key)
+        return false;
+
+    struct stat st;
+    if (::stat(filePath.toLocal8Bit().constData(), &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+
+    key->device = static_cast<quint64>(st.st_dev);
+    key->inode = static_cast<quint64>(st.st_ino);
+    key->modifyTime = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    key->size = static_cast<qint64>(st.st_size);
+    // the mime type also depends on the file name, hard links and renamed files must not share it.
+    key->nameHash = ::qHash(filePath.midRef(filePath.lastIndexOf('/') + 1));
+    key->mode = static_cast<int>(mode);
+    return true;
+}
+
+bool MimeTypeCache::find(const QString &filePath, const MimeTypeCacheKey &key, QString *mimeTypeName)
+{
+    const QString &dirPath = dirPathOf(filePath);
+    QList<QPair<QString, QList<Record>>> evicted;
+    bool load = false;
+    {
+        QMutexLocker lk(&mutex);
+        if (QString *name = entries.object(key)) {
+            hits.fetchAndAddRelaxed(1);
+            if (mimeTypeName)
+                *mimeTypeName = *name;
+            return true;
+        }
+
+        auto iter = dirStates.find(dirPath);
+        if (iter == dirStates.end()) {
+            if (dirStates.size() >= kMaxDirStates) {
+                for (auto it = dirStates.begin(); it != dirStates.end(); ++it) {
+                    QList<Record> records;
+                    if (takePending(&it.value(), &records))
+                        evicted.append({ it.key(), records });
+                }
+                dirStates.clear();
+            }
+            iter = dirStates.insert(dirPath, DirState());
+        }
+
+        load = !iter->loaded;
+        iter->loaded = true;
+    }
+
+    for (const auto &dir : evicted)
+        saveDir(dir.first, dir.second);
+
+    if (load) {
+        const QList<Record> &records = loadDir(dirPath);
+        QMutexLocker lk(&mutex);
+        for (const auto &record : records)
+            entries.insert(record.first, new QString(record.second));
+        diskLoaded.fetchAndAddRelaxed(static_cast<quint64>(records.size()));
+
+        if (QString *name = entries.object(key)) {
+            hits.fetchAndAddRelaxed(1);
+            if (mimeTypeName)
+                *mimeTypeName = *name;
+            return true;
+        }
+    }
+
+    misses.fetchAndAddRelaxed(1);
+    return false;
+}
+
+void MimeTypeCache::insert(const QString &filePath, const MimeTypeCacheKey &key, const QString &mimeTypeName)
+{
+    if (mimeTypeName.isEmpty())
+        return;
+
+    const QString &dirPath = dirPathOf(filePath);
+    QList<Record> records;
+    {
+        QMutexLocker lk(&mutex);
+        entries.insert(key, new QString(mimeTypeName));
+
+        DirState &state = dirStates[dirPath];
+        ++state.inserted;
+        state.pending.append({ key, mimeTypeName });
+        if (state.pending.size() >= kPersistBatch)
+            takePending(&state, &records);
+    }
+
+    if (!records.isEmpty())
+        saveDir(dirPath, records);
+}
+
+void MimeTypeCache::clear()
+{
+    QMutexLocker lk(&mutex);
+    entries.clear();
+    dirStates.clear();
+}
+
+void MimeTypeCache::flush()
+{
+    QList<QPair<QString, QList<Record>>> dirs;
+    {
+        QMutexLocker lk(&mutex);
+        for (auto iter = dirStates.begin(); iter != dirStates.end(); ++iter) {
+            QList<Record> records;
+            if (takePending(&iter.value(), &records))
+                dirs.append({ iter.key(), records });
+        }
+    }
+
+    for (const auto &dir : dirs)
+        saveDir(dir.first, dir.second);
+}
+
+MimeTypeCache::Statistics MimeTypeCache::statistics() const
+{
+    Statistics stat;
+    stat.hits = hits.loadAcquire();
+    stat.misses = misses.loadAcquire();
+    stat.diskLoaded = diskLoaded.loadAcquire();
+    stat.diskSaved = diskSaved.loadAcquire();
+    return stat;
+}
+
+QString MimeTypeCache::diskCacheFile(const QString &dirPath) const
+{
+    const QByteArray &hash = QCryptographicHash::hash(dirPath.toUtf8(), QCryptographicHash::Md5).toHex();
+    return diskCacheDir + "/" + QString::fromLatin1(hash);
+}
+
+/*!
+ * \brief take the records to persist of a directory with enough detected files.
+ */
+bool MimeTypeCache::takePending(DirState *state, QList<Record> *records)
+{
+    if (state->inserted < kPersistThreshold || state->pending.isEmpty())
+        return false;
+
+    records->swap(state->pending);
+    return true;
+}
+
+QList<MimeTypeCache::Record> MimeTypeCache::loadDir(const QString &dirPath)
+{
+    QList<Record> records;
+    QMutexLocker lk(&diskMutex);
+    QFile file(diskCacheFile(dirPath));
+    if (!file.open(QIODevice::ReadOnly))
+        return records;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_11);
+    quint32 magic { 0 };
+    quint32 version { 0 };
+    QString path;
+    in >> magic >> version >> path;
+    if (magic != kDiskCacheMagic || version != kDiskCacheVersion || path != dirPath)
+        return records;
+
+    // records are appended, the later one is newer
+    while (!in.atEnd() && in.status() == QDataStream::Ok) {
+        MimeTypeCacheKey key;
+        QString name;
+        in >> key >> name;
+        if (in.status() != QDataStream::Ok || name.isEmpty())
+            break;
+        records.append({ key, name });
+    }
+    return records;
+}
+
+void MimeTypeCache::saveDir(const QString &dirPath, const QList<Record> &records)
+{
+    QMutexLocker lk(&diskMutex);
+    if (!QDir().mkpath(diskCacheDir))
+        return;
+
+    QFile file(diskCacheFile(dirPath));
+    // stale records are never matched again, start over once the file grows too large.
+    const bool restart = !file.exists() || file.size() > kMaxDiskCacheFileSize;
+    if (!file.open(restart ? QIODevice::WriteOnly | QIODevice::Truncate : QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(logDFMBase) << "failed to write mime type cache:" << file.errorString();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_11);
+    if (restart)
+        out << kDiskCacheMagic << kDiskCacheVersion << dirPath;
+
+    for (const auto &record : records)
+        out << record.first << record.second;
+
+    diskSaved.fetchAndAddRelaxed(static_cast<quint64>(records.size()));
+}
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MIMETYPECACHE_H
+#define MIMETYPECACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QMimeDatabase>
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInteger>
+
+struct stat;
+
+namespace dfmbase {
+
+struct MimeTypeCacheKey
+{
+    quint64 device { 0 };
+    quint64 inode { 0 };
+    qint64 modifyTime { 0 };
+    qint64 size { 0 };
+    uint nameHash { 0 };
+    int mode { 0 };
+
+    bool operator==(const MimeTypeCacheKey &other) const
+    {
+        return device == other.device && inode == other.inode && modifyTime == other.modifyTime
+                && size == other.size && nameHash == other.nameHash && mode == other.mode;
+    }
+};
+
+uint qHash(const MimeTypeCacheKey &key, uint seed = 0);
+
+/*!
+ * \brief The MimeTypeCache class is a process-wide cache of detected mime types.
+ * The results are keyed by device, inode, mtime, size and file name, so a file
+ * that is not changed is never sniffed twice.
+ *
+ * Directories with many detected files are also persisted under the cache dir,
+ * and loaded again on the next visit.
+ */
+class MimeTypeCache
+{
+    Q_DISABLE_COPY(MimeTypeCache)
+
+public:
+    struct Statistics
+    {
+        quint64 hits { 0 };
+        quint64 misses { 0 };
+        quint64 diskLoaded { 0 };
+        quint64 diskSaved { 0 };
+    };
+
+    static MimeTypeCache *instance();
+    ~MimeTypeCache();
+
+    static bool makeKey(const QString &filePath, QMimeDatabase::MatchMode mode, MimeTypeCacheKey *key);
+
+    bool find(const QString &filePath, const MimeTypeCacheKey &key, QString *mimeTypeName);
+    void insert(const QString &filePath, const MimeTypeCacheKey &key, const QString &mimeTypeName);
+    void clear();
+    void flush();
+
+    Statistics statistics() const;
+
+private:
+    using Record = QPair<MimeTypeCacheKey, QString>;
+    struct DirState
+    {
+        bool loaded { false };
+        int inserted { 0 };
+        QList<Record> pending;
+    };
+
+    MimeTypeCache();
+    QString diskCacheFile(const QString &dirPath) const;
+    static bool takePending(DirState *state, QList<Record> *records);
+    QList<Record> loadDir(const QString &dirPath);
+    void saveDir(const QString &dirPath, const QList<Record> &records);
+
+private:
+    // the disk cache files are read and written out of the lock of the entries
+    QMutex mutex;
+    QMutex diskMutex;
+    QCache<MimeTypeCacheKey, QString> entries;
+    QHash<QString, DirState> dirStates;
+    QString diskCacheDir;
+
+    QAtomicInteger<quint64> hits { 0 };
+    QAtomicInteger<quint64> misses { 0 };
+    QAtomicInteger<quint64> diskLoaded { 0 };
+    QAtomicInteger<quint64> diskSaved { 0 };
+};
+
+}
+
+#endif   // MIMETYPECACHE_H
@@ -5,60 +5,150 @@
 #include "chinese2pinyin.h"
 
 #include <QHash>
-#include <QTextStream>
+#include <QVector>
 #include <QFile>
 
-namespace Pinyin {
+#include <mutex>
 
-static QHash<uint, QString> dict = {};
+namespace Pinyin {
 
 const char kDictFile[] = ":/misc/pinyin.dict";
 
-void InitDict() {
-    if (!dict.isEmpty()) {
-        return;
+// the dict covers the CJK ideographs from Extension A to the compatibility ideographs
+static constexpr ushort kFirstCodePoint { 0x3400 };
+static constexpr ushort kLastCodePoint { 0xfa2d };
+
+/*!
+ * \brief The Table struct maps a code point to the id of its syllable.
+ * The ~1300 syllables are interned into a single latin1 pool, so a lookup is
+ * an array index and a conversion never allocates per character.
+ */
+struct Table
+{
+    struct Syllable
+    {
+        int offset { 0 };
+        quint8 length { 0 };   // with the tone
+        quint8 toneless { 0 };   // without the tone
+    };
+
+    QVector<quint16> ids;   // 0 means not in the dict
+    QVector<Syllable> syllables;
+    QByteArray pool;
+
+    const Syllable *find(ushort code) const
+    {
+        if (code < kFirstCodePoint || code > kLastCodePoint)
+            return nullptr;
+        const quint16 id = ids.at(code - kFirstCodePoint);
+        return id > 0 ? &syllables.at(id) : nullptr;
     }
 
-    dict.reserve(25333);
-
-    QFile file(kDictFile);
-
-    if (!file.open(QIODevice::ReadOnly))
-        return;
-
-    QByteArray content = file.readAll();
-
-    file.close();
-
-    QTextStream stream(&content, QIODevice::ReadOnly);
-
-    while (!stream.atEnd()) {
-        const QString line = stream.readLine();
-        const QStringList items = line.split(QChar(':'));
-
-        if (items.size() == 2) {
-            dict.insert(static_cast<uint>(items[0].toInt(nullptr, 16)), items[1]);
-        }
+    QLatin1String text(const Syllable *syllable, bool tone) const
+    {
+        return QLatin1String(pool.constData() + syllable->offset, tone ? syllable->length : syllable->toneless);
     }
+};
+
+static const Table &table()
+{
+    static Table t;
+    static std::once_flag once;
+    std::call_once(once, []() {
+        t.ids.fill(0, kLastCodePoint - kFirstCodePoint + 1);
+        t.syllables.append(Table::Syllable());   // the id 0
+
+        QFile file(kDictFile);
+        if (!file.open(QIODevice::ReadOnly))
+            return;
+
+        QHash<QByteArray, quint16> interned;
+        const QByteArray &content = file.readAll();
+        for (const QByteArray &line : content.split('\n')) {
+            // 0x3400:qiu1
+            const int sep = line.indexOf(':');
+            if (sep <= 0)
+                continue;
+
+            bool ok = false;
+            const uint code = line.left(sep).toUInt(&ok, 16);
+            const QByteArray &pinyin = line.mid(sep + 1).trimmed();
+            if (!ok || code < kFirstCodePoint || code > kLastCodePoint || pinyin.isEmpty() || pinyin.size() > 0xff)
+                continue;
+
+            quint16 id = interned.value(pinyin);
+            if (id == 0) {
+                Table::Syllable syllable;
+                syllable.offset = t.pool.size();
+                syllable.length = static_cast<quint8>(pinyin.size());
+                int toneless = pinyin.size();
+                while (toneless > 0 && QChar::isDigit(static_cast<uchar>(pinyin.at(toneless - 1))))
+                    --toneless;
+                syllable.toneless = static_cast<quint8>(toneless);
+
+                id = static_cast<quint16>(t.syllables.size());
+                t.syllables.append(syllable);
+                t.pool.append(pinyin);
+                interned.insert(pinyin, id);
+            }
+            t.ids[static_cast<int>(code - kFirstCodePoint)] = id;
+        }
+        t.syllables.squeeze();
+        t.pool.squeeze();
+    });
+    return t;
 }
 
 QString Chinese2Pinyin(const QString& words) {
-    InitDict();
+    const Table &dict = table();
 
     QString result;
+    result.reserve(words.length() * 4);
+
+    for (const QChar &ch : words) {
+        if (const Table::Syllable *syllable = dict.find(ch.unicode()))
+            result.append(dict.text(syllable, true));
+        else
+            result.append(ch);
+    }
 
-    for (int i = 0; i < words.length(); ++i) {
-        const uint key = words.at(i).unicode();
-        auto find_result = dict.find(key);
+    return result;
+}
 
-        if (find_result != dict.end()) {
-            result.append(find_result.value());
-        } else {
-            result.append(words.at(i));
+/*!
+ * \brief convert \a words to the keys of pinyin matching in one pass, the tones are dropped.
+ * \a full gets the full pinyin, \a initials gets the first letter of every syllable,
+ * the characters not in the dict are kept in both.
+ * \return true if any chinese character is converted
+ */
+bool Chinese2PinyinKeys(const QString &words, QString *full, QString *initials)
+{
+    const Table &dict = table();
+    if (full)
+        full->reserve(full->size() + words.length() * 4);
+    if (initials)
+        initials->reserve(initials->size() + words.length());
+
+    bool converted = false;
+    for (const QChar &ch : words) {
+        const Table::Syllable *syllable = dict.find(ch.unicode());
+        if (!syllable || syllable->toneless == 0) {
+            if (full)
+                full->append(ch);
+            if (initials)
+                initials->append(ch);
+            continue;
         }
+
+        converted = true;
+        const QLatin1String &pinyin = dict.text(syllable, false);
+        if (full)
+            full->append(pinyin);
+        if (initials)
+            initials->append(pinyin.at(0));
     }
 
-    return result;
+    return converted;
 }
 
 }  // namespace Pinyin end
@@ -9,6 +9,7 @@
 
 namespace Pinyin {
 QString Chinese2Pinyin(const QString& words);
+bool Chinese2PinyinKeys(const QString &words, QString *full, QString *initials);
 };
 
 #endif  // CHINESE_2_PINYIN_H
@@ -157,3 +157,19 @@ QStringList DesktopFile::desktopMimeType() const
     return mimeType;
 }
 //---------------------------------------------------------------------------
+
+QDataStream &dfmbase::operator<<(QDataStream &out, const DesktopFile &file)
+{
+    out << file.fileName << file.name << file.genericName << file.localName
+        << file.exec << file.icon << file.type << file.categories << file.mimeType
+        << file.deepinId << file.deepinVendor << file.noDisplay << file.hidden;
+    return out;
+}
+
+QDataStream &dfmbase::operator>>(QDataStream &in, DesktopFile &file)
+{
+    in >> file.fileName >> file.name >> file.genericName >> file.localName
+            >> file.exec >> file.icon >> file.type >> file.categories >> file.mimeType
+            >> file.deepinId >> file.deepinVendor >> file.noDisplay >> file.hidden;
+    return in;
+}
@@ -8,6 +8,7 @@
 #include <dfm-base/dfm_base_global.h>
 
 #include <QStringList>
+#include <QDataStream>
 
 /**
  * @class DesktopFile
@@ -36,6 +37,9 @@ public:
     QStringList desktopCategories() const;
     QStringList desktopMimeType() const;
 
+    friend QDataStream &operator<<(QDataStream &out, const DesktopFile &file);
+    friend QDataStream &operator>>(QDataStream &in, DesktopFile &file);
+
 private:
     QString fileName;
     QString name;
@@ -52,6 +56,9 @@ private:
     bool hidden = false;
 };
 
+QDataStream &operator<<(QDataStream &out, const DesktopFile &file);
+QDataStream &operator>>(QDataStream &in, DesktopFile &file);
+
 }
 
 #endif   // DESKTOPFILE_H
@@ -0,0 +1,427 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dirsizecache.h"
+
+#include <dfm-base/base/standardpaths.h>
+#include <dfm-base/base/db/sqliteconnectionpool.h>
+#include <dfm-base/utils/fileutils.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QStack>
+#include <QDateTime>
+#include <QDataStream>
+#include <QVector>
+#include <QStorageInfo>
+#include <QSqlQuery>
+#include <QSqlError>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+
+using namespace dfmbase;
+
+static constexpr char kDatabaseName[] { "dirsize.db" };
+static constexpr int kSchemaVersion { 2 };
+static constexpr char kCreateTable[] {
+    "CREATE TABLE IF NOT EXISTS dir_size (path BLOB PRIMARY KEY, dev INTEGER, ino INTEGER, "
+    "mtime INTEGER, size INTEGER, progress INTEGER, files INTEGER, dirs INTEGER, children BLOB, "
+    "linked_dirs BLOB, hard_links BLOB, read_time INTEGER)"
+};
+// in seconds, an older record is read again to find the files rewritten while nobody watched
+static constexpr qint64 kRecordMaxAge { 60 * 60 };
+
+namespace {
+
+using InodeKey = QPair<quint64, quint64>;   // dev, ino
+
+// a regular file with more than one name, its size is counted once in a tree
+struct HardLink
+{
+    quint64 dev { 0 };
+    quint64 ino { 0 };
+    qint64 size { 0 };
+};
+
+QDataStream &operator<<(QDataStream &out, const HardLink &link)
+{
+    return out << link.dev << link.ino << link.size;
+}
+
+QDataStream &operator>>(QDataStream &in, HardLink &link)
+{
+    return in >> link.dev >> link.ino >> link.size;
+}
+
+struct DirRecord
+{
+    quint64 dev { 0 };
+    quint64 ino { 0 };
+    qint64 mtime { 0 };
+    qint64 size { 0 };   // the hard links are not in it
+    qint64 progressSize { 0 };
+    int files { 0 };
+    int dirs { 0 };   // the sub directories not counted into, such as the proc mounts
+    QByteArray children;   // the names of the sub directories, separated by '/'
+    QByteArray linkedDirs;   // the names of the symlinks to directories, separated by '/'
+    QVector<HardLink> hardLinks;
+    qint64 readTime { 0 };
+    bool changed { false };
+    bool visited { false };
+};
+
+// a directory to walk, the linked ones are reached by following a symlink
+struct WalkEntry
+{
+    QByteArray path;
+    bool linked { false };
+};
+
+QByteArray encodeHardLinks(const QVector<HardLink> &links)
+{
+    QByteArray data;
+    if (links.isEmpty())
+        return data;
+
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << links;
+    return data;
+}
+
+QVector<HardLink> decodeHardLinks(const QByteArray &data)
+{
+    QVector<HardLink> links;
+    if (data.isEmpty())
+        return links;
+
+    QDataStream in(data);
+    in >> links;
+    if (in.status() != QDataStream::Ok)
+        links.clear();
+    return links;
+}
+
+qint64 mtimeOf(const struct stat &st)
+{
+    return static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+QByteArray childPath(const QByteArray &dirPath, const char *name)
+{
+    return dirPath.endsWith('/') ? dirPath + name : dirPath + '/' + name;
+}
+
+// the file statistics never count into the proc and avfsd storages
+bool isSkippedMount(const QByteArray &path)
+{
+    const QString &realPath { QFileInfo(QFile::decodeName(path)).canonicalFilePath() };
+    const QStorageInfo si(realPath);
+    return si.rootPath() == realPath && (si.device() == "proc" || si.device() == "avfsd");
+}
+
+bool readDir(const QByteArray &dirPath, const struct stat &dirStat, DirRecord *record)
+{
+    DIR *dir = ::opendir(dirPath.constData());
+    if (!dir)
+        return false;
+
+    const int fd = ::dirfd(dir);
+    const qint64 pageSize = FileUtils::getMemoryPageSize();
+    QList<QByteArray> children;
+    QList<QByteArray> linkedDirs;
+    while (struct dirent *entry = ::readdir(dir)) {
+        const char *name = entry->d_name;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
+            continue;
+
+        struct stat st;
+        if (::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+            continue;
+
+        if (S_ISDIR(st.st_mode)) {
+            if (st.st_dev != dirStat.st_dev && isSkippedMount(childPath(dirPath, name))) {
+                ++record->dirs;
+                record->progressSize += pageSize;
+            } else {
+                children.append(name);
+            }
+            continue;
+        }
+
+        if (S_ISLNK(st.st_mode)) {
+            struct stat target;
+            if (::fstatat(fd, name, &target, 0) == 0 && S_ISDIR(target.st_mode)) {
+                if (target.st_dev != dirStat.st_dev && isSkippedMount(childPath(dirPath, name))) {
+                    ++record->dirs;
+                    record->progressSize += pageSize;
+                } else {
+                    linkedDirs.append(name);
+                }
+                continue;
+            }
+        }
+
+        ++record->files;
+        if (S_ISREG(st.st_mode) && st.st_nlink > 1) {
+            record->hardLinks.append({ static_cast<quint64>(st.st_dev), static_cast<quint64>(st.st_ino), st.st_size });
+        } else if (S_ISREG(st.st_mode)) {
+            record->size += st.st_size;
+            record->progressSize += st.st_size > 0 ? st.st_size : pageSize;
+        } else if (S_ISLNK(st.st_mode)) {
+            record->progressSize += pageSize;
+        }
+    }
+    ::closedir(dir);
+
+    record->dev = dirStat.st_dev;
+    record->ino = dirStat.st_ino;
+    record->mtime = mtimeOf(dirStat);
+    record->children = children.join('/');
+    record->linkedDirs = linkedDirs.join('/');
+    record->readTime = QDateTime::currentSecsSinceEpoch();
+    record->changed = true;
+    return true;
+}
+
+QSqlDatabase openDatabase(const QString &path)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSqlDatabase db { SqliteConnectionPool::instance().openConnection(path) };
+    if (!db.isOpen())
+        return QSqlDatabase();
+
+    QSqlQuery query(db);
+    // the records of an older schema are dropped, they are read again
+    if (query.exec("PRAGMA user_version") && query.next() && query.value(0).toInt() != kSchemaVersion) {
+        query.exec("DROP TABLE IF EXISTS dir_size");
+        query.exec(QString("PRAGMA user_version = %1").arg(kSchemaVersion));
+    }
+
+    if (!query.exec(kCreateTable)) {
+        qCWarning(logDFMBase) << "dir size cache: failed to create the table:" << query.lastError().text();
+        return QSqlDatabase();
+    }
+    return db;
+}
+
+// the records of the directory and all the directories under it
+QHash<QByteArray, DirRecord> loadRecords(const QSqlDatabase &db, const QByteArray &root)
+{
+    QHash<QByteArray, DirRecord> records;
+    if (!db.isOpen())
+        return records;
+
+    // the paths under root are ordered in [root/, root0), '0' follows '/'
+    const QByteArray &prefix { root.endsWith('/') ? root : root + '/' };
+    QSqlQuery query(db);
+    query.prepare("SELECT path, dev, ino, mtime, size, progress, files, dirs, children, linked_dirs, hard_links, read_time "
+                  "FROM dir_size WHERE path = ? OR (path >= ? AND path < ?)");
+    query.addBindValue(root);
+    query.addBindValue(prefix);
+    query.addBindValue(prefix.left(prefix.size() - 1) + '0');
+    if (!query.exec()) {
+        qCWarning(logDFMBase) << "dir size cache: failed to load:" << query.lastError().text();
+        return records;
+    }
+
+    while (query.next()) {
+        DirRecord record;
+        record.dev = static_cast<quint64>(query.value(1).toLongLong());
+        record.ino = static_cast<quint64>(query.value(2).toLongLong());
+        record.mtime = query.value(3).toLongLong();
+        record.size = query.value(4).toLongLong();
+        record.progressSize = query.value(5).toLongLong();
+        record.files = query.value(6).toInt();
+        record.dirs = query.value(7).toInt();
+        record.children = query.value(8).toByteArray();
+        record.linkedDirs = query.value(9).toByteArray();
+        record.hardLinks = decodeHardLinks(query.value(10).toByteArray());
+        record.readTime = query.value(11).toLongLong();
+        records.insert(query.value(0).toByteArray(), record);
+    }
+    return records;
+}
+
+void saveRecords(QSqlDatabase db, const QHash<QByteArray, DirRecord> &records)
+{
+    if (!db.isOpen())
+        return;
+
+    db.transaction();
+    QSqlQuery insert(db);
+    insert.prepare("INSERT OR REPLACE INTO dir_size VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    QSqlQuery remove(db);
+    remove.prepare("DELETE FROM dir_size WHERE path = ?");
+
+    for (auto it = records.cbegin(); it != records.cend(); ++it) {
+        if (!it->visited) {
+            remove.addBindValue(it.key());
+            remove.exec();
+        } else if (it->changed) {
+            insert.addBindValue(it.key());
+            insert.addBindValue(static_cast<qint64>(it->dev));
+            insert.addBindValue(static_cast<qint64>(it->ino));
+            insert.addBindValue(it->mtime);
+            insert.addBindValue(it->size);
+            insert.addBindValue(it->progressSize);
+            insert.addBindValue(it->files);
+            insert.addBindValue(it->dirs);
+            insert.addBindValue(it->children);
+            insert.addBindValue(it->linkedDirs);
+            insert.addBindValue(encodeHardLinks(it->hardLinks));
+            insert.addBindValue(it->readTime);
+            insert.exec();
+        }
+    }
+
+    if (!db.commit()) {
+        qCWarning(logDFMBase) << "dir size cache: failed to save:" << db.lastError().text();
+        db.rollback();
+    }
+}
+
+}   // namespace
+
+DirSizeCache &DirSizeCache::instance()
+{
+    static DirSizeCache ins(StandardPaths::location(StandardPaths::kCachePath) + "/" + kDatabaseName);
+    return ins;
+}
+
+DirSizeCache::DirSizeCache(const QString &databasePath, QObject *parent)
+    : QObject(parent), dbPath(databasePath), recordMaxAge(kRecordMaxAge)
+{
+}
+
+QString DirSizeCache::databasePath() const
+{
+    return dbPath;
+}
+
+/*!
+ * \brief count the tree of the local directory \a dirPath, the directory itself is counted.
+ * Like the file statistics job, a directory or a hard linked file reached again is counted
+ * without its size, and the symlinks to directories are walked into if \a followLinks.
+ * \param counted the directories and hard links counted in the other trees of the same job
+ * \return false if it is canceled by \a progress, the result is partial then
+ */
+bool DirSizeCache::statistics(const QString &dirPath, Statistics *result, const Progress &progress, bool followLinks,
+                              Counted *counted)
+{
+    Q_ASSERT(result);
+
+    const QByteArray &root { QFile::encodeName(QDir::cleanPath(dirPath)) };
+    QSqlDatabase db { openDatabase(dbPath) };
+    QHash<QByteArray, DirRecord> records { loadRecords(db, root) };
+    const qint64 pageSize = FileUtils::getMemoryPageSize();
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+    QList<QByteArray> takenChanges;
+    Counted treeCounted;
+    QSet<InodeKey> &walkedDirs { counted ? counted->dirs : treeCounted.dirs };
+    QSet<InodeKey> &countedLinks { counted ? counted->links : treeCounted.links };
+    QStack<WalkEntry> dirs;
+    dirs.push({ root, false });
+    while (!dirs.isEmpty()) {
+        const WalkEntry entry { dirs.pop() };
+        const QByteArray &path { entry.path };
+        struct stat st;
+        const int ret = entry.linked ? ::stat(path.constData(), &st) : ::lstat(path.constData(), &st);
+        if (ret != 0 || !S_ISDIR(st.st_mode))
+            continue;
+
+        // a loop of symlinks, or a directory linked from other places
+        const InodeKey dirKey { static_cast<quint64>(st.st_dev), static_cast<quint64>(st.st_ino) };
+        if (walkedDirs.contains(dirKey)) {
+            ++result->directoryCount;
+            continue;
+        }
+        walkedDirs.insert(dirKey);
+
+        auto it = records.find(path);
+        const bool changed = takeChanged(path);
+        if (changed)
+            takenChanges.append(path);
+        if (it == records.end() || changed || it->dev != st.st_dev || it->ino != st.st_ino || it->mtime != mtimeOf(st)
+            || now - it->readTime >= recordMaxAge) {
+            DirRecord record;
+            if (!readDir(path, st, &record)) {
+                // the unreadable directory is counted alone, and not recorded
+                records.remove(path);
+                ++result->directoryCount;
+                result->totalProgressSize += pageSize;
+                continue;
+            }
+            it = records.insert(path, record);
+        }
+
+        it->visited = true;
+        result->directoryCount += 1 + it->dirs;
+        result->filesCount += it->files;
+        result->totalSize += it->size;
+        result->totalProgressSize += pageSize + it->progressSize;
+
+        for (const HardLink &link : it->hardLinks) {
+            const InodeKey linkKey { link.dev, link.ino };
+            if (countedLinks.contains(linkKey))
+                continue;
+            countedLinks.insert(linkKey);
+            result->totalSize += link.size;
+            result->totalProgressSize += link.size > 0 ? link.size : pageSize;
+        }
+
+        const QList<QByteArray> &children { it->children.split('/') };
+        for (const QByteArray &name : children) {
+            if (!name.isEmpty())
+                dirs.push({ childPath(path, name.constData()), false });
+        }
+
+        const QList<QByteArray> &linkedDirs { it->linkedDirs.split('/') };
+        for (const QByteArray &name : linkedDirs) {
+            if (name.isEmpty())
+                continue;
+            if (followLinks) {
+                dirs.push({ childPath(path, name.constData()), true });
+            } else {
+                ++result->directoryCount;
+                result->totalProgressSize += pageSize;
+            }
+        }
+
+        if (progress && !progress(*result)) {
+            // nothing is saved, the changed directories stay marked
+            QMutexLocker lk(&changedMutex);
+            for (const QByteArray &dirPath : takenChanges)
+                changedDirs.insert(dirPath);
+            return false;
+        }
+    }
+
+    saveRecords(db, records);
+    return true;
+}
+
+/*!
+ * \brief the file \a url is changed in place, its directory is read again next time
+ */
+void DirSizeCache::markChanged(const QUrl &url)
+{
+    if (!url.isLocalFile())
+        return;
+
+    const QString &dirPath { QFileInfo(QDir::cleanPath(url.toLocalFile())).absolutePath() };
+    QMutexLocker lk(&changedMutex);
+    changedDirs.insert(QFile::encodeName(dirPath));
+}
+
+bool DirSizeCache::takeChanged(const QByteArray &dirPath)
+{
+    QMutexLocker lk(&changedMutex);
+    return changedDirs.remove(dirPath);
+}
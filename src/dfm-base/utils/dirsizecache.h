@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DIRSIZECACHE_H
+#define DIRSIZECACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QObject>
+#include <QMutex>
+#include <QSet>
+#include <QPair>
+#include <QUrl>
+
+#include <functional>
+
+namespace dfmbase {
+
+/*!
+ * \brief The DirSizeCache class keeps the size statistics of the local directories
+ * in a sqlite database under the cache directory.
+ *
+ * Every directory has a record of its own entries: the total size and the count of
+ * its files, and the names of its sub directories, with the dev/ino/mtime of the
+ * directory when it was read. Counting a tree stats each directory only, a directory
+ * is read again only if it is not the one recorded or its mtime changed.
+ *
+ * Rewriting a file does not change the mtime of its directory, the watchers report it
+ * by markChanged(), and a record older than an hour is read again for the changes
+ * nobody watched.
+ */
+class DirSizeCache : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(DirSizeCache)
+
+public:
+    struct Statistics
+    {
+        qint64 totalSize { 0 };
+        qint64 totalProgressSize { 0 };
+        int filesCount { 0 };
+        int directoryCount { 0 };
+    };
+
+    // the directories and hard linked files counted already, shared by the trees counted together
+    struct Counted
+    {
+        QSet<QPair<quint64, quint64>> dirs;   // dev, ino
+        QSet<QPair<quint64, quint64>> links;
+    };
+
+    // called after every directory, returns false to cancel the counting
+    using Progress = std::function<bool(const Statistics &current)>;
+
+    static DirSizeCache &instance();
+    explicit DirSizeCache(const QString &databasePath, QObject *parent = nullptr);
+
+    QString databasePath() const;
+    bool statistics(const QString &dirPath, Statistics *result, const Progress &progress = nullptr, bool followLinks = true,
+                    Counted *counted = nullptr);
+
+public Q_SLOTS:
+    void markChanged(const QUrl &url);
+
+private:
+    bool takeChanged(const QByteArray &dirPath);
+
+    QString dbPath;
+    qint64 recordMaxAge;   // in seconds
+    QMutex changedMutex;
+    QSet<QByteArray> changedDirs;
+};
+
+}
+
+#endif   // DIRSIZECACHE_H
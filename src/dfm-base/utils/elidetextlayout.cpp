@@ -10,16 +10,135 @@
 #include <QTextDocument>
 #include <QTextLayout>
 #include <QTextBlock>
+#include <QSharedPointer>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QCache>
+#include <QMutex>
+#include <QAtomicInteger>
 #include <QDebug>
 
 #include <dfm-base/dfm_base_global.h>
 
 using namespace dfmbase;
 
+namespace {
+
+static constexpr int kLayoutCacheSize { 8192 };
+
+struct LayoutCacheKey
+{
+    QString text;
+    QString font;
+    QSizeF size;
+    int elideMode { 0 };
+    int lineHeight { 0 };
+    uint alignment { 0 };
+    uint wrapMode { 0 };
+    int direction { 0 };
+    int dpi { 0 };
+    qreal dpr { 1.0 };
+
+    bool operator==(const LayoutCacheKey &other) const
+    {
+        return text == other.text && font == other.font && size == other.size
+                && elideMode == other.elideMode && lineHeight == other.lineHeight
+                && alignment == other.alignment && wrapMode == other.wrapMode
+                && direction == other.direction && dpi == other.dpi && qFuzzyCompare(dpr, other.dpr);
+    }
+};
+
+inline uint qHash(const LayoutCacheKey &key, uint seed = 0)
+{
+    auto combine = [&seed](uint h) {
+        seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+    combine(::qHash(key.text));
+    combine(::qHash(key.font));
+    combine(::qHash(qRound(key.size.width())));
+    combine(::qHash(qRound(key.size.height())));
+    combine(::qHash(key.elideMode));
+    combine(::qHash(key.lineHeight));
+    combine(::qHash(key.alignment ^ (key.wrapMode << 16)));
+    combine(::qHash(key.direction ^ (key.dpi << 2)));
+    return seed;
+}
+
+LayoutCacheKey makeCacheKey(const QString &text, const QFont &font, const QSizeF &size, Qt::TextElideMode elideMode,
+                            int lineHeight, uint alignment, uint wrapMode, int direction, const QPainter *painter)
+{
+    LayoutCacheKey key;
+    key.text = text;
+    key.font = font.key();
+    key.size = size;
+    key.elideMode = elideMode;
+    key.lineHeight = lineHeight;
+    key.alignment = alignment;
+    key.wrapMode = wrapMode;
+    key.direction = direction;
+    if (painter && painter->device()) {
+        key.dpi = painter->device()->logicalDpiY();
+        key.dpr = painter->device()->devicePixelRatioF();
+    }
+    return key;
+}
+
+struct LayoutCacheEntry
+{
+    // every line is laid out alone, relative to the top left of the layout rect,
+    // and painted by QTextLine::draw whether it is just laid out or taken from the cache.
+    QList<QSharedPointer<QTextLayout>> layouts;
+    QList<QRectF> rects;
+    QStringList lines;
+};
+
+using LayoutCacheEntryPointer = QSharedPointer<LayoutCacheEntry>;
+
+/*!
+ * \brief The LayoutCache class keeps the result of recent layouts, so that painting
+ * the same text with the same options again does not shape the text.
+ */
+class LayoutCache
+{
+public:
+    static LayoutCache *instance()
+    {
+        static LayoutCache ins;
+        return &ins;
+    }
+
+    QMutex mutex;
+    QCache<LayoutCacheKey, LayoutCacheEntryPointer> entries;
+    QAtomicInteger<quint64> hits { 0 };
+    QAtomicInteger<quint64> misses { 0 };
+
+private:
+    LayoutCache()
+        : entries(kLayoutCacheSize)
+    {
+        auto app = qobject_cast<QGuiApplication *>(QCoreApplication::instance());
+        if (!app)
+            return;
+
+        // font metrics change with the font and the logical dpi.
+        auto clear = [] { ElideTextLayout::clearLayoutCache(); };
+        QObject::connect(app, &QGuiApplication::fontChanged, app, clear);
+        auto watchScreen = [app, clear](QScreen *screen) {
+            QObject::connect(screen, &QScreen::logicalDotsPerInchChanged, app, clear);
+        };
+        for (QScreen *screen : app->screens())
+            watchScreen(screen);
+        QObject::connect(app, &QGuiApplication::screenAdded, app, watchScreen);
+    }
+};
+
+}
+
 ElideTextLayout::ElideTextLayout(const QString &text)
     : document(new QTextDocument)
 {
     document->setPlainText(text);
+    plainTextRevision = document->revision();
 
     attributes.insert(kFont, document->defaultFont());
     attributes.insert(kLineHeight, QFontMetrics(document->defaultFont()).height());
@@ -38,6 +157,7 @@ ElideTextLayout::~ElideTextLayout()
 void ElideTextLayout::setText(const QString &text)
 {
     document->setPlainText(text);
+    plainTextRevision = document->revision();
 }
 
 QString ElideTextLayout::text() const
@@ -46,6 +166,87 @@ QString ElideTextLayout::text() const
 }
 
 QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background, QStringList *textLines)
+{
+    // the document is extended by others, such as tags, it must be laid out by itself.
+    if (document->revision() != plainTextRevision)
+        return layoutDocument(rect, elideMode, painter, background, textLines);
+
+    const LayoutCacheKey &key = makeCacheKey(text(), attribute<QFont>(kFont), rect.size(), elideMode, attribute<int>(kLineHeight),
+                                             attribute<uint>(kAlignment), attribute<uint>(kWrapMode),
+                                             static_cast<int>(attribute<Qt::LayoutDirection>(kTextDirection)), painter);
+    auto cache = LayoutCache::instance();
+    LayoutCacheEntryPointer entry;
+    {
+        QMutexLocker lk(&cache->mutex);
+        if (auto cached = cache->entries.object(key))
+            entry = *cached;
+    }
+
+    if (entry) {
+        cache->hits.fetchAndAddRelaxed(1);
+    } else {
+        cache->misses.fetchAndAddRelaxed(1);
+        entry.reset(new LayoutCacheEntry);
+        const QList<QRectF> &rects = layoutDocument(QRectF(QPointF(0, 0), rect.size()), elideMode, nullptr, Qt::NoBrush, &entry->lines);
+        if (rects.size() != entry->lines.size())
+            return layoutDocument(rect, elideMode, painter, background, textLines);
+
+        // lay out every line again in its own layout, to be drawn later.
+        const int textLineHeight = attribute<int>(kLineHeight);
+        const uint wrapMode = attribute<uint>(kWrapMode);
+        setAttribute(kWrapMode, static_cast<uint>(QTextOption::NoWrap));
+        for (int i = 0; i < entry->lines.size(); ++i) {
+            QSharedPointer<QTextLayout> lay(new QTextLayout(entry->lines.at(i)));
+            initLayoutOption(lay.data());
+            lay->beginLayout();
+            QTextLine line = lay->createLine();
+            QRectF lineRect = rects.at(i);
+            if (line.isValid()) {
+                line.setLineWidth(rect.width());
+                line.setPosition(QPointF(0, i * textLineHeight));
+                lineRect = line.naturalTextRect();
+                lineRect.setHeight(textLineHeight);
+            }
+            lay->endLayout();
+
+            entry->layouts.append(lay);
+            entry->rects.append(lineRect);
+        }
+        setAttribute(kWrapMode, wrapMode);
+
+        QMutexLocker lk(&cache->mutex);
+        cache->entries.insert(key, new LayoutCacheEntryPointer(entry));
+    }
+
+    QList<QRectF> ret;
+    const QPointF &origin = rect.topLeft();
+    QRectF lastLineRect;
+    for (int i = 0; i < entry->rects.size(); ++i) {
+        const QRectF &lineRect = entry->rects.at(i).translated(origin);
+        ret.append(lineRect);
+
+        if (painter) {
+            // draw background
+            if (background.style() != Qt::NoBrush)
+                lastLineRect = drawLineBackground(painter, lineRect, lastLineRect, background);
+
+            // draw text line
+            QTextLine line = entry->layouts.at(i)->lineAt(0);
+            if (line.isValid())
+                line.draw(painter, origin);
+        }
+    }
+
+    if (textLines)
+        textLines->append(entry->lines);
+
+    return ret;
+}
+
+/*!
+ * \brief lay out the document directly, and draw the lines if \a painter is set
+ */
+QList<QRectF> ElideTextLayout::layoutDocument(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background, QStringList *textLines)
 {
     QList<QRectF> ret;
     QTextLayout *lay = document->firstBlock().layout();
@@ -64,15 +265,13 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
     QRectF lastLineRect;
     QString elideText;
     QString curText = text();
-    auto processLine = [this, &ret, painter, &lastLineRect, background, textLineHeight, &curText, textLines](QTextLine &line) {
+    QStringList lines;
+    auto processLine = [this, &ret, painter, &lastLineRect, background, textLineHeight, &curText, &lines](QTextLine &line) {
         QRectF lRect = line.naturalTextRect();
         lRect.setHeight(textLineHeight);
 
         ret.append(lRect);
-        if (textLines) {
-            const auto &t = curText.mid(line.textStart(), line.textLength());
-            textLines->append(t);
-        }
+        lines.append(curText.mid(line.textStart(), line.textLength()));
 
         // draw
         if (painter) {
@@ -140,9 +339,35 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
         newlay.endLayout();
     }
 
+    if (textLines)
+        textLines->append(lines);
+
     return ret;
 }
 
+void ElideTextLayout::clearLayoutCache()
+{
+    auto cache = LayoutCache::instance();
+    QMutexLocker lk(&cache->mutex);
+    cache->entries.clear();
+}
+
+/*!
+ * \brief the layouts taken from the cache since the process started, for tuning the cache size
+ */
+quint64 ElideTextLayout::layoutCacheHits()
+{
+    return LayoutCache::instance()->hits.loadAcquire();
+}
+
+/*!
+ * \brief the layouts not found in the cache since the process started
+ */
+quint64 ElideTextLayout::layoutCacheMisses()
+{
+    return LayoutCache::instance()->misses.loadAcquire();
+}
+
 QRectF ElideTextLayout::drawLineBackground(QPainter *painter, const QRectF &curLineRect, QRectF lastLineRect, const QBrush &brush) const
 {
     const qreal backgroundRadius = attribute<qreal>(kBackgroundRadius);
@@ -32,6 +32,11 @@ public:
     void setText(const QString &text);
     QString text() const;
     QList<QRectF> layout(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter = nullptr, const QBrush &background = Qt::NoBrush, QStringList *textLines = nullptr);
+
+    static void clearLayoutCache();
+    static quint64 layoutCacheHits();
+    static quint64 layoutCacheMisses();
+
 public:
     inline QTextDocument *documentHandle() {
         return document;
@@ -49,9 +54,11 @@ public:
 protected:
     QRectF drawLineBackground(QPainter *painter, const QRectF &curLineRect, QRectF lastLineRect, const QBrush &brush) const;
     virtual void initLayoutOption(QTextLayout *lay);
+    QList<QRectF> layoutDocument(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background, QStringList *textLines);
 protected:
     QTextDocument *document = nullptr;
     QMap<Attribute, QVariant> attributes;
+    int plainTextRevision = 0;
 };
 }
 
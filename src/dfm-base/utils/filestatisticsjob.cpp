@@ -9,10 +9,12 @@
 #include <dfm-base/interfaces/abstractdiriterator.h>
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/utils/fileutils.h>
+#include <dfm-base/utils/dirsizecache.h>
 #include <dfm-base/utils/private/filestatissticsjob_p.h>
 
 #include <dfm-io/dfmio_utils.h>
 
+#include <QDir>
 #include <QMutex>
 #include <QQueue>
 #include <QTimer>
@@ -291,6 +293,90 @@ bool FileStatisticsJobPrivate::checkInode(const FileInfoPointer info)
     return true;
 }
 
+bool FileStatisticsJobPrivate::canUseDirSizeCache() const
+{
+    return fileHints.testFlag(FileStatisticsJob::kUseDirSizeCache) && !fileHints.testFlag(FileStatisticsJob::kSingleDepth);
+}
+
+/*!
+ * \brief find the selected local directories, they are counted by DirSizeCache
+ */
+void FileStatisticsJobPrivate::collectCachedRoots()
+{
+    cachedRootPaths.clear();
+    cacheCounted = {};
+    if (!canUseDirSizeCache())
+        return;
+
+    for (const QUrl &url : sourceUrlList) {
+        if (!url.isLocalFile())
+            continue;
+
+        const QString &path = QDir::cleanPath(url.toLocalFile());
+        struct stat st;
+        if (::lstat(QFile::encodeName(path).constData(), &st) == 0 && S_ISDIR(st.st_mode))
+            cachedRootPaths.insert(path);
+    }
+}
+
+/*!
+ * \brief whether \a url is under another selected directory counted by DirSizeCache,
+ * it is counted with the directory then, as the directory iterator skips the selected files.
+ */
+bool FileStatisticsJobPrivate::isInCachedRoot(const QUrl &url) const
+{
+    if (cachedRootPaths.isEmpty() || !url.isLocalFile())
+        return false;
+
+    QString path = QDir::cleanPath(url.toLocalFile());
+    if (path == "/")
+        return false;
+
+    for (int index = path.lastIndexOf('/'); index >= 0; index = path.lastIndexOf('/')) {
+        path.truncate(index > 0 ? index : 1);
+        if (cachedRootPaths.contains(path))
+            return true;
+        if (index == 0)
+            break;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief count the local directory \a url by DirSizeCache, the unchanged directories are not read again
+ * \return false if the url is not a local directory, it is counted as usual then
+ */
+bool FileStatisticsJobPrivate::statisticsByCache(const QUrl &url, const bool followLink)
+{
+    if (!canUseDirSizeCache() || !url.isLocalFile())
+        return false;
+
+    struct stat st;
+    if (::lstat(QFile::encodeName(url.toLocalFile()).constData(), &st) != 0 || !S_ISDIR(st.st_mode))
+        return false;
+
+    // selected twice
+    if (cacheCounted.dirs.contains({ static_cast<quint64>(st.st_dev), static_cast<quint64>(st.st_ino) }))
+        return true;
+
+    const qint64 size = totalSize;
+    const qint64 progressSize = totalProgressSize;
+    const int files = filesCount;
+    const int dirs = directoryCount;
+    DirSizeCache::Statistics result;
+    DirSizeCache::instance().statistics(url.toLocalFile(), &result, [&](const DirSizeCache::Statistics &current) {
+        totalSize = size + current.totalSize;
+        totalProgressSize = progressSize + current.totalProgressSize;
+        filesCount = files + current.filesCount;
+        directoryCount = dirs + current.directoryCount;
+        emitSizeChanged();
+        return stateCheck();
+    }, followLink, &cacheCounted);
+
+    return true;
+}
+
 FileStatisticsJob::FileStatisticsJob(QObject *parent)
     : QThread(parent), d(new FileStatisticsJobPrivate(this))
 {
@@ -477,11 +563,16 @@ void FileStatisticsJob::statistcsOtherFileSystem()
             }
         }
     } else {
+        d->collectCachedRoots();
         for (const QUrl &url : d->sourceUrlList) {
+            if (d->isInCachedRoot(url))
+                continue;
+
             // 选择的列表中包含avfsd/proc挂载路径时禁用过滤
             FileHints save_file_hints = d->fileHints;
             d->fileHints = d->fileHints | kDontSkipAVFSDStorage | kDontSkipPROCStorage;
-            d->processFile(url, followLink, directory_queue);
+            if (!d->statisticsByCache(url, followLink))
+                d->processFile(url, followLink, directory_queue);
             d->sizeInfo->allFiles << url;
             d->fileHints = save_file_hints;
 
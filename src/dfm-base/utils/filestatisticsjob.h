@@ -44,6 +44,8 @@ public:
         kDontSkipBlockDeviceFile = 0x0080,
         kDontSkipFIFOFile = 0x0100,
         kDontSkipSocketFile = 0x0200,
+
+        kUseDirSizeCache = 0x0400,   // count the local directories by DirSizeCache
     };
 
     Q_ENUM(FileHint)
@@ -4,6 +4,7 @@
 
 #include "private/infocache_p.h"
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/utils/dirsizecache.h>
 
 #include <dfm-io/dfileinfo.h>
 
@@ -290,6 +291,7 @@ FileInfoPointer InfoCache::getCacheInfo(const QUrl &url)
  */
 void InfoCache::refreshFileInfo(const QUrl &url)
 {
+    DirSizeCache::instance().markChanged(url);
     FileInfoPointer info = getCacheInfo(url);
     if (info)
         info->updateAttributes();
@@ -0,0 +1,270 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "journaledstore.h"
+
+#include <QSaveFile>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDir>
+
+using namespace dfmbase;
+
+static constexpr quint32 kStoreMagic { 0x44464d4a };   // "DFMJ"
+static constexpr quint32 kStoreVersion { 1 };
+static constexpr QDataStream::Version kStreamVersion { QDataStream::Qt_5_11 };
+
+// the journal is compacted when it is larger than both the snapshot and it.
+static constexpr qint64 kMinCompactSize { 64 * 1024 };
+
+namespace {
+// map the file and call \a parse on its content, the content is valid only in \a parse.
+template<typename Func>
+bool mapFile(QFile &file, Func parse)
+{
+    if (file.size() <= 0)
+        return false;
+
+    uchar *mem = file.map(0, file.size());
+    if (!mem) {
+        qCWarning(logDFMBase) << "store: failed to map" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char *>(mem), static_cast<int>(file.size()));
+    parse(raw);
+    file.unmap(mem);
+    return true;
+}
+}
+
+JournaledStore::JournaledStore(const QString &path)
+    : storePath(path),
+      journal(path + ".journal")
+{
+    QFileInfo(path).absoluteDir().mkpath(".");
+    load();
+}
+
+JournaledStore::~JournaledStore()
+{
+    QMutexLocker lk(&mutex);
+    journal.close();
+}
+
+QString JournaledStore::path() const
+{
+    return storePath;
+}
+
+bool JournaledStore::isEmpty() const
+{
+    QMutexLocker lk(&mutex);
+    return data.isEmpty();
+}
+
+bool JournaledStore::contains(const QString &key) const
+{
+    QMutexLocker lk(&mutex);
+    return data.contains(key);
+}
+
+QByteArray JournaledStore::value(const QString &key, const QByteArray &defaultValue) const
+{
+    QMutexLocker lk(&mutex);
+    return data.value(key, defaultValue);
+}
+
+/*!
+ * \brief the values whose key starts with \a prefix, the prefix is removed from the keys.
+ */
+QMap<QString, QByteArray> JournaledStore::values(const QString &prefix) const
+{
+    QMap<QString, QByteArray> ret;
+    QMutexLocker lk(&mutex);
+    for (auto it = data.lowerBound(prefix); it != data.end() && it.key().startsWith(prefix); ++it)
+        ret.insert(it.key().mid(prefix.size()), it.value());
+
+    return ret;
+}
+
+void JournaledStore::setValue(const QString &key, const QByteArray &value)
+{
+    update({ { key, value } }, {});
+}
+
+void JournaledStore::remove(const QString &key)
+{
+    update({}, { key });
+}
+
+/*!
+ * \brief apply \a changed and \a removed, the unchanged values are not journaled.
+ */
+void JournaledStore::update(const QMap<QString, QByteArray> &changed, const QStringList &removed)
+{
+    QByteArray records;
+    QMutexLocker lk(&mutex);
+    for (const QString &key : removed) {
+        if (data.remove(key) > 0)
+            records.append(record(kRemove, key, QByteArray()));
+    }
+
+    for (auto it = changed.cbegin(); it != changed.cend(); ++it) {
+        auto cur = data.find(it.key());
+        if (cur != data.end() && cur.value() == it.value())
+            continue;
+        data.insert(it.key(), it.value());
+        records.append(record(kSet, it.key(), it.value()));
+    }
+
+    if (!records.isEmpty())
+        appendJournal(records);
+}
+
+void JournaledStore::clear()
+{
+    QMutexLocker lk(&mutex);
+    data.clear();
+    compactLocked();
+}
+
+bool JournaledStore::needCompact() const
+{
+    QMutexLocker lk(&mutex);
+    return journalSize > qMax(kMinCompactSize, snapshotSize);
+}
+
+bool JournaledStore::compact()
+{
+    QMutexLocker lk(&mutex);
+    return compactLocked();
+}
+
+void JournaledStore::load()
+{
+    QMutexLocker lk(&mutex);
+    QFile snapshot(storePath);
+    if (snapshot.open(QIODevice::ReadOnly)) {
+        mapFile(snapshot, [this](const QByteArray &raw) {
+            QDataStream in(raw);
+            in.setVersion(kStreamVersion);
+            quint32 magic { 0 };
+            quint32 version { 0 };
+            in >> magic >> version;
+            if (magic != kStoreMagic || version != kStoreVersion) {
+                qCWarning(logDFMBase) << "store: unknown snapshot" << storePath;
+                return;
+            }
+
+            in >> data;
+            if (in.status() != QDataStream::Ok) {
+                qCWarning(logDFMBase) << "store: snapshot is corrupted" << storePath;
+                data.clear();
+            }
+        });
+        snapshotSize = snapshot.size();
+        snapshot.close();
+    }
+
+    qint64 validSize = 0;
+    if (journal.open(QIODevice::ReadOnly)) {
+        mapFile(journal, [this, &validSize](const QByteArray &raw) {
+            QDataStream in(raw);
+            in.setVersion(kStreamVersion);
+            while (!in.atEnd()) {
+                QByteArray payload;
+                quint16 checksum { 0 };
+                in >> payload >> checksum;
+                if (in.status() != QDataStream::Ok
+                    || checksum != qChecksum(payload.constData(), static_cast<uint>(payload.size()))) {
+                    qCWarning(logDFMBase) << "store: drop the torn journal from" << validSize;
+                    break;
+                }
+
+                QDataStream rec(payload);
+                rec.setVersion(kStreamVersion);
+                quint8 op { 0 };
+                QString key;
+                QByteArray value;
+                rec >> op >> key >> value;
+                if (op == kSet)
+                    data.insert(key, value);
+                else if (op == kRemove)
+                    data.remove(key);
+
+                validSize = in.device()->pos();
+            }
+        });
+        journal.close();
+    }
+
+    if (journal.exists() && journal.size() != validSize)
+        journal.resize(validSize);
+    journalSize = validSize;
+}
+
+bool JournaledStore::appendJournal(const QByteArray &records)
+{
+    if (!journal.isOpen() && !journal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(logDFMBase) << "store: failed to open journal" << journal.fileName() << journal.errorString();
+        return false;
+    }
+
+    if (journal.write(records) != records.size() || !journal.flush()) {
+        qCWarning(logDFMBase) << "store: failed to write journal" << journal.errorString();
+        // cut the torn record, or the records appended after it are dropped with it on loading.
+        journal.close();
+        if (!journal.resize(journalSize))
+            qCWarning(logDFMBase) << "store: failed to truncate journal" << journal.errorString();
+        return false;
+    }
+
+    journalSize += records.size();
+    return true;
+}
+
+/*!
+ * \brief write all values to a new snapshot, replace the old one and empty the journal.
+ */
+bool JournaledStore::compactLocked()
+{
+    QSaveFile file(storePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDFMBase) << "store: failed to write snapshot" << file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(kStreamVersion);
+    out << kStoreMagic << kStoreVersion << data;
+
+    if (!file.commit()) {
+        qCWarning(logDFMBase) << "store: failed to commit snapshot" << file.errorString();
+        return false;
+    }
+
+    snapshotSize = QFileInfo(storePath).size();
+    journal.close();
+    if (journal.exists() && !journal.resize(0))
+        qCWarning(logDFMBase) << "store: failed to truncate journal" << journal.errorString();
+    journalSize = 0;
+    return true;
+}
+
+QByteArray JournaledStore::record(Operation op, const QString &key, const QByteArray &value)
+{
+    QByteArray payload;
+    {
+        QDataStream rec(&payload, QIODevice::WriteOnly);
+        rec.setVersion(kStreamVersion);
+        rec << static_cast<quint8>(op) << key << value;
+    }
+
+    QByteArray ret;
+    QDataStream out(&ret, QIODevice::WriteOnly);
+    out.setVersion(kStreamVersion);
+    out << payload << qChecksum(payload.constData(), static_cast<uint>(payload.size()));
+    return ret;
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef JOURNALEDSTORE_H
+#define JOURNALEDSTORE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QMap>
+#include <QMutex>
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+#include <QStringList>
+
+namespace dfmbase {
+
+/*!
+ * \brief The JournaledStore class is a small binary key-value store for the data
+ * rewritten often, such as the desktop layout.
+ *
+ * The values are kept in a snapshot file and a journal file aside (path + ".journal").
+ * A change is appended to the journal as a checksummed record, a torn record at the
+ * end of the journal is dropped on loading. When the journal grows larger than the
+ * snapshot it is compacted: a new snapshot is written and renamed over the old one,
+ * then the journal is truncated.
+ *
+ * The keys are ordered, so the values under a prefix are read by one range scan.
+ */
+class JournaledStore
+{
+    Q_DISABLE_COPY(JournaledStore)
+
+public:
+    explicit JournaledStore(const QString &path);
+    ~JournaledStore();
+
+    QString path() const;
+    bool isEmpty() const;
+    bool contains(const QString &key) const;
+    QByteArray value(const QString &key, const QByteArray &defaultValue = QByteArray()) const;
+    QMap<QString, QByteArray> values(const QString &prefix) const;
+
+    void setValue(const QString &key, const QByteArray &value);
+    void remove(const QString &key);
+    void update(const QMap<QString, QByteArray> &changed, const QStringList &removed);
+    void clear();
+
+    bool needCompact() const;
+    bool compact();
+
+private:
+    enum Operation : quint8 {
+        kSet = 1,
+        kRemove = 2,
+    };
+
+    void load();
+    bool appendJournal(const QByteArray &records);
+    bool compactLocked();
+    static QByteArray record(Operation op, const QString &key, const QByteArray &value);
+
+private:
+    mutable QMutex mutex;
+    QString storePath;
+    QMap<QString, QByteArray> data;
+    QFile journal;
+    qint64 journalSize { 0 };
+    qint64 snapshotSize { 0 };
+};
+
+}
+
+#endif   // JOURNALEDSTORE_H
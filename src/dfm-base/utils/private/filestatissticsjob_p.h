@@ -7,6 +7,7 @@
 
 #include <dfm-base/utils/filestatisticsjob.h>
 #include <dfm-base/interfaces/abstractdiriterator.h>
+#include <dfm-base/utils/dirsizecache.h>
 
 #include <QObject>
 
@@ -30,6 +31,10 @@ public:
     int countFileCount(const char *name);
     bool checkFileType(const FileInfo::FileType &fileType);
     bool checkInode(const FileInfoPointer info);
+    bool canUseDirSizeCache() const;
+    void collectCachedRoots();
+    bool isInCachedRoot(const QUrl &url) const;
+    bool statisticsByCache(const QUrl &url, const bool followLink);
 
     FileStatisticsJob *q;
     QTimer *notifyDataTimer;
@@ -51,6 +56,9 @@ public:
     QSet<quint64> inodelist;
     AbstractDirIteratorPointer iterator { nullptr };
     std::atomic_bool iteratorCanStop { false };
+    // the selected directories counted by DirSizeCache, and what they have counted
+    QSet<QString> cachedRootPaths;
+    DirSizeCache::Counted cacheCounted;
 };
 }
 #endif // FILESTATISSTICSJOB_P_H
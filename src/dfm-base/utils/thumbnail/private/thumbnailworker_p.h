@@ -21,6 +21,7 @@ class ThumbnailWorkerPrivate
 public:
     explicit ThumbnailWorkerPrivate(ThumbnailWorker *qq);
     QString createThumbnail(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    void markFailedIfUnchanged(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 modifyTime, qint64 fileSize);
     bool checkFileStable(const QUrl &url);
     void startDelayWork();
 
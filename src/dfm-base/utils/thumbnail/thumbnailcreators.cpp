@@ -219,8 +219,7 @@ QImage ThumbnailCreators::djvuThumbnailCreator(const QString &filePath, Thumbnai
     QProcess process;
     QStringList arguments;
     //! 生成缩略图缓存地址
-    const QString &fileUrl = QUrl::fromLocalFile(filePath).toString(QUrl::FullyEncoded);
-    const QString &thumbnailName = ThumbnailHelper::dataToMd5Hex(fileUrl.toLocal8Bit()) + kFormat;
+    const QString &thumbnailName = ThumbnailHelper::thumbnailKey(filePath) + kFormat;
     const QString &saveImage = DFMIO::DFMUtils::buildFilePath(ThumbnailHelper::sizeToFilePath(size).toStdString().c_str(),
                                                               thumbnailName.toStdString().c_str(), nullptr);
     arguments << "--thumbnail"
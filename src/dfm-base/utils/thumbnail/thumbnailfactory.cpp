@@ -12,12 +12,16 @@
 #include <dfm-base/base/device/deviceproxymanager.h>
 
 #include <QGuiApplication>
+#include <QtConcurrent>
 
 using namespace dfmbase;
 DFMGLOBAL_USE_NAMESPACE
 
 static constexpr int kMaxCountLimit { 50 };
 static constexpr int kPushInterval { 100 };   // ms
+static constexpr int kIndexCollectDelay { 30 * 1000 };   // ms
+static constexpr qint64 kIndexCollectInterval { 24 * 60 * 60 };   // s
+static constexpr qint64 kFailedExpire { 7 * 24 * 60 * 60 };   // s
 
 ThumbnailFactory::ThumbnailFactory(QObject *parent)
     : QObject(parent),
@@ -58,6 +62,20 @@ void ThumbnailFactory::init()
 
     worker->moveToThread(thread.data());
     thread->start();
+
+    // drop the orphaned entries of the thumbnail index once the startup is done
+    QTimer::singleShot(kIndexCollectDelay, this, [] {
+        QtConcurrent::run([] {
+            const QMap<ThumbnailSize, QString> dirs {
+                { kSmall, ThumbnailHelper::sizeToFilePath(kSmall) },
+                { kNormal, ThumbnailHelper::sizeToFilePath(kNormal) },
+                { kLarge, ThumbnailHelper::sizeToFilePath(kLarge) }
+            };
+            int removed = ThumbnailIndex::instance()->collectGarbage(dirs, kFailedExpire, kIndexCollectInterval);
+            if (removed > 0)
+                qCInfo(logDFMBase) << "thumbnail: removed" << removed << "orphaned index entries";
+        });
+    });
 }
 
 void ThumbnailFactory::joinThumbnailJob(const QUrl &url, ThumbnailSize size)
@@ -20,8 +20,6 @@
 
 #include <sys/stat.h>
 
-#include <sys/stat.h>
-
 static constexpr qint64 kDefaultSizeLimit = 1024 * 1024 * 20;   // 20MB
 static constexpr char kFormat[] { ".png" };
 
@@ -131,21 +129,24 @@ QString ThumbnailHelper::saveThumbnail(const QUrl &url, const QImage &img, Thumb
         return "";
 
     const QString &fileUrl = url.toString(QUrl::FullyEncoded);
-    const QString &thumbnailName = ThumbnailHelper::dataToMd5Hex(fileUrl.toLocal8Bit()) + kFormat;
+    const QByteArray &md5 = thumbnailKey(info->pathOf(PathInfoType::kFilePath));
+    const QString &thumbnailName = md5 + kFormat;
     const QString &thumbnailPath = ThumbnailHelper::sizeToFilePath(size);
     const QString &thumbnailFilePath = DFMIO::DFMUtils::buildFilePath(thumbnailPath.toStdString().c_str(), thumbnailName.toStdString().c_str(), nullptr);
     const qint64 fileModify = info->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
 
     makePath(thumbnailPath);
 
-    QMetaObject::invokeMethod(QCoreApplication::instance(), [img, thumbnailFilePath, fileUrl, fileModify]() {
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [img, thumbnailFilePath, fileUrl, fileModify, md5, size]() {
         Q_ASSERT(QThread::currentThread() == qApp->thread());
         QImage tmpImg = img;
         tmpImg.setText(QT_STRINGIFY(Thumb::URL), fileUrl);
         tmpImg.setText(QT_STRINGIFY(Thumb::MTime), QString::number(fileModify));
         if (!tmpImg.save(thumbnailFilePath, Q_NULLPTR, 50)) {
             qCWarning(logDFMBase) << "thumbnail: save failed." << fileUrl;
+            return;
         }
+        ThumbnailIndex::instance()->markFresh(md5, size, fileModify);
     },
                               Qt::QueuedConnection);
 
@@ -169,14 +170,18 @@ QImage ThumbnailHelper::thumbnailImage(const QUrl &fileUrl, ThumbnailSize size)
         return img;
     }
 
-    const QString thumbnailName = dataToMd5Hex((QUrl::fromLocalFile(filePath).toString(QUrl::FullyEncoded)).toLocal8Bit()) + kFormat;
+    const QByteArray &md5 = thumbnailKey(filePath);
+    const QString thumbnailName = md5 + kFormat;
     QString thumbnail = DFMIO::DFMUtils::buildFilePath(sizeToFilePath(size).toStdString().c_str(), thumbnailName.toStdString().c_str(), nullptr);
-    if (!DFMIO::DFile(thumbnail).exists())
+    if (!DFMIO::DFile(thumbnail).exists()) {
+        ThumbnailIndex::instance()->remove(md5, size);
         return {};
+    }
 
     QImageReader ir(thumbnail, QByteArray(kFormat).mid(1));
     if (!ir.canRead()) {
         LocalFileHandler().deleteFileRecursive(QUrl::fromLocalFile(thumbnail));
+        ThumbnailIndex::instance()->remove(md5, size);
         return {};
     }
     ir.setAutoDetectImageFormat(false);
@@ -185,13 +190,65 @@ QImage ThumbnailHelper::thumbnailImage(const QUrl &fileUrl, ThumbnailSize size)
     const qint64 fileModify = fileInfo->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
     if (!image.isNull() && image.text(QT_STRINGIFY(Thumb::MTime)).toInt() != static_cast<int>(fileModify)) {
         LocalFileHandler().deleteFileRecursive(QUrl::fromLocalFile(thumbnail));
+        ThumbnailIndex::instance()->remove(md5, size);
         return {};
     }
 
+    // thumbnails written before the index, or by other programs
+    if (!image.isNull())
+        ThumbnailIndex::instance()->markFresh(md5, size, fileModify);
+
     image.setText(QT_STRINGIFY(Thumb::Path), thumbnail);
     return image;
 }
 
+/*!
+ * \brief look up the thumbnail of the file in the thumbnail index, no png is opened.
+ * \param thumbnailPath the path of the thumbnail if it is fresh
+ */
+ThumbnailIndex::State ThumbnailHelper::thumbnailState(const QUrl &fileUrl, ThumbnailSize size, QString *thumbnailPath)
+{
+    FileInfoPointer fileInfo = InfoFactory::create<FileInfo>(fileUrl);
+    if (!fileInfo)
+        return ThumbnailIndex::kNeedGenerate;
+
+    const QString &filePath = fileInfo->pathOf(PathInfoType::kFilePath);
+    if (filePath.isEmpty())
+        return ThumbnailIndex::kNeedGenerate;
+
+    const QByteArray &md5 = thumbnailKey(filePath);
+    const qint64 fileModify = fileInfo->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
+    const auto state = ThumbnailIndex::instance()->state(md5, size, fileModify);
+    if (state != ThumbnailIndex::kFresh)
+        return state;
+
+    // the png may be removed by others, such as cleaning the cache directory
+    const QString thumbnailName = md5 + kFormat;
+    const QString &thumbnail = DFMIO::DFMUtils::buildFilePath(sizeToFilePath(size).toStdString().c_str(), thumbnailName.toStdString().c_str(), nullptr);
+    if (!DFMIO::DFile(thumbnail).exists()) {
+        ThumbnailIndex::instance()->remove(md5, size);
+        return ThumbnailIndex::kNeedGenerate;
+    }
+
+    if (thumbnailPath)
+        *thumbnailPath = thumbnail;
+    return state;
+}
+
+/*!
+ * \brief record the failure in the thumbnail index, the file is not tried again until it is modified.
+ * \param modifyTime the mtime of the file the generation failed on
+ */
+void ThumbnailHelper::markThumbnailFailed(const QUrl &url, ThumbnailSize size, qint64 modifyTime)
+{
+    auto info = InfoFactory::create<FileInfo>(url);
+    if (!info)
+        return;
+
+    const QByteArray &md5 = thumbnailKey(info->pathOf(PathInfoType::kFilePath));
+    ThumbnailIndex::instance()->markFailed(md5, size, modifyTime);
+}
+
 void ThumbnailHelper::setSizeLimit(const QMimeType &mime, qint64 size)
 {
     if (mime.isValid() && !sizeLimitHash.contains(mime))
@@ -222,6 +279,14 @@ QByteArray ThumbnailHelper::dataToMd5Hex(const QByteArray &data)
     return QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
 }
 
+/*!
+ * \brief the md5 of the local url of the file, it names the thumbnail png and keys the thumbnail index.
+ */
+QByteArray ThumbnailHelper::thumbnailKey(const QString &filePath)
+{
+    return dataToMd5Hex(QUrl::fromLocalFile(filePath).toString(QUrl::FullyEncoded).toLocal8Bit());
+}
+
 bool ThumbnailHelper::checkThumbEnable(const QUrl &url)
 {
     QUrl fileUrl { url };
@@ -9,6 +9,7 @@
 #include <dfm-base/dfm_global_defines.h>
 
 #include <dfm-base/mimetype/dmimedatabase.h>
+#include <dfm-base/utils/thumbnail/thumbnailindex.h>
 
 #include <QUrl>
 #include <QMimeType>
@@ -29,10 +30,13 @@ public:
 
     QString saveThumbnail(const QUrl &url, const QImage &img, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
     static QImage thumbnailImage(const QUrl &fileUrl, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    static ThumbnailIndex::State thumbnailState(const QUrl &fileUrl, DFMGLOBAL_NAMESPACE::ThumbnailSize size, QString *thumbnailPath = nullptr);
+    static void markThumbnailFailed(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 modifyTime);
 
     static const QStringList &defaultThumbnailDirs();
     static QString sizeToFilePath(DFMGLOBAL_NAMESPACE::ThumbnailSize size);
     static QByteArray dataToMd5Hex(const QByteArray &data);
+    static QByteArray thumbnailKey(const QString &filePath);
 
 private:
     bool checkMimeTypeSupport(const QMimeType &mime);
@@ -0,0 +1,364 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "thumbnailindex.h"
+
+#include <dfm-base/base/standardpaths.h>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDebug>
+
+#include <atomic>
+#include <cstring>
+
+#include <sys/file.h>
+
+using namespace dfmbase;
+DFMGLOBAL_USE_NAMESPACE
+
+static constexpr quint32 kIndexMagic { 0x44464d54 };   // "DFMT"
+static constexpr quint32 kIndexVersion { 1 };
+static constexpr quint32 kDefaultCapacity { 1 << 16 };
+static constexpr quint32 kMaxProbe { 8 };
+static constexpr int kKeySize { 16 };
+
+struct ThumbnailIndex::Header
+{
+    quint32 magic;
+    quint32 version;
+    quint32 capacity;
+    quint32 reserved;
+    qint64 lastCollect;
+    qint64 reserved2;
+};
+
+// the entries are written under a sequence lock, an odd seq means the entry is being written.
+struct ThumbnailIndex::Entry
+{
+    std::atomic<quint32> seq;
+    quint8 sizeClass;
+    quint8 state;
+    quint16 reserved;
+    uchar key[kKeySize];
+    qint64 modifyTime;
+    qint64 updateTime;
+};
+
+static_assert(std::atomic<quint32>::is_always_lock_free, "the index is shared by processes");
+static_assert(sizeof(quint32) == sizeof(std::atomic<quint32>), "unexpected atomic layout");
+
+namespace {
+
+struct EntryData
+{
+    quint8 sizeClass { 0 };
+    quint8 state { 0 };
+    uchar key[kKeySize] {};
+    qint64 modifyTime { 0 };
+    qint64 updateTime { 0 };
+};
+
+quint8 sizeClassOf(ThumbnailSize size)
+{
+    switch (size) {
+    case ThumbnailSize::kSmall:
+        return 1;
+    case ThumbnailSize::kNormal:
+        return 2;
+    case ThumbnailSize::kLarge:
+        return 3;
+    }
+    return 0;
+}
+
+QByteArray keyOf(const QByteArray &md5Hex)
+{
+    const QByteArray &key = QByteArray::fromHex(md5Hex);
+    return key.size() == kKeySize ? key : QByteArray();
+}
+
+}   // namespace
+
+// a consistent copy of the entry, or false if it is changed by a writer meanwhile
+template<typename E>
+static bool readEntry(const E *entry, EntryData *data, quint32 *seq = nullptr)
+{
+    const quint32 before = entry->seq.load(std::memory_order_acquire);
+    if (before & 1)
+        return false;
+
+    data->sizeClass = entry->sizeClass;
+    data->state = entry->state;
+    std::memcpy(data->key, entry->key, kKeySize);
+    data->modifyTime = entry->modifyTime;
+    data->updateTime = entry->updateTime;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (entry->seq.load(std::memory_order_relaxed) != before)
+        return false;
+
+    if (seq)
+        *seq = before;
+    return true;
+}
+
+template<typename E>
+static void writeEntry(E *entry, const EntryData &data)
+{
+    const quint32 seq = entry->seq.load(std::memory_order_relaxed);
+    entry->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    entry->sizeClass = data.sizeClass;
+    entry->state = data.state;
+    std::memcpy(entry->key, data.key, kKeySize);
+    entry->modifyTime = data.modifyTime;
+    entry->updateTime = data.updateTime;
+
+    entry->seq.store(seq + 2, std::memory_order_release);
+}
+
+ThumbnailIndex *ThumbnailIndex::instance()
+{
+    static ThumbnailIndex ins(StandardPaths::location(StandardPaths::kCachePath) + "/thumbnail.index");
+    return &ins;
+}
+
+ThumbnailIndex::ThumbnailIndex(const QString &indexFile, quint32 capacity)
+    : indexFile(indexFile),
+      capacity(capacity > 0 ? capacity : kDefaultCapacity),
+      file(indexFile)
+{
+    QDir().mkpath(QFileInfo(indexFile).absolutePath());
+    if (!file.open(QIODevice::ReadWrite)) {
+        qCWarning(logDFMBase) << "thumbnail: failed to open index:" << file.errorString();
+        return;
+    }
+
+    if (!lockFile()) {
+        file.close();
+        return;
+    }
+
+    // adopt the capacity of a valid index created by another process
+    Header header {};
+    if (file.size() >= static_cast<qint64>(sizeof(Header))) {
+        file.read(reinterpret_cast<char *>(&header), sizeof(Header));
+        if (header.magic == kIndexMagic && header.version == kIndexVersion && header.capacity > 0
+            && file.size() >= static_cast<qint64>(sizeof(Header) + header.capacity * sizeof(Entry)))
+            this->capacity = header.capacity;
+        else
+            header = {};
+    }
+
+    const qint64 fileSize = static_cast<qint64>(sizeof(Header) + this->capacity * sizeof(Entry));
+    // never shrink the file, the other processes mapping it would crash
+    if (file.size() < fileSize) {
+        if (!file.resize(fileSize)) {
+            qCWarning(logDFMBase) << "thumbnail: failed to create index:" << file.errorString();
+            unlockFile();
+            file.close();
+            return;
+        }
+    }
+
+    mem = file.map(0, fileSize);
+    if (!mem) {
+        qCWarning(logDFMBase) << "thumbnail: failed to map index:" << file.errorString();
+    } else if (header.magic != kIndexMagic) {
+        Header *h = reinterpret_cast<Header *>(mem);
+        h->magic = 0;
+        std::memset(mem + sizeof(Header), 0, static_cast<size_t>(fileSize) - sizeof(Header));
+        h->version = kIndexVersion;
+        h->capacity = this->capacity;
+        h->lastCollect = QDateTime::currentSecsSinceEpoch();
+        std::atomic_thread_fence(std::memory_order_release);
+        h->magic = kIndexMagic;
+    }
+
+    unlockFile();
+}
+
+ThumbnailIndex::~ThumbnailIndex()
+{
+    if (mem)
+        file.unmap(mem);
+}
+
+/*!
+ * \brief the state of the thumbnail of the file at \a modifyTime,
+ * a thumbnail generated for another mtime needs to be generated again.
+ */
+ThumbnailIndex::State ThumbnailIndex::state(const QByteArray &md5Hex, ThumbnailSize size, qint64 modifyTime)
+{
+    const QByteArray &key = keyOf(md5Hex);
+    const quint8 sizeClass = sizeClassOf(size);
+    if (!mem || key.isEmpty() || sizeClass == 0)
+        return kNeedGenerate;
+
+    const quint32 first = firstSlot(key, sizeClass);
+    for (quint32 i = 0; i < kMaxProbe; ++i) {
+        EntryData data;
+        if (!readEntry(slotAt((first + i) % capacity), &data))
+            continue;
+
+        if (data.state == kNeedGenerate || data.sizeClass != sizeClass
+            || std::memcmp(data.key, key.constData(), kKeySize) != 0)
+            continue;
+
+        return data.modifyTime == modifyTime ? static_cast<State>(data.state) : kNeedGenerate;
+    }
+
+    return kNeedGenerate;
+}
+
+void ThumbnailIndex::markFresh(const QByteArray &md5Hex, ThumbnailSize size, qint64 modifyTime)
+{
+    write(md5Hex, size, modifyTime, kFresh);
+}
+
+void ThumbnailIndex::markFailed(const QByteArray &md5Hex, ThumbnailSize size, qint64 modifyTime)
+{
+    write(md5Hex, size, modifyTime, kFailed);
+}
+
+void ThumbnailIndex::remove(const QByteArray &md5Hex, ThumbnailSize size)
+{
+    write(md5Hex, size, 0, kNeedGenerate);
+}
+
+/*!
+ * \brief drop the entries whose thumbnail is deleted, and the failures older than \a failedExpire seconds.
+ * \param interval skip it if the index is collected by any process in the last \a interval seconds
+ * \return the count of the removed entries
+ */
+int ThumbnailIndex::collectGarbage(const QMap<ThumbnailSize, QString> &thumbnailDirs, qint64 failedExpire, qint64 interval)
+{
+    if (!mem)
+        return 0;
+
+    Header *header = reinterpret_cast<Header *>(mem);
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    if (interval > 0 && now - header->lastCollect < interval)
+        return 0;
+
+    QMap<quint8, QString> dirs;
+    for (auto iter = thumbnailDirs.cbegin(); iter != thumbnailDirs.cend(); ++iter)
+        dirs.insert(sizeClassOf(iter.key()), iter.value());
+
+    // look up the files without locking, the writers are not blocked by the disk
+    QList<QPair<quint32, quint32>> orphans;
+    for (quint32 i = 0; i < capacity; ++i) {
+        EntryData data;
+        quint32 seq { 0 };
+        if (!readEntry(slotAt(i), &data, &seq) || data.state == kNeedGenerate)
+            continue;
+
+        bool orphan = false;
+        if (data.state == kFailed) {
+            orphan = now - data.updateTime > failedExpire;
+        } else if (dirs.contains(data.sizeClass)) {
+            const QByteArray &name = QByteArray(reinterpret_cast<const char *>(data.key), kKeySize).toHex();
+            orphan = !QFileInfo::exists(dirs.value(data.sizeClass) + "/" + QString::fromLatin1(name) + ".png");
+        }
+
+        if (orphan)
+            orphans.append({ i, seq });
+    }
+
+    QMutexLocker lk(&mutex);
+    if (!lockFile())
+        return 0;
+
+    int removed = 0;
+    for (const auto &orphan : orphans) {
+        Entry *entry = slotAt(orphan.first);
+        // rewritten after it is checked
+        if (entry->seq.load(std::memory_order_relaxed) != orphan.second)
+            continue;
+        writeEntry(entry, EntryData());
+        ++removed;
+    }
+    header->lastCollect = now;
+
+    unlockFile();
+    return removed;
+}
+
+ThumbnailIndex::Entry *ThumbnailIndex::slotAt(quint32 index) const
+{
+    return reinterpret_cast<Entry *>(mem + sizeof(Header)) + index;
+}
+
+quint32 ThumbnailIndex::firstSlot(const QByteArray &key, quint8 sizeClass) const
+{
+    // md5 is uniformly distributed already
+    quint32 hash { 0 };
+    std::memcpy(&hash, key.constData(), sizeof(hash));
+    return (hash + sizeClass * 0x9e3779b9u) % capacity;
+}
+
+void ThumbnailIndex::write(const QByteArray &md5Hex, ThumbnailSize size, qint64 modifyTime, State state)
+{
+    const QByteArray &key = keyOf(md5Hex);
+    const quint8 sizeClass = sizeClassOf(size);
+    if (!mem || key.isEmpty() || sizeClass == 0)
+        return;
+
+    QMutexLocker lk(&mutex);
+    if (!lockFile())
+        return;
+
+    const quint32 first = firstSlot(key, sizeClass);
+    Entry *target { nullptr };
+    Entry *empty { nullptr };
+    for (quint32 i = 0; i < kMaxProbe; ++i) {
+        Entry *entry = slotAt((first + i) % capacity);
+        if (entry->state == kNeedGenerate) {
+            if (!empty)
+                empty = entry;
+            continue;
+        }
+
+        if (entry->sizeClass == sizeClass && std::memcmp(entry->key, key.constData(), kKeySize) == 0) {
+            target = entry;
+            break;
+        }
+    }
+
+    if (!target && state != kNeedGenerate) {
+        // evict a pseudo random entry of a full probe window
+        target = empty ? empty : slotAt((first + static_cast<uchar>(key.at(kKeySize - 1)) % kMaxProbe) % capacity);
+    }
+
+    if (target) {
+        EntryData data;
+        if (state != kNeedGenerate) {
+            data.sizeClass = sizeClass;
+            data.state = state;
+            std::memcpy(data.key, key.constData(), kKeySize);
+            data.modifyTime = modifyTime;
+            data.updateTime = QDateTime::currentSecsSinceEpoch();
+        }
+        writeEntry(target, data);
+    }
+
+    unlockFile();
+}
+
+bool ThumbnailIndex::lockFile()
+{
+    if (::flock(file.handle(), LOCK_EX) != 0) {
+        qCWarning(logDFMBase) << "thumbnail: failed to lock index:" << indexFile;
+        return false;
+    }
+    return true;
+}
+
+void ThumbnailIndex::unlockFile()
+{
+    ::flock(file.handle(), LOCK_UN);
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef THUMBNAILINDEX_H
+#define THUMBNAILINDEX_H
+
+#include <dfm-base/dfm_base_global.h>
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QFile>
+#include <QMap>
+#include <QMutex>
+
+namespace dfmbase {
+
+/*!
+ * \brief The ThumbnailIndex class is a small index of the generated thumbnails,
+ * shared by every file manager process through a mapped file.
+ *
+ * Each entry is keyed by the md5 of the file url (the name of the thumbnail png)
+ * and the thumbnail size, and records the mtime of the source file the thumbnail
+ * was generated for and whether the generation succeeded or failed. So the state
+ * of a thumbnail is known without opening the png.
+ *
+ * Lookups read the mapped memory without locking, writers lock the index file.
+ */
+class ThumbnailIndex
+{
+    Q_DISABLE_COPY(ThumbnailIndex)
+
+public:
+    enum State : quint8 {
+        kNeedGenerate = 0,
+        kFresh,
+        kFailed
+    };
+
+    static ThumbnailIndex *instance();
+    explicit ThumbnailIndex(const QString &indexFile, quint32 capacity = 0);
+    ~ThumbnailIndex();
+
+    State state(const QByteArray &md5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 modifyTime);
+    void markFresh(const QByteArray &md5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 modifyTime);
+    void markFailed(const QByteArray &md5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 modifyTime);
+    void remove(const QByteArray &md5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+
+    int collectGarbage(const QMap<DFMGLOBAL_NAMESPACE::ThumbnailSize, QString> &thumbnailDirs,
+                       qint64 failedExpire, qint64 interval = 0);
+
+private:
+    struct Header;
+    struct Entry;
+
+    Entry *slotAt(quint32 index) const;
+    quint32 firstSlot(const QByteArray &key, quint8 sizeClass) const;
+    void write(const QByteArray &md5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 modifyTime, State state);
+    bool lockFile();
+    void unlockFile();
+
+private:
+    QString indexFile;
+    quint32 capacity { 0 };
+    QMutex mutex;
+    QFile file;
+    uchar *mem { nullptr };
+};
+
+}
+
+#endif   // THUMBNAILINDEX_H
@@ -9,9 +9,11 @@
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/base/urlroute.h>
+#include <dfm-base/utils/tracer.h>
 
 #include <QtConcurrent>
 #include <QPainter>
+#include <QFileInfo>
 #include <QDebug>
 
 using namespace dfmbase;
@@ -24,6 +26,7 @@ ThumbnailWorkerPrivate::ThumbnailWorkerPrivate(ThumbnailWorker *qq)
 
 QString ThumbnailWorkerPrivate::createThumbnail(const QUrl &url, Global::ThumbnailSize size)
 {
+    dfmTraceSpan("thumbnail", "ThumbnailWorker::createThumbnail");
     auto info = InfoFactory::create<FileInfo>(url);
     if (!info)
         return "";
@@ -38,6 +41,11 @@ QString ThumbnailWorkerPrivate::createThumbnail(const QUrl &url, Global::Thumbna
     if (thumbHelper.defaultThumbnailDirs().contains(info->pathOf(PathInfoType::kAbsolutePath)))
         return absoluteFilePath;
 
+    // the file is checked again if it fails, see markFailedIfUnchanged
+    const QFileInfo before(absoluteFilePath);
+    const qint64 modifyTime = before.lastModified().toSecsSinceEpoch();
+    const qint64 fileSize = before.size();
+
     QImage img;
     const auto &mime = mimeDb.mimeTypeForUrl(url);
     const auto &mimeName = mime.name();
@@ -60,6 +68,7 @@ QString ThumbnailWorkerPrivate::createThumbnail(const QUrl &url, Global::Thumbna
 
     if (img.isNull()) {
         qCWarning(logDFMBase) << "thumbnail: cannot generate thumbnail for file: " << url;
+        markFailedIfUnchanged(url, size, modifyTime, fileSize);
         return "";
     }
 
@@ -69,6 +78,24 @@ QString ThumbnailWorkerPrivate::createThumbnail(const QUrl &url, Global::Thumbna
     return thumbHelper.saveThumbnail(url, img, size);
 }
 
+/*!
+ * \brief remember the failure only if the decoders failed on a complete file. The file which
+ * is unreadable, or written or replaced during the generation, is tried again at the next request.
+ */
+void ThumbnailWorkerPrivate::markFailedIfUnchanged(const QUrl &url, Global::ThumbnailSize size, qint64 modifyTime, qint64 fileSize)
+{
+    const auto &info = InfoFactory::create<FileInfo>(url);
+    if (!info)
+        return;
+
+    const QFileInfo after(info->pathOf(PathInfoType::kAbsoluteFilePath));
+    if (!after.exists() || !after.isReadable() || after.size() != fileSize
+        || after.lastModified().toSecsSinceEpoch() != modifyTime || !checkFileStable(url))
+        return;
+
+    ThumbnailHelper::markThumbnailFailed(url, size, modifyTime);
+}
+
 bool ThumbnailWorkerPrivate::checkFileStable(const QUrl &url)
 {
     const auto &info = InfoFactory::create<FileInfo>(url);
@@ -171,6 +198,17 @@ void ThumbnailWorker::onTaskAdded(const ThumbnailTaskMap &taskMap)
         if (!d->thumbHelper.checkThumbEnable(fileUrl))
             continue;
 
+        QString thumbnail;
+        const auto state = ThumbnailHelper::thumbnailState(fileUrl, iter.value(), &thumbnail);
+        if (state == ThumbnailIndex::kFresh) {
+            Q_EMIT thumbnailCreateFinished(iter.key(), thumbnail);
+            continue;
+        }
+        if (state == ThumbnailIndex::kFailed) {
+            Q_EMIT thumbnailCreateFailed(iter.key());
+            continue;
+        }
+
         const auto &img = d->thumbHelper.thumbnailImage(fileUrl, iter.value());
         if (!img.isNull()) {
             Q_EMIT thumbnailCreateFinished(iter.key(), img.text(QT_STRINGIFY(Thumb::Path)));
@@ -0,0 +1,264 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "tracer.h"
+
+#include <dfm-base/base/standardpaths.h>
+
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QDateTime>
+#include <QMutex>
+#include <QList>
+#include <QFile>
+#include <QDir>
+
+#include <chrono>
+
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+
+using namespace dfmbase;
+
+static constexpr int kEventsPerThread { 1 << 13 };
+
+std::atomic_bool Tracer::enabled { false };
+
+namespace {
+
+struct TraceEvent
+{
+    const char *category;
+    const char *name;
+    qint64 timestamp;   // ns
+    qint64 value;   // the duration of a span, the value of a counter
+    qint64 tid;
+    char phase;
+};
+
+// written by its thread only, read by the dump
+struct ThreadBuffer
+{
+    TraceEvent events[kEventsPerThread];
+    std::atomic<quint64> count { 0 };
+};
+
+struct Registry
+{
+    QMutex mutex;
+    QList<ThreadBuffer *> buffers;
+    QList<ThreadBuffer *> freeBuffers;
+};
+
+Registry &registry()
+{
+    // never destroyed, the thread local slots return their buffers at the thread exit
+    static Registry *ins = new Registry;
+    return *ins;
+}
+
+// the buffer of an exited thread is reused by a new thread, the events keep their tid
+struct ThreadSlot
+{
+    ThreadBuffer *buffer { nullptr };
+    qint64 tid { 0 };
+
+    ~ThreadSlot()
+    {
+        if (!buffer)
+            return;
+        QMutexLocker lk(&registry().mutex);
+        registry().freeBuffers.append(buffer);
+    }
+};
+
+thread_local ThreadSlot threadSlot;
+
+ThreadSlot &currentSlot()
+{
+    if (!threadSlot.buffer) {
+        threadSlot.tid = static_cast<qint64>(::syscall(SYS_gettid));
+
+        Registry &reg = registry();
+        QMutexLocker lk(&reg.mutex);
+        if (!reg.freeBuffers.isEmpty()) {
+            threadSlot.buffer = reg.freeBuffers.takeLast();
+        } else {
+            threadSlot.buffer = new ThreadBuffer;
+            reg.buffers.append(threadSlot.buffer);
+        }
+    }
+    return threadSlot;
+}
+
+void record(char phase, const char *category, const char *name, qint64 timestamp, qint64 value)
+{
+    ThreadSlot &slot = currentSlot();
+    ThreadBuffer *buffer = slot.buffer;
+    const quint64 index = buffer->count.load(std::memory_order_relaxed);
+    TraceEvent &event = buffer->events[index % kEventsPerThread];
+    event.category = category;
+    event.name = name;
+    event.timestamp = timestamp;
+    event.value = value;
+    event.tid = slot.tid;
+    event.phase = phase;
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+int signalFds[2] { -1, -1 };
+
+void handleSignal(int)
+{
+    const char ch = 1;
+    ssize_t ret = ::write(signalFds[0], &ch, sizeof(ch));
+    Q_UNUSED(ret)
+}
+
+}   // namespace
+
+void Tracer::setEnabled(bool enable)
+{
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+/*!
+ * \brief enable tracing by DFM_TRACE, and toggle/dump it by SIGUSR2.
+ * It must be called in the main thread after the application is created.
+ */
+void Tracer::initialize()
+{
+    if (qEnvironmentVariableIntValue("DFM_TRACE") > 0)
+        setEnabled(true);
+
+    if (signalFds[0] >= 0 || !qApp)
+        return;
+
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalFds) != 0) {
+        qCWarning(logDFMBase) << "trace: failed to create the signal socket";
+        return;
+    }
+
+    auto notifier = new QSocketNotifier(signalFds[1], QSocketNotifier::Read, qApp);
+    QObject::connect(notifier, &QSocketNotifier::activated, qApp, []() {
+        char ch = 0;
+        ssize_t ret = ::read(signalFds[1], &ch, sizeof(ch));
+        Q_UNUSED(ret)
+
+        if (!isEnabled()) {
+            setEnabled(true);
+            qCInfo(logDFMBase) << "trace: enabled, send SIGUSR2 again to dump it";
+            return;
+        }
+
+        const QString &path = dump();
+        if (!path.isEmpty())
+            qCInfo(logDFMBase) << "trace: dumped to" << path;
+    });
+
+    struct sigaction action {};
+    action.sa_handler = handleSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    ::sigaction(SIGUSR2, &action, nullptr);
+}
+
+/*!
+ * \brief the monotonic time in nanoseconds
+ */
+qint64 Tracer::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+
+void Tracer::complete(const char *category, const char *name, qint64 begin, qint64 end)
+{
+    record('X', category, name, begin, end - begin);
+}
+
+void Tracer::counter(const char *category, const char *name, qint64 value)
+{
+    record('C', category, name, now(), value);
+}
+
+/*!
+ * \brief the recorded events in the Chrome trace event format.
+ * The threads keep recording meanwhile, an event being overwritten may come out torn.
+ */
+QByteArray Tracer::toChromeTrace()
+{
+    const QByteArray &pid = QByteArray::number(QCoreApplication::applicationPid());
+    auto micro = [](qint64 ns) {
+        return QByteArray::number(static_cast<double>(ns) / 1000.0, 'f', 3);
+    };
+
+    QByteArray json("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+
+    Registry &reg = registry();
+    QMutexLocker lk(&reg.mutex);
+    for (ThreadBuffer *buffer : reg.buffers) {
+        const quint64 count = buffer->count.load(std::memory_order_acquire);
+        const quint64 begin = count > kEventsPerThread ? count - kEventsPerThread : 0;
+        for (quint64 i = begin; i < count; ++i) {
+            const TraceEvent event = buffer->events[i % kEventsPerThread];
+            if (!event.name)
+                continue;
+
+            json.append(first ? "{" : ",{");
+            first = false;
+            json.append("\"name\":\"").append(event.name).append("\",");
+            json.append("\"cat\":\"").append(event.category ? event.category : "").append("\",");
+            json.append("\"ph\":\"").append(event.phase).append("\",");
+            json.append("\"ts\":").append(micro(event.timestamp)).append(',');
+            if (event.phase == 'X')
+                json.append("\"dur\":").append(micro(event.value)).append(',');
+            else
+                json.append("\"args\":{\"value\":").append(QByteArray::number(event.value)).append("},");
+            json.append("\"pid\":").append(pid).append(',');
+            json.append("\"tid\":").append(QByteArray::number(event.tid)).append('}');
+        }
+    }
+
+    json.append("]}");
+    return json;
+}
+
+/*!
+ * \brief write the trace to \a filePath, or to a new file in the cache directory
+ * \return the path of the trace file, empty if it fails
+ */
+QString Tracer::dump(const QString &filePath)
+{
+    QString path = filePath;
+    if (path.isEmpty()) {
+        const QString &dir = StandardPaths::location(StandardPaths::kCachePath);
+        QDir().mkpath(dir);
+        path = QString("%1/trace-%2-%3.json")
+                       .arg(dir)
+                       .arg(QCoreApplication::applicationPid())
+                       .arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"));
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(logDFMBase) << "trace: failed to dump:" << file.errorString();
+        return QString();
+    }
+
+    file.write(toChromeTrace());
+    return path;
+}
+
+void Tracer::clear()
+{
+    Registry &reg = registry();
+    QMutexLocker lk(&reg.mutex);
+    for (ThreadBuffer *buffer : reg.buffers)
+        buffer->count.store(0, std::memory_order_release);
+}
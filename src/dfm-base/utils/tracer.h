@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QString>
+#include <QByteArray>
+
+#include <atomic>
+
+namespace dfmbase {
+
+/*!
+ * \brief The Tracer class records the timing spans and counters of the hot paths,
+ * and dumps them in the Chrome trace format (chrome://tracing, ui.perfetto.dev).
+ *
+ * Every thread records into its own ring buffer without locking, the oldest events
+ * of a thread are overwritten. When tracing is disabled a span costs an atomic load.
+ *
+ * Tracing is enabled by the environment variable DFM_TRACE=1, or by sending SIGUSR2
+ * to the process; a SIGUSR2 to a tracing process dumps the trace into the cache directory.
+ *
+ * The categories and the names must be string literals, only the pointers are recorded.
+ */
+class Tracer
+{
+public:
+    static inline bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enable);
+    static void initialize();
+
+    static qint64 now();
+    static void complete(const char *category, const char *name, qint64 begin, qint64 end);
+    static void counter(const char *category, const char *name, qint64 value);
+
+    static QByteArray toChromeTrace();
+    static QString dump(const QString &filePath = QString());
+    static void clear();
+
+private:
+    static std::atomic_bool enabled;
+};
+
+class TraceSpan
+{
+    Q_DISABLE_COPY(TraceSpan)
+
+public:
+    inline TraceSpan(const char *category, const char *name)
+        : category(category),
+          name(Tracer::isEnabled() ? name : nullptr),
+          begin(this->name ? Tracer::now() : 0)
+    {
+    }
+
+    inline ~TraceSpan()
+    {
+        if (name)
+            Tracer::complete(category, name, begin, Tracer::now());
+    }
+
+private:
+    const char *category { nullptr };
+    const char *name { nullptr };
+    qint64 begin { 0 };
+};
+
+}
+
+#define DFM_TRACE_CONCAT_IMPL(a, b) a##b
+#define DFM_TRACE_CONCAT(a, b) DFM_TRACE_CONCAT_IMPL(a, b)
+
+// trace the rest of the current scope
+#define dfmTraceSpan(category, name) \
+    DFMBASE_NAMESPACE::TraceSpan DFM_TRACE_CONCAT(traceSpan_, __LINE__)(category, name)
+
+#define dfmTraceCounter(category, name, value)                             \
+    do {                                                                   \
+        if (DFMBASE_NAMESPACE::Tracer::isEnabled())                        \
+            DFMBASE_NAMESPACE::Tracer::counter(category, name, value);     \
+    } while (false)
+
+#endif   // TRACER_H
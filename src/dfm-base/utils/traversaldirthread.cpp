@@ -4,6 +4,7 @@
 
 #include "traversaldirthread.h"
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/utils/tracer.h>
 
 #include <QElapsedTimer>
 #include <QDebug>
@@ -79,6 +80,7 @@ void TraversalDirThread::run()
     if (dirIterator.isNull())
         return;
 
+    dfmTraceSpan("dir", "TraversalDirThread::run");
     QElapsedTimer timer;
     timer.start();
 
@@ -102,6 +104,7 @@ void TraversalDirThread::run()
         childrenList.append(fileUrl);
     }
     stopFlag = true;
+    dfmTraceCounter("dir", "traversal children", childrenList.size());
     emit updateChildren(childrenList);
 
     qCInfo(logDFMBase) << "dir query end, file count: " << childrenList.size() << " url: " << dirUrl << " elapsed: " << timer.elapsed();
@@ -6,16 +6,61 @@
 
 #include <QDir>
 #include <QFileInfo>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+
+#include <iostream>
+
+#include <zlib.h>
 
 DCORE_USE_NAMESPACE
 DPF_USE_NAMESPACE
 
+static constexpr int kRingCapacity { 8192 };
+static constexpr int kMaxBatchRecords { 512 };
+static constexpr unsigned long kFlushInterval { 200 };   // ms
+static constexpr qint64 kFatalWaitTime { 1000 };   // ms
+static constexpr char kCompressedSuffix[] { ".gz" };
+static constexpr int kCompressedSuffixLength { sizeof(kCompressedSuffix) - 1 };
+
+// gzip the rolled log file, the plain one is removed once it is compressed
+static bool compressLogFile(const QString &fileName)
+{
+    QFile in(fileName);
+    if (!in.open(QIODevice::ReadOnly))
+        return false;
+
+    const QString &target = fileName + kCompressedSuffix;
+    gzFile out = gzopen(QFile::encodeName(target).constData(), "wb6");
+    if (!out)
+        return false;
+
+    bool ok = true;
+    QByteArray buffer(64 * 1024, Qt::Uninitialized);
+    qint64 size = 0;
+    while ((size = in.read(buffer.data(), buffer.size())) > 0) {
+        if (gzwrite(out, buffer.constData(), static_cast<unsigned>(size)) != size) {
+            ok = false;
+            break;
+        }
+    }
+
+    if (gzclose(out) != Z_OK || size < 0)
+        ok = false;
+
+    QFile::remove(ok ? fileName : target);
+    return ok;
+}
+
 FilterAppenderPrivate::FilterAppenderPrivate(FilterAppender *qq)
     : frequency(FilterAppender::kMinutelyRollover),
       logFilesLimit(0),
       logSizeLimit(1024 * 1024 * 20),
+      ring(kRingCapacity),
       q(qq)
 {
+    // the rolled files are compressed and removed in order
+    compressPool.setMaxThreadCount(1);
 }
 
 void FilterAppenderPrivate::rollOver()
@@ -27,18 +72,24 @@ void FilterAppenderPrivate::rollOver()
     if (suffix == rollOverSuffix)
         return;
 
-    q->closeFile();
+    logFile.close();
 
-    QString targetFileName = q->fileName() + suffix;
+    const QString &fileName = q->fileName();
+    QString targetFileName = fileName + suffix;
     QFile f(targetFileName);
     if (f.exists() && !f.remove())
         return;
-    f.setFileName(q->fileName());
+    f.setFileName(fileName);
     if (!f.rename(targetFileName))
         return;
 
-    q->openFile();
-    removeOldFiles();
+    // the writer goes on with a new file while the rolled one is compressed, the old files are
+    // removed after it, so the files are neither removed while compressed nor left behind by it.
+    QtConcurrent::run(&compressPool, [this, targetFileName]() {
+        compressLogFile(targetFileName);
+        QMutexLocker locker(&rollingMutex);
+        removeOldFiles(targetFileName);
+    });
 }
 
 void FilterAppenderPrivate::computeRollOverTime()
@@ -117,30 +168,48 @@ void FilterAppenderPrivate::computeFrequency()
     }
 }
 
-void FilterAppenderPrivate::removeOldFiles()
+void FilterAppenderPrivate::removeOldFiles(const QString &rolledFile)
 {
     if (logFilesLimit <= 1)
         return;
 
-    QFileInfo fileInfo(q->fileName());
-    QDir logDirectory(fileInfo.absoluteDir());
-    logDirectory.setFilter(QDir::Files);
-    logDirectory.setNameFilters(QStringList() << fileInfo.fileName() + "*");
-    QFileInfoList logFiles = logDirectory.entryInfoList();
+    // the directory is scanned for the files of the last runs only once,
+    // the files rolled later are tracked in memory
+    if (!rolledFilesScanned) {
+        rolledFilesScanned = true;
+
+        QFileInfo fileInfo(q->fileName());
+        QDir logDirectory(fileInfo.absoluteDir());
+        logDirectory.setFilter(QDir::Files);
+        logDirectory.setNameFilters(QStringList() << fileInfo.fileName() + "*");
+        QFileInfoList logFiles = logDirectory.entryInfoList();
+
+        QMap<QDateTime, QString> fileDates;
+        for (int i = 0; i < logFiles.length(); ++i) {
+            QString name = logFiles[i].fileName();
+            QString path = logFiles[i].absoluteFilePath();
+            if (name.endsWith(kCompressedSuffix)) {
+                name.chop(kCompressedSuffixLength);
+                path.chop(kCompressedSuffixLength);
+            }
+            QString suffix = name.mid(name.indexOf(fileInfo.fileName()) + fileInfo.fileName().length());
+            QDateTime fileDateTime = QDateTime::fromString(suffix, datePatternString);
+
+            if (fileDateTime.isValid())
+                fileDates.insert(fileDateTime, path);
+        }
+        rolledFiles = fileDates.values();
+    }
 
-    QMap<QDateTime, QString> fileDates;
-    for (int i = 0; i < logFiles.length(); ++i) {
-        QString name = logFiles[i].fileName();
-        QString suffix = name.mid(name.indexOf(fileInfo.fileName()) + fileInfo.fileName().length());
-        QDateTime fileDateTime = QDateTime::fromString(suffix, q->datePatternString());
+    const QString &rolledPath = QFileInfo(rolledFile).absoluteFilePath();
+    if (!rolledFiles.contains(rolledPath))
+        rolledFiles.append(rolledPath);
 
-        if (fileDateTime.isValid())
-            fileDates.insert(fileDateTime, logFiles[i].absoluteFilePath());
+    while (rolledFiles.size() > logFilesLimit - 1) {
+        const QString &fileName = rolledFiles.takeFirst();
+        QFile::remove(fileName);
+        QFile::remove(fileName + kCompressedSuffix);
     }
-
-    QList<QString> fileDateNames = fileDates.values();
-    for (int i = 0; i < fileDateNames.length() - logFilesLimit + 1; ++i)
-        QFile::remove(fileDateNames[i]);
 }
 
 void FilterAppenderPrivate::setDatePatternString(const QString &datePattern)
@@ -149,6 +218,134 @@ void FilterAppenderPrivate::setDatePatternString(const QString &datePattern)
     datePatternString = datePattern;
 }
 
+void FilterAppenderPrivate::startWriter()
+{
+    writer = std::thread([this]() {
+        writeLoop();
+    });
+}
+
+void FilterAppenderPrivate::stopWriter()
+{
+    if (!writer.joinable())
+        return;
+
+    stopping.store(true);
+    wakeRequested.store(true);
+    {
+        QMutexLocker lk(&wakeMutex);
+        wakeCondition.wakeOne();
+    }
+    writer.join();
+    compressPool.waitForDone();
+}
+
+void FilterAppenderPrivate::enqueue(QString &&record, bool waitWritten)
+{
+    ring.push(std::move(record));
+    const quint64 ticket = pushedCount.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    // the writer wakes up by itself every kFlushInterval, hurry it up only when the ring is filling up
+    if (waitWritten || ring.size() >= ring.capacity() / 4) {
+        if (!wakeRequested.exchange(true)) {
+            QMutexLocker lk(&wakeMutex);
+            wakeCondition.wakeOne();
+        }
+    }
+
+    if (!waitWritten)
+        return;
+
+    // the process aborts right after a fatal record, give the writer a chance to save it
+    QElapsedTimer timer;
+    timer.start();
+    while (writtenCount.load(std::memory_order_acquire) + ring.dropped() < ticket
+           && timer.elapsed() < kFatalWaitTime)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void FilterAppenderPrivate::writeLoop()
+{
+    QByteArray batch;
+    QString record;
+    for (;;) {
+        const bool exiting = stopping.load();
+
+        batch.clear();
+        int count = 0;
+        while (count < kMaxBatchRecords && ring.pop(&record)) {
+            batch.append(record.toUtf8());
+            ++count;
+        }
+
+        const quint64 dropped = ring.dropped();
+        if (dropped != reportedDropped) {
+            batch.append(QString("%1 [Warning] %2 log records are dropped, the log buffer is full\n")
+                                 .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd, HH:mm:ss.zzz"))
+                                 .arg(dropped - reportedDropped)
+                                 .toUtf8());
+            reportedDropped = dropped;
+        }
+
+        if (!batch.isEmpty())
+            writeBatch(batch);
+        writtenCount.fetch_add(static_cast<quint64>(count), std::memory_order_release);
+
+        if (count == kMaxBatchRecords)
+            continue;
+        if (exiting)
+            break;
+
+        QMutexLocker lk(&wakeMutex);
+        if (!wakeRequested.load())
+            wakeCondition.wait(&wakeMutex, kFlushInterval);
+        wakeRequested.store(false);
+    }
+
+    logFile.close();
+}
+
+void FilterAppenderPrivate::writeBatch(const QByteArray &batch)
+{
+    if (!openLogFile())
+        return;
+
+    {
+        QMutexLocker locker(&rollingMutex);
+        const bool timeout = !rollOverTime.isNull() && QDateTime::currentDateTime() > rollOverTime;
+        if (!datePatternString.isEmpty() && (timeout || logFile.size() > logSizeLimit)) {
+            rollOver();
+            if (!openLogFile())
+                return;
+        }
+    }
+
+    logFile.write(batch);
+    logFile.flush();
+}
+
+bool FilterAppenderPrivate::openLogFile()
+{
+    const QString &fileName = q->fileName();
+    if (logFile.isOpen()) {
+        if (logFile.fileName() == fileName)
+            return true;
+        logFile.close();
+    }
+
+    if (fileName.isEmpty())
+        return false;
+
+    // never log in the writer thread, the records would come back here
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    logFile.setFileName(fileName);
+    if (!logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        std::cerr << "<FilterAppender> Cannot open the log file " << qPrintable(fileName) << std::endl;
+        return false;
+    }
+    return true;
+}
+
 /*!
  * \class FilterAppender
  * \brief The RollingFileAppender(modifed as FilterAppender) class extends FileAppender so that the underlying file is rolled over at a user chosen frequency.
@@ -162,6 +359,11 @@ void FilterAppenderPrivate::setDatePatternString(const QString &datePattern)
  *
  * The logFilesLimit parameter is used to automatically delete the oldest log files in the directory during rollover
  * (so no more than logFilesLimit recent log files exist in the directory at any moment).
+ *
+ * The records are formatted in the logging thread and queued in a lock-free ring, a writer thread
+ * appends them to the file in batches, rolls the file over and gzips the rolled files.
+ * Logging never waits for the disk: when the ring is full the oldest records are dropped,
+ * and the count of the dropped records is written to the log.
  * \sa setDatePattern(DatePattern), setLogFilesLimit(int)
  */
 
@@ -169,6 +371,12 @@ FilterAppender::FilterAppender(const QString &fileName)
     : FileAppender(fileName),
       d(new FilterAppenderPrivate(this))
 {
+    d->startWriter();
+}
+
+FilterAppender::~FilterAppender()
+{
+    d->stopWriter();
 }
 
 void FilterAppender::append(const QDateTime &timeStamp, Logger::LogLevel logLevel, const char *file, int line,
@@ -183,13 +391,16 @@ void FilterAppender::append(const QDateTime &timeStamp, Logger::LogLevel logLeve
     }
     locker.unlock();
 
-    if (!d->rollOverTime.isNull() && QDateTime::currentDateTime() > d->rollOverTime)
-        d->rollOver();
-
-    if (size() > d->logSizeLimit)
-        d->rollOver();
+    d->enqueue(formattedString(timeStamp, logLevel, file, line, function, category, message),
+               logLevel == Logger::Fatal);
+}
 
-    FileAppender::append(timeStamp, logLevel, file, line, function, category, message);
+/*!
+ * \brief the count of the records dropped since the ring buffer was full
+ */
+quint64 FilterAppender::droppedRecords() const
+{
+    return d->ring.dropped();
 }
 
 FilterAppender::DatePattern FilterAppender::datePattern() const
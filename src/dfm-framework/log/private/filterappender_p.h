@@ -8,7 +8,16 @@
 #include <dfm-framework/dfm_framework_global.h>
 #include <dfm-framework/log/filterappender.h>
 
+#include "logringbuffer_p.h"
+
 #include <QDateTime>
+#include <QFile>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+
+#include <atomic>
+#include <thread>
 
 DPF_BEGIN_NAMESPACE
 
@@ -20,9 +29,16 @@ public:
     void rollOver();
     void computeRollOverTime();
     void computeFrequency();
-    void removeOldFiles();
+    void removeOldFiles(const QString &rolledFile);
     void setDatePatternString(const QString &datePattern);
 
+    void startWriter();
+    void stopWriter();
+    void enqueue(QString &&record, bool waitWritten);
+    void writeLoop();
+    void writeBatch(const QByteArray &batch);
+    bool openLogFile();
+
 public:
     QString datePatternString;
     FilterAppender::DatePattern frequency;
@@ -32,6 +48,21 @@ public:
     int logFilesLimit;
     qint64 logSizeLimit;
     mutable QMutex rollingMutex;
+    QStringList rolledFiles;   // oldest first
+    bool rolledFilesScanned { false };
+    QThreadPool compressPool;
+
+    // the records are formatted by the logging threads and written by the writer thread
+    LogRingBuffer ring;
+    std::thread writer;
+    QFile logFile;
+    std::atomic_bool stopping { false };
+    std::atomic_bool wakeRequested { false };
+    QMutex wakeMutex;
+    QWaitCondition wakeCondition;
+    std::atomic<quint64> pushedCount { 0 };
+    std::atomic<quint64> writtenCount { 0 };
+    quint64 reportedDropped { 0 };
 
     QStringList keyFilters;
     mutable QMutex filterMutex;
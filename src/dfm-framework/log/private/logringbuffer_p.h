@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOGRINGBUFFER_P_H
+#define LOGRINGBUFFER_P_H
+
+#include <dfm-framework/dfm_framework_global.h>
+
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+DPF_BEGIN_NAMESPACE
+
+/*!
+ * \brief The LogRingBuffer class is a bounded lock-free queue of formatted log records.
+ * Any thread pushes and pops, a push never blocks: when the ring is full the oldest
+ * record is dropped and counted.
+ *
+ * Every cell carries a sequence number telling whether it is ready to be written
+ * or read for the current lap (D. Vyukov's bounded queue).
+ */
+class LogRingBuffer
+{
+    Q_DISABLE_COPY(LogRingBuffer)
+
+public:
+    explicit LogRingBuffer(int capacity);
+
+    void push(QString &&record);
+    bool pop(QString *record);
+
+    int capacity() const;
+    int size() const;
+    quint64 dropped() const;
+
+private:
+    bool tryPush(QString &&record);
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> seq { 0 };
+        QString record;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask { 0 };
+    alignas(64) std::atomic<size_t> enqueuePos { 0 };
+    alignas(64) std::atomic<size_t> dequeuePos { 0 };
+    std::atomic<quint64> droppedCount { 0 };
+};
+
+inline LogRingBuffer::LogRingBuffer(int capacity)
+{
+    size_t size = 2;
+    while (size < static_cast<size_t>(capacity))
+        size <<= 1;
+
+    cells.reset(new Cell[size]);
+    mask = size - 1;
+    for (size_t i = 0; i < size; ++i)
+        cells[i].seq.store(i, std::memory_order_relaxed);
+}
+
+inline void LogRingBuffer::push(QString &&record)
+{
+    while (!tryPush(std::move(record))) {
+        // drop the oldest one to make room, the logging thread never waits for the disk
+        QString oldest;
+        if (pop(&oldest))
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline bool LogRingBuffer::pop(QString *record)
+{
+    Cell *cell { nullptr };
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        cell = &cells[pos & mask];
+        const size_t seq = cell->seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;   // empty
+        } else {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    *record = std::move(cell->record);
+    cell->record = QString();
+    cell->seq.store(pos + mask + 1, std::memory_order_release);
+    return true;
+}
+
+inline int LogRingBuffer::capacity() const
+{
+    return static_cast<int>(mask + 1);
+}
+
+inline int LogRingBuffer::size() const
+{
+    const size_t head = dequeuePos.load(std::memory_order_relaxed);
+    const size_t tail = enqueuePos.load(std::memory_order_relaxed);
+    return tail > head ? static_cast<int>(qMin(tail - head, mask + 1)) : 0;
+}
+
+inline quint64 LogRingBuffer::dropped() const
+{
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+inline bool LogRingBuffer::tryPush(QString &&record)
+{
+    Cell *cell { nullptr };
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        cell = &cells[pos & mask];
+        const size_t seq = cell->seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;   // full
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->record = std::move(record);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+DPF_END_NAMESPACE
+
+#endif   // LOGRINGBUFFER_P_H
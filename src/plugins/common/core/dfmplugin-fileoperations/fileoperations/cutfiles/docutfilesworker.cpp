@@ -152,7 +152,6 @@ bool DoCutFilesWorker::doCutFile(const DFileInfoPointer &fromInfo, const DFileIn
     if (ok) {
         workData->currentWriteSize += fromSize;
         if (fromInfo->attribute(DFileInfo::AttributeID::kStandardIsFile).toBool()) {
-            workData->blockRenameWriteSize += fromSize;
             workData->currentWriteSize += (fromSize > 0
                                            ? fromSize : FileUtils::getMemoryPageSize());
             if (fromSize <= 0)
@@ -161,7 +160,6 @@ bool DoCutFilesWorker::doCutFile(const DFileInfoPointer &fromInfo, const DFileIn
             // count size
             SizeInfoPointer sizeInfo(new FileUtils::FilesSizeInfo);
             FileOperationsUtils::statisticFilesSize(fromInfo->uri(), sizeInfo);
-            workData->blockRenameWriteSize += sizeInfo->totalSize;
             if (sizeInfo->totalSize <= 0)
                 workData->zeroOrlinkOrDirWriteSize += workData->dirSize;
         }
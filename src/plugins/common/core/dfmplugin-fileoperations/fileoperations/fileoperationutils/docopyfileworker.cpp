@@ -9,6 +9,7 @@
 #include <dfm-base/utils/networkutils.h>
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/utils/tracer.h>
 
 #include <dfm-io/dfmio_utils.h>
 
@@ -128,6 +129,7 @@ void DoCopyFileWorker::doMemcpyLocalBigFile(const DFileInfoPointer fromInfo, con
 bool DoCopyFileWorker::doDfmioFileCopy(const DFileInfoPointer fromInfo,
                                        const DFileInfoPointer toInfo, bool *skip)
 {
+    dfmTraceSpan("copy", "DoCopyFileWorker::doDfmioFileCopy");
     assert(!fromInfo.isNull());
     assert(!toInfo.isNull());
     if (isStopped())
@@ -210,6 +212,7 @@ void DoCopyFileWorker::syncBlockFile(const DFileInfoPointer toInfo)
 // copy thread using
 DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFilePractically(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip)
 {
+    dfmTraceSpan("copy", "DoCopyFileWorker::doCopyFilePractically");
     if (isStopped())
         return NextDo::kDoCopyErrorAddCancel;
     // emit current task url
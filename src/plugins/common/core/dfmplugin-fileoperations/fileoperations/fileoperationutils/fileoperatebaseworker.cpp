@@ -23,7 +23,6 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <zlib.h>
-#include <syscall.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
 
@@ -764,7 +763,6 @@ void FileOperateBaseWorker::initCopyWay()
 {
     // local file useing least 8 thread
     if (isSourceFileLocal && isTargetFileLocal) {
-        countWriteType = CountWriteSizeType::kCustomizeType;
         workData->signalThread = (sourceFilesCount > 1 || sourceFilesTotalSize > FileOperationsUtils::bigFileSize()) && FileUtils::getCpuProcessCount() > 4
                 ? false
                 : true;
@@ -772,16 +770,9 @@ void FileOperateBaseWorker::initCopyWay()
             threadCount = FileUtils::getCpuProcessCount() >= 8 ? FileUtils::getCpuProcessCount() : 8;
     }
 
-    if (DeviceUtils::isSamba(targetUrl)
-        || DeviceUtils::isFtp(targetUrl)
-        || workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCountProgressCustomize))
-        countWriteType = CountWriteSizeType::kCustomizeType;
-
     if (!workData->signalThread) {
         initThreadCopy();
     }
-
-    copyTid = (countWriteType == CountWriteSizeType::kTidType) ? syscall(SYS_gettid) : -1;
 }
 
 QUrl FileOperateBaseWorker::trashInfo(const DFileInfoPointer &fromInfo)
@@ -1234,81 +1225,19 @@ void FileOperateBaseWorker::setAllDirPermisson()
     }
 }
 
+/*!
+ * \brief FileOperateBaseWorker::getWriteDataSize the size written by the job so far.
+ * The copy loops count the bytes they write, so it does not depend on the io
+ * accounting of the kernel and the other processes writing the same device.
+ * All the data is written while it is synced, the task dialog shows the syncing
+ * state at the full progress.
+ */
 qint64 FileOperateBaseWorker::getWriteDataSize()
 {
-    qint64 writeSize = 0;
-
-    if (CountWriteSizeType::kTidType == countWriteType) {
-        writeSize = getTidWriteSize();
-
-        if (writeSize > workData->currentWriteSize && workData->currentWriteSize > 0) {
-            writeSize = workData->currentWriteSize;
-        }
-        if (writeSize <= 0)
-            writeSize = workData->currentWriteSize;
-    } else if (CountWriteSizeType::kCustomizeType == countWriteType) {
-        writeSize = workData->currentWriteSize;
-    } else if (CountWriteSizeType::kWriteBlockType == countWriteType) {
-        qint64 currentSectorsWritten = getSectorsWritten() + workData->blockRenameWriteSize;
-        if (currentSectorsWritten > targetDeviceStartSectorsWritten)
-            writeSize = (currentSectorsWritten - targetDeviceStartSectorsWritten) * targetLogSecionSize;
-    }
-
-    writeSize += (workData->skipWriteSize + workData->zeroOrlinkOrDirWriteSize);
-
-    return writeSize;
-}
-
-qint64 FileOperateBaseWorker::getTidWriteSize()
-{
-    QFile file(QStringLiteral("/proc/self/task/%1/io").arg(copyTid));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        fmWarning() << "Failed on open the" << file.fileName() << ", will be not update the job speed and progress";
-
-        return 0;
-    }
-
-    const QByteArray &line_head = QByteArrayLiteral("write_bytes: ");
-    const QByteArray &all_data = file.readAll();
-
-    file.close();
-
-    QTextStream text_stream(all_data);
-
-    while (!text_stream.atEnd()) {
-        const QByteArray &line = text_stream.readLine().toLatin1();
-
-        if (line.startsWith(line_head)) {
-            bool ok = false;
-            qint64 size = line.mid(line_head.size()).toLongLong(&ok);
-
-            if (!ok) {
-                fmWarning() << "Failed to convert to qint64, line string=" << line;
-
-                return 0;
-            }
-            return size;
-        }
-    }
-
-    fmWarning() << "Failed to find \"" << line_head << "\" from the" << file.fileName();
-
-    return 0;
-}
-
-qint64 FileOperateBaseWorker::getSectorsWritten()
-{
-    QByteArray data;
-    QFile file(targetSysDevPath + "/stat");
+    if (isSyncingFiles)
+        return sourceFilesTotalSize;
 
-    if (file.open(QIODevice::ReadOnly)) {
-        data = file.readAll();
-        file.close();
-        return data.simplified().split(' ').value(6).toLongLong();
-    } else {
-        return 0;
-    }
+    return workData->currentWriteSize.value() + workData->skipWriteSize + workData->zeroOrlinkOrDirWriteSize;
 }
 
 void FileOperateBaseWorker::determineCountProcessType()
@@ -1335,29 +1264,15 @@ void FileOperateBaseWorker::determineCountProcessType()
                     fmDebug("lsblk result data: \"%s\"", data.constData());
 
                     if (list.size() == 3) {
-                        targetSysDevPath = "/sys/dev/block/" + list.first();
                         targetIsRemovable = list.at(1) == "1";
 
-                        bool ok = false;
-                        targetLogSecionSize = static_cast<qint16>(list.at(2).toInt(&ok));
-
-                        if (!ok) {
-                            targetLogSecionSize = 512;
-
-                            fmWarning() << "get target log secion size failed!";
-                        }
-
                         if (targetIsRemovable) {
                             workData->exBlockSyncEveryWrite = FileOperationsUtils::blockSync();
-                            countWriteType = workData->exBlockSyncEveryWrite ? CountWriteSizeType::kCustomizeType
-                                                                             : CountWriteSizeType::kWriteBlockType;
-                            targetDeviceStartSectorsWritten = workData->exBlockSyncEveryWrite ? 0 : getSectorsWritten();
-
                             workData->isBlockDevice = true;
                         }
 
-                        fmDebug("Block device path: \"%s\", Sys dev path: \"%s\", Is removable: %d, Log-Sec: %d",
-                                qPrintable(device), qPrintable(targetSysDevPath), bool(targetIsRemovable), targetLogSecionSize);
+                        fmDebug("Block device path: \"%s\", Is removable: %d",
+                                qPrintable(device), bool(targetIsRemovable));
                     } else {
                         fmWarning("Failed on parse the lsblk result data, data: \"%s\"", data.constData());
                     }
@@ -1377,6 +1292,10 @@ void FileOperateBaseWorker::syncFilesToDevice()
         return;
 
     fmInfo() << "start sync all file to extend block device!!!!! target : " << targetUrl;
+    // the written bytes are counted before they reach the device, report the syncing
+    // phase at once instead of waiting at the full progress with no feedback.
+    isSyncingFiles = true;
+    onUpdateProgress();
     for (const auto &url : syncFiles) {
         std::string stdStr = url.path().toUtf8().toStdString();
         int tofd = open(stdStr.data(), O_RDONLY);
@@ -15,10 +15,59 @@
 
 #include <fcntl.h>
 
+#include <atomic>
+
 DPFILEOPERATIONS_BEGIN_NAMESPACE
 DFMBASE_USE_NAMESPACE
 
 typedef QSharedPointer<dfmio::DFileInfo> DFileInfoPointer;
+
+/*!
+ * \brief The WriteSizeCounter class counts the bytes written by the copy threads.
+ * Every thread adds to a counter on its own cache line, so the copy loops never
+ * contend on it, and the progress timer sums the counters up.
+ */
+class WriteSizeCounter
+{
+public:
+    inline WriteSizeCounter &operator+=(qint64 size)
+    {
+        current().fetch_add(size, std::memory_order_relaxed);
+        return *this;
+    }
+
+    inline WriteSizeCounter &operator-=(qint64 size)
+    {
+        current().fetch_sub(size, std::memory_order_relaxed);
+        return *this;
+    }
+
+    inline qint64 value() const
+    {
+        qint64 size = 0;
+        for (const auto &counter : counters)
+            size += counter.size.load(std::memory_order_relaxed);
+        return size;
+    }
+
+private:
+    static constexpr int kCounterCount { 16 };
+
+    struct alignas(64) Counter
+    {
+        std::atomic<qint64> size { 0 };
+    };
+
+    inline std::atomic<qint64> &current()
+    {
+        static std::atomic_uint nextIndex { 0 };
+        thread_local const uint index = nextIndex.fetch_add(1, std::memory_order_relaxed) % kCounterCount;
+        return counters[index].size;
+    }
+
+    Counter counters[kCounterCount];
+};
+
 class WorkerData
 {
 public:
@@ -58,9 +107,8 @@ public:
     std::atomic_bool exBlockSyncEveryWrite { false };
     std::atomic_bool isFsTypeVfat { false };
     std::atomic_bool isBlockDevice { false };
-    std::atomic_int64_t currentWriteSize { 0 };
+    WriteSizeCounter currentWriteSize;   // the bytes written by the copy threads
     QAtomicInteger<qint64> zeroOrlinkOrDirWriteSize { 0 };   // The copy size is 0. The write statistics size of the linked file and directory
-    QAtomicInteger<qint64> blockRenameWriteSize { 0 };   // The copy size is 0. The write statistics size of the linked file and directory
     QAtomicInteger<qint64> skipWriteSize { 0 };   // 跳过的文件大
     QAtomicInteger<qint64> completeFileCount { 0 };   // copy complete file count
     std::atomic_bool signalThread { true };
@@ -41,6 +41,7 @@ BasicWidget::BasicWidget(QWidget *parent)
 {
     initUI();
     fileCalculationUtils = new FileStatisticsJob;
+    fileCalculationUtils->setFileHints(FileStatisticsJob::kUseDirSizeCache);
 }
 
 BasicWidget::~BasicWidget()
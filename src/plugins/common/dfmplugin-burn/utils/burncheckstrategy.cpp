@@ -3,9 +3,25 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "burncheckstrategy.h"
-#include "burnhelper.h"
+#include "dfmplugin_burn_global.h"
 
 #include <QDebug>
+#include <QDir>
+#include <QMutex>
+#include <QQueue>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 
 namespace dfmplugin_burn {
 
@@ -18,11 +34,164 @@ static constexpr int kMaxISO9660FileNameSize { 32 };
 static constexpr int kMaxJolietFileNameSize { 64 };
 static constexpr int kMaxJolietFilePathSize { 120 };
 
+static constexpr int kMaxWalkThreads { 4 };
+static constexpr int kDirentBufferSize { 32 * 1024 };
+
+namespace {
+
+struct LinuxDirent64
+{
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+struct DirTask
+{
+    QByteArray absolutePath;
+    QString filePath;   // the path in the disc, empty for the stage root
+};
+
+/*!
+ * \brief The StageWalker class walks the stage directory with getdents64 on a few threads.
+ * The visitor gets every entry as soon as it is read, and stops the walk by returning false.
+ * Hidden entries and symbolic links are skipped, as the check always did.
+ */
+class StageWalker
+{
+public:
+    using Visitor = std::function<bool(const QString &fileName, const QString &filePath)>;
+
+    StageWalker(const QByteArray &root, Visitor visitor)
+        : visitor(std::move(visitor))
+    {
+        push({ root, QString() });
+    }
+
+    bool walk()
+    {
+        const int count = qBound(1, QThread::idealThreadCount(), kMaxWalkThreads);
+        std::vector<std::thread> threads;
+        for (int i = 1; i < count; ++i)
+            threads.emplace_back(&StageWalker::work, this);
+        work();
+        for (auto &thread : threads)
+            thread.join();
+
+        return !stopped;
+    }
+
+private:
+    void push(DirTask &&task)
+    {
+        QMutexLocker lk(&mutex);
+        tasks.enqueue(std::move(task));
+        ++pending;
+        cond.wakeOne();
+    }
+
+    void stop()
+    {
+        stopped = true;
+        QMutexLocker lk(&mutex);
+        cond.wakeAll();
+    }
+
+    void work()
+    {
+        forever {
+            DirTask task;
+            {
+                QMutexLocker lk(&mutex);
+                while (tasks.isEmpty() && pending > 0 && !stopped)
+                    cond.wait(&mutex);
+                // no task left means no directory is being read either
+                if (stopped || tasks.isEmpty())
+                    return;
+                task = tasks.dequeue();
+            }
+
+            scan(task);
+
+            QMutexLocker lk(&mutex);
+            if (--pending == 0)
+                cond.wakeAll();
+        }
+    }
+
+    void scan(const DirTask &task)
+    {
+        const int fd = ::open(task.absolutePath.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            fmWarning() << "Cannot open the stage dir:" << task.absolutePath;
+            return;
+        }
+
+        alignas(LinuxDirent64) char buffer[kDirentBufferSize];
+        while (!stopped) {
+            const long size = ::syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+            if (size <= 0) {
+                if (size < 0)
+                    fmWarning() << "Cannot read the stage dir:" << task.absolutePath;
+                break;
+            }
+
+            for (long pos = 0; pos < size && !stopped;) {
+                const auto *entry = reinterpret_cast<const LinuxDirent64 *>(buffer + pos);
+                pos += entry->d_reclen;
+
+                // ".", ".." and the hidden entries
+                const char *name = entry->d_name;
+                if (name[0] == '.')
+                    continue;
+
+                unsigned char type = entry->d_type;
+                if (type == DT_UNKNOWN) {
+                    struct stat st;
+                    if (::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+                        continue;
+                    type = S_ISDIR(st.st_mode) ? DT_DIR : (S_ISREG(st.st_mode) ? DT_REG : DT_UNKNOWN);
+                }
+                if (type != DT_DIR && type != DT_REG)
+                    continue;
+
+                const QString &fileName { QFile::decodeName(name) };
+                const QString &filePath { task.filePath + QDir::separator() + fileName };
+                if (!visitor(fileName, filePath)) {
+                    stop();
+                    break;
+                }
+
+                if (type == DT_DIR)
+                    push({ task.absolutePath + '/' + name, filePath });
+            }
+        }
+
+        ::close(fd);
+    }
+
+private:
+    Visitor visitor;
+    QMutex mutex;
+    QWaitCondition cond;
+    QQueue<DirTask> tasks;
+    int pending { 0 };
+    std::atomic_bool stopped { false };
+};
+
+}   // namespace
+
 BurnCheckStrategy::BurnCheckStrategy(const QString &path, QObject *parent)
     : QObject(parent), currentStagePath(path)
 {
 }
 
+/*!
+ * \brief check the entries of the stage directory while reading it, and stop at the first invalid one
+ * \return true if all the entries can be burned
+ */
 bool BurnCheckStrategy::check()
 {
     Q_ASSERT(!currentStagePath.isEmpty());
@@ -31,22 +200,24 @@ bool BurnCheckStrategy::check()
     if (!info.isDir())
         return true;
 
-    const QFileInfoList &rootFileInfoGroup { BurnHelper::localFileInfoList(currentStagePath) };
-    for (const QFileInfo &info : rootFileInfoGroup) {
-        if (!validFile(info))
-            return false;
-        if (info.isDir()) {
-            const auto &filters { QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks };
-            const QFileInfoList &subFileInfoGroup { BurnHelper::localFileInfoListRecursive(info.absoluteFilePath(), filters) };
-            if (!std::all_of(subFileInfoGroup.cbegin(), subFileInfoGroup.cend(), [this](const QFileInfo &info) {
-                    return validFile(info);
-                })) {
-                return false;
-            }
-        }
-    }
-
-    return true;
+    invalidName.clear();
+    errorMsg.clear();
+
+    QMutex mutex;
+    StageWalker walker(QFile::encodeName(QDir::cleanPath(info.absoluteFilePath())),
+                       [this, &mutex](const QString &fileName, const QString &filePath) {
+                           const QString &error { checkEntry(fileName, filePath) };
+                           if (error.isEmpty())
+                               return true;
+
+                           QMutexLocker lk(&mutex);
+                           if (errorMsg.isEmpty()) {
+                               invalidName = fileName;
+                               errorMsg = error + fileName;
+                           }
+                           return false;
+                       });
+    return walker.walk();
 }
 
 QString BurnCheckStrategy::lastError() const
@@ -59,43 +230,29 @@ QString BurnCheckStrategy::lastInvalidName() const
     return autoFeed(invalidName);
 }
 
-bool BurnCheckStrategy::validFile(const QFileInfo &info)
+/*!
+ * \brief the rules are called from the walking threads, they must not touch the members
+ * \param filePath is the path in the disc, starts with the separator
+ * \return the error message without the name, empty if the entry is valid
+ */
+QString BurnCheckStrategy::checkEntry(const QString &fileName, const QString &filePath)
 {
-    if (!info.exists())
-        return true;
+    if (!validFileNameCharacters(fileName))
+        return "Invalid FileNameCharacters Length: ";
 
-    QString absoluteFilePathWithStagePath { info.absoluteFilePath() };
-    const QString &fileName { info.fileName() };
-    const QString &absoluteFilePath { QDir::separator() + absoluteFilePathWithStagePath.remove(currentStagePath) };
-    invalidName = fileName;
+    if (!validFilePathCharacters(filePath))
+        return "Invalid FilePathCharacters Length: ";
 
-    if (!validFileNameCharacters(fileName)) {
-        errorMsg = "Invalid FileNameCharacters Length: " + invalidName;
-        return false;
-    }
+    if (!validFileNameBytes(fileName))
+        return "Invalid FileNameBytes Length: ";
 
-    if (!validFilePathCharacters(absoluteFilePath)) {
-        errorMsg = "Invalid FilePathCharacters Length: " + invalidName;
-        return false;
-    }
+    if (!validFilePathBytes(filePath))
+        return "Invalid FilePathBytes Length: ";
 
-    if (!validFileNameBytes(fileName)) {
-        errorMsg = "Invalid FileNameBytes Length: " + invalidName;
-        return false;
-    }
-
-    if (!validFilePathBytes(absoluteFilePath)) {
-        errorMsg = "Invalid FilePathBytes Length: " + invalidName;
-        return false;
-    }
+    if (!validFilePathDeepLength(filePath))
+        return "Invalid FilePathDeepLength: ";
 
-    if (!validFilePathDeepLength(absoluteFilePath)) {
-        errorMsg = "Invalid FilePathDeepLength: " + invalidName;
-        return false;
-    }
-
-    invalidName = "";
-    return true;
+    return QString();
 }
 
 QString BurnCheckStrategy::autoFeed(const QString &text) const
@@ -21,7 +21,7 @@ public:
     QString lastInvalidName() const;
 
 private:
-    bool validFile(const QFileInfo &info);
+    QString checkEntry(const QString &fileName, const QString &filePath);
     QString autoFeed(const QString &text) const;
 
 protected:
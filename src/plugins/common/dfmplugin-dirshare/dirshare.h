@@ -24,6 +24,7 @@ class DirShare : public DPF_NAMESPACE::Plugin
     DPF_EVENT_REG_SLOT(slot_Share_AddShare)
     DPF_EVENT_REG_SLOT(slot_Share_RemoveShare)
     DPF_EVENT_REG_SLOT(slot_Share_IsPathShared)
+    DPF_EVENT_REG_SLOT(slot_Share_SharedAncestor)
     DPF_EVENT_REG_SLOT(slot_Share_AllShareInfos)
     DPF_EVENT_REG_SLOT(slot_Share_ShareInfoOfFilePath)
     DPF_EVENT_REG_SLOT(slot_Share_ShareInfoOfShareName)
@@ -203,6 +203,29 @@ bool UserShareHelper::isShared(const QString &path)
     return sharePathToShareName.contains(path);
 }
 
+/*!
+ * \brief the nearest shared directory of \a path or \a path itself, empty if none is shared.
+ * It looks up the ancestors one by one, in O(depth).
+ */
+QString UserShareHelper::sharedAncestor(const QString &path)
+{
+    if (sharePathToShareName.isEmpty() || path.isEmpty())
+        return QString();
+
+    QString dir = QDir::cleanPath(path);
+    forever {
+        if (sharePathToShareName.contains(dir))
+            return dir;
+        if (dir == QDir::rootPath())
+            return QString();
+
+        const int idx = dir.lastIndexOf(QDir::separator());
+        if (idx < 0)
+            return QString();
+        dir = idx == 0 ? QDir::rootPath() : dir.left(idx);
+    }
+}
+
 QString UserShareHelper::currentUserName()
 {
     return getpwuid(getuid())->pw_name;
@@ -302,69 +325,66 @@ bool UserShareHelper::isUserSharePasswordSet(const QString &username)
     return result;
 }
 
+/*!
+ * \brief read all the share files again, it is done once at startup
+ */
 void UserShareHelper::readShareInfos(bool sendSignal)
 {
-    QStringList oldSharedInfoKeys = sharedInfos.keys();
-    auto shareInfoCache = sharedInfos;
-
-    sharedInfos.clear();
-    sharePathToShareName.clear();
-
     QDir d(ShareConfig::kShareConfigPath);
-    QFileInfoList shareList = d.entryInfoList(QDir::Files | QDir::Hidden);
-    for (const auto &fileInfo : shareList) {
-        QString filePath = fileInfo.absoluteFilePath();
-        QFile file(filePath);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            fmWarning() << "open share file failed: " << filePath;
-            return;
-        }
+    const QFileInfoList &shareList = d.entryInfoList(QDir::Files | QDir::Hidden);
+    for (const auto &fileInfo : shareList)
+        changedShareFiles.insert(fileInfo.absoluteFilePath());
+
+    // the shares of the files gone are removed
+    for (auto it = shareFileToShareName.cbegin(); it != shareFileToShareName.cend(); ++it)
+        changedShareFiles.insert(it.key());
+
+    readChangedShareFiles(sendSignal);
+}
+
+/*!
+ * \brief parse the share files reported by the watcher only, the other shares are kept
+ */
+void UserShareHelper::readChangedShareFiles(bool sendSignal)
+{
+    const QSet<QString> files = changedShareFiles;
+    changedShareFiles.clear();
+
+    QStringList removedPaths;
+    QStringList addedPaths;
+    for (const QString &filePath : files) {
+        const QString &oldName = shareFileToShareName.value(filePath);
+        const ShareInfo &oldInfo = shareInfoByShareName(oldName);
+        ShareInfo newInfo = readShareFile(filePath);
+        if (!isValidShare(newInfo))
+            newInfo.clear();
+        if (oldInfo == newInfo)
+            continue;
 
-        QMap<QString, QString> info;
-        QTextStream stream(&file);
-        while (!stream.atEnd()) {
-            QString line = stream.readLine().trimmed();
-            if (!line.isEmpty() && line.contains("=")) {
-                int idx = line.indexOf("=");
-                QString key = line.mid(0, idx);
-                QString value = line.mid(idx + 1);
-                info.insert(key, value);
-            }
-        }
-        file.close();
+        const QString &oldPath = oldInfo.value(ShareInfoKeys::kPath).toString();
+        const QString &newPath = newInfo.value(ShareInfoKeys::kPath).toString();
+        const bool sameShare = !oldName.isEmpty() && oldName == newInfo.value(ShareInfoKeys::kName).toString() && oldPath == newPath;
 
-        auto shareInfo = makeInfoByFileContent(info);
-        if (isValidShare(shareInfo)) {
-            const auto &&name = shareInfo.value(ShareInfoKeys::kName).toString();
-            const auto &&path = shareInfo.value(ShareInfoKeys::kPath).toString();
+        removeShareOfFile(filePath);
+        if (!oldInfo.isEmpty() && !sameShare)
+            removedPaths << oldPath;
 
-            sharedInfos.insert(name, shareInfo);
-            QStringList names = sharePathToShareName.value(path, {});
-            names.append(name);
-            sharePathToShareName.insert(path, names);
-        }
-    }
-
-    ShareInfoList newShares;
-    for (const auto &info : sharedInfos.values()) {
-        if (isValidShare(info)) {
-            if (!oldSharedInfoKeys.contains(info.value(ShareInfoKeys::kName).toString()))
-                newShares << info;
-            else
-                oldSharedInfoKeys.removeOne(info.value(ShareInfoKeys::kName).toString());
+        if (!newInfo.isEmpty()) {
+            insertShare(filePath, newInfo);
+            if (!sameShare)
+                addedPaths << newPath;
         }
     }
 
     // broadcast deleted shares
-    for (const QString &shareName : oldSharedInfoKeys) {
-        const QString &filePath = shareInfoCache.value(shareName).value(ShareInfoKeys::kPath).toString();
-        emitShareRemoved(filePath);
-        watcherManager->remove(filePath);
+    for (const QString &path : removedPaths) {
+        emitShareRemoved(path);
+        if (!sharePathToShareName.contains(path))
+            watcherManager->remove(path);
     }
 
     // broadcast new shares
-    for (const ShareInfo &info : newShares) {
-        const auto &&path = info.value(ShareInfoKeys::kPath).toString();
+    for (const QString &path : addedPaths) {
         emitShareAdded(path);
         watcherManager->add(path);
     }
@@ -384,6 +404,17 @@ void UserShareHelper::onShareChanged(const QString &path)
     if (path.contains(":tmp"))
         return;
 
+    if (path == ShareConfig::kShareConfigPath) {
+        // the share directory itself is removed, all the shares are gone
+        for (auto it = shareFileToShareName.cbegin(); it != shareFileToShareName.cend(); ++it)
+            changedShareFiles.insert(it.key());
+    } else if (isShareFile(path)) {
+        changedShareFiles.insert(path);
+    } else {
+        // the files changed in the shared directories do not change the shares
+        return;
+    }
+
     pollingSharesTimer->start();
     //    QTimer::singleShot(1000, this, [=] { /*TODO(xust) TODO(liuyangming) request to refresh file view*/ });
 }
@@ -408,11 +439,12 @@ void UserShareHelper::initConnect()
     pollingSharesTimer->setInterval(300);
     pollingSharesTimer->setSingleShot(true);
 
-    connect(pollingSharesTimer, &QTimer::timeout, this, [this] { this->readShareInfos(); });
+    connect(pollingSharesTimer, &QTimer::timeout, this, [this] { this->readChangedShareFiles(); });
 
     connect(watcherManager, &ShareWatcherManager::fileMoved, this, &UserShareHelper::onShareMoved);
     connect(watcherManager, &ShareWatcherManager::fileDeleted, this, &UserShareHelper::onShareFileDeleted);
     connect(watcherManager, &ShareWatcherManager::subfileCreated, this, &UserShareHelper::onShareChanged);
+    connect(watcherManager, &ShareWatcherManager::fileAttributeChanged, this, &UserShareHelper::onShareChanged);
 }
 
 void UserShareHelper::initMonitorPath()
@@ -544,6 +576,63 @@ ShareInfo UserShareHelper::makeInfoByFileContent(const QMap<QString, QString> &c
     return info;
 }
 
+ShareInfo UserShareHelper::readShareFile(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        fmDebug() << "share file is not readable: " << filePath;
+        return {};
+    }
+
+    QMap<QString, QString> info;
+    QTextStream stream(&file);
+    while (!stream.atEnd()) {
+        QString line = stream.readLine().trimmed();
+        if (!line.isEmpty() && line.contains("=")) {
+            int idx = line.indexOf("=");
+            QString key = line.mid(0, idx);
+            QString value = line.mid(idx + 1);
+            info.insert(key, value);
+        }
+    }
+    file.close();
+
+    return makeInfoByFileContent(info);
+}
+
+void UserShareHelper::insertShare(const QString &filePath, const ShareInfo &info)
+{
+    const auto &&name = info.value(ShareInfoKeys::kName).toString();
+    const auto &&path = info.value(ShareInfoKeys::kPath).toString();
+
+    sharedInfos.insert(name, info);
+    shareFileToShareName.insert(filePath, name);
+    QStringList &names = sharePathToShareName[path];
+    names.removeOne(name);
+    names.append(name);
+}
+
+void UserShareHelper::removeShareOfFile(const QString &filePath)
+{
+    const QString &name = shareFileToShareName.take(filePath);
+    if (name.isEmpty())
+        return;
+
+    const ShareInfo &info = sharedInfos.take(name);
+    const QString &path = info.value(ShareInfoKeys::kPath).toString();
+    auto it = sharePathToShareName.find(path);
+    if (it != sharePathToShareName.end()) {
+        it->removeOne(name);
+        if (it->isEmpty())
+            sharePathToShareName.erase(it);
+    }
+}
+
+bool UserShareHelper::isShareFile(const QString &path)
+{
+    return path.startsWith(QString(ShareConfig::kShareConfigPath) + QDir::separator());
+}
+
 int UserShareHelper::validShareInfoCount() const
 {
     return std::accumulate(sharedInfos.begin(), sharedInfos.end(),
@@ -13,6 +13,8 @@
 #include <QTimer>
 #include <QSharedPointer>
 #include <QMap>
+#include <QHash>
+#include <QSet>
 #include <QFuture>
 
 class QDBusInterface;
@@ -46,6 +48,7 @@ public:
     QString shareNameByPath(const QString &path);
     uint whoShared(const QString &name);
     bool isShared(const QString &path);
+    QString sharedAncestor(const QString &path);
     QString currentUserName();
 
     bool isSambaServiceRunning();
@@ -63,6 +66,7 @@ Q_SIGNALS:
 
 protected Q_SLOTS:
     void readShareInfos(bool sendSignal = true);
+    void readChangedShareFiles(bool sendSignal = true);
     void onShareChanged(const QString &path);
     void onShareFileDeleted(const QString &path);
     void onShareMoved(const QString &from, const QString &to);
@@ -80,6 +84,10 @@ private:
     int runNetCmd(const QStringList &args, int wait = 30000, QString *err = nullptr);
     void handleErrorWhenShareFailed(int code, const QString &err) const;
     ShareInfo makeInfoByFileContent(const QMap<QString, QString> &contents);
+    ShareInfo readShareFile(const QString &filePath);
+    void insertShare(const QString &filePath, const ShareInfo &info);
+    void removeShareOfFile(const QString &filePath);
+    static bool isShareFile(const QString &path);
     int validShareInfoCount() const;
 
     QPair<bool, QString> startSmbService();
@@ -97,7 +105,9 @@ private:
     QSharedPointer<QDBusInterface> userShareInter { nullptr };
 
     QMap<QString, ShareInfo> sharedInfos {};
-    QMap<QString, QStringList> sharePathToShareName {};
+    QHash<QString, QStringList> sharePathToShareName {};
+    QHash<QString, QString> shareFileToShareName {};
+    QSet<QString> changedShareFiles {};
 
     ShareWatcherManager *watcherManager { nullptr };
 };
@@ -128,7 +128,12 @@ void BrowserPage::render(const double &scaleFactor, const Rotation &rotation, co
                           static_cast<int>(boundingRect().width() * qApp->devicePixelRatio()),
                           static_cast<int>(boundingRect().height() * qApp->devicePixelRatio()));
 
-        PageRenderThread::appendTask(task);
+        //! 滚动回来或缩放回来时直接使用缓存的图片
+        QImage image;
+        if (PageRenderThread::findCachedImage(docSheet, currentIndex, task.rect.size(), image))
+            handleRenderFinished(currentPixmapId, QPixmap::fromImage(image));
+        else
+            PageRenderThread::appendTask(task);
     }
 
     update();
@@ -236,6 +241,12 @@ void BrowserPage::clearPixmap()
     PageRenderThread::clearImageTasks(docSheet, this);
 }
 
+void BrowserPage::prefetch()
+{
+    if (currentScaleFactor > 0 && !qFuzzyCompare(renderPixmapScaleFactor, currentScaleFactor))
+        render(currentScaleFactor, currentRotation);
+}
+
 QPointF BrowserPage::getTopLeftPos()
 {
     QPointF p;
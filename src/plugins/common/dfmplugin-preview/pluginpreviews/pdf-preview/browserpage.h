@@ -85,6 +85,12 @@ public:
      */
     void clearPixmap();
 
+    /**
+     * @brief prefetch
+     * 预取视图附近的页,在其被绘制之前加载图片
+     */
+    void prefetch();
+
     /**
      * @brief getTopLeftPos
      * 根据旋转角度和item坐标计算出item的左上角坐标
@@ -9,6 +9,7 @@
 #include "encryptionpage.h"
 #include "pdfmodel.h"
 #include "sheetrenderer.h"
+#include "pagerenderthread.h"
 
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -63,6 +64,8 @@ DocSheet::~DocSheet()
 {
     setAlive(false);
 
+    PageRenderThread::clearSheetCache(this);
+
     delete sheetBrowser;
 
     delete sheetSidebar;
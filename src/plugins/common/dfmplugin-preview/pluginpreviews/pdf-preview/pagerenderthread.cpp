@@ -10,6 +10,7 @@
 #include "sidebarimageviewmodel.h"
 
 #include <QTime>
+#include <QElapsedTimer>
 #include <QDebug>
 #include <QMetaType>
 #include <QFileInfo>
@@ -19,8 +20,10 @@ PageRenderThread *PageRenderThread::pageRenderThread = nullptr;   //由于pdfium
 
 bool PageRenderThread::quitForever = false;
 
+static constexpr int kImageCacheCost { 64 * 1024 };   //! 页面图片缓存上限 64MB, 以KB计
+
 PageRenderThread::PageRenderThread(QObject *parent)
-    : QThread(parent)
+    : QThread(parent), imageCache(kImageCacheCost)
 {
     qRegisterMetaType<Document *>("Document *");
     qRegisterMetaType<QList<Page *>>("QList<Page *>");
@@ -182,6 +185,63 @@ void PageRenderThread::appendTask(DocCloseTask task)
         instance->start();
 }
 
+void PageRenderThread::setViewportRange(DocSheet *sheet, int fromIndex, int toIndex)
+{
+    PageRenderThread *instance = PageRenderThread::instance();
+
+    if (nullptr == instance) {
+        return;
+    }
+
+    QMutexLocker locker(&instance->viewportMutex);
+
+    instance->viewportRanges.insert(sheet, qMakePair(fromIndex, toIndex));
+}
+
+bool PageRenderThread::findCachedImage(DocSheet *sheet, int index, const QSize &size, QImage &image)
+{
+    PageRenderThread *instance = PageRenderThread::instance();
+
+    if (nullptr == instance) {
+        return false;
+    }
+
+    QMutexLocker locker(&instance->imageCacheMutex);
+
+    QImage *cached = instance->imageCache.object({ sheet, index, size });
+
+    if (nullptr == cached)
+        return false;
+
+    image = *cached;
+
+    return true;
+}
+
+void PageRenderThread::clearSheetCache(DocSheet *sheet)
+{
+    PageRenderThread *instance = PageRenderThread::instance();
+
+    if (nullptr == instance) {
+        return;
+    }
+
+    instance->viewportMutex.lock();
+
+    instance->viewportRanges.remove(sheet);
+
+    instance->viewportMutex.unlock();
+
+    QMutexLocker locker(&instance->imageCacheMutex);
+
+    const QList<DocPageImageKey> &keys = instance->imageCache.keys();
+
+    for (const DocPageImageKey &key : keys) {
+        if (key.sheet == sheet)
+            instance->imageCache.remove(key);
+    }
+}
+
 void PageRenderThread::run()
 {
     quitDoc = false;
@@ -231,13 +291,44 @@ bool PageRenderThread::popNextDocPageNormalImageTask(DocPageNormalImageTask &tas
     if (pageNormalImageTasks.count() <= 0)
         return false;
 
-    task = pageNormalImageTasks.value(0);
+    //! 视图内的页最先渲染,然后是离视图最近的预取页
+    int next = 0;
+
+    int nextDistance = viewportDistance(pageNormalImageTasks.at(0));
+
+    for (int i = 1; i < pageNormalImageTasks.count() && nextDistance > 0; ++i) {
+        int distance = viewportDistance(pageNormalImageTasks.at(i));
+        if (distance < nextDistance) {
+            next = i;
+            nextDistance = distance;
+        }
+    }
 
-    pageNormalImageTasks.removeAt(0);
+    task = pageNormalImageTasks.takeAt(next);
 
     return true;
 }
 
+int PageRenderThread::viewportDistance(const DocPageNormalImageTask &task) const
+{
+    QMutexLocker locker(&viewportMutex);
+
+    auto iter = viewportRanges.constFind(task.sheet);
+
+    if (iter == viewportRanges.constEnd())
+        return 0;
+
+    int index = task.page->itemIndex();
+
+    if (index < iter->first)
+        return iter->first - index;
+
+    if (index > iter->second)
+        return index - iter->second;
+
+    return 0;
+}
+
 bool PageRenderThread::popNextDocPageThumbnailTask(DocPageThumbnailTask &task)
 {
     QMutexLocker locker(&pageThumbnailMutex);
@@ -293,10 +384,27 @@ bool PageRenderThread::execNextDocPageNormalImageTask()
     if (!DocSheet::existSheet(task.sheet))
         return true;
 
-    QImage image = task.sheet->getImage(task.page->itemIndex(), task.rect.width(), task.rect.height());
+    int index = task.page->itemIndex();
+
+    QElapsedTimer timer;
+
+    timer.start();
+
+    QImage image = task.sheet->getImage(index, task.rect.width(), task.rect.height());
+
+    fmDebug() << "PDF Preview: page" << index + 1 << "rendered in" << timer.elapsed() << "ms, size:" << task.rect.size();
+
+    if (!image.isNull()) {
+        imageCacheMutex.lock();
+
+        //! 文档已关闭则不再缓存,避免地址被新文档复用后命中
+        if (DocSheet::existSheet(task.sheet))
+            imageCache.insert({ task.sheet, index, task.rect.size() }, new QImage(image), qMax(1, static_cast<int>(image.sizeInBytes() / 1024)));
+
+        imageCacheMutex.unlock();
 
-    if (!image.isNull())
         emit sigDocPageNormalImageTaskFinished(task, QPixmap::fromImage(image));
+    }
 
     return true;
 }
@@ -14,6 +14,8 @@
 #include <QStack>
 #include <QImage>
 #include <QPixmap>
+#include <QCache>
+#include <QHash>
 
 namespace plugin_filepreview {
 class DocSheet;
@@ -29,6 +31,23 @@ struct DocPageNormalImageTask
     QRect rect = QRect();   //整个大小
 };
 
+struct DocPageImageKey
+{   //页面图片缓存的键
+    DocSheet *sheet = nullptr;
+    int index = -1;
+    QSize size = QSize();
+
+    bool operator==(const DocPageImageKey &other) const
+    {
+        return sheet == other.sheet && index == other.index && size == other.size;
+    }
+};
+
+inline uint qHash(const DocPageImageKey &key, uint seed = 0)
+{
+    return ::qHash(key.sheet, seed) ^ ::qHash(key.index) ^ ::qHash(key.size.width() << 16 | key.size.height());
+}
+
 struct DocPageSliceImageTask
 {   //取切片
     DocSheet *sheet = nullptr;
@@ -91,6 +110,33 @@ public:
 
     static void appendTask(DocCloseTask task);
 
+    /**
+     * @brief setViewportRange
+     * 设置文档当前视图中的页范围,视图内的页先渲染,其余的按距离视图的远近渲染
+     * @param sheet
+     * @param fromIndex 视图中的起始页码索引
+     * @param toIndex 视图中的结束页码索引
+     */
+    static void setViewportRange(DocSheet *sheet, int fromIndex, int toIndex);
+
+    /**
+     * @brief findCachedImage
+     * 从按字节数限制大小的页面图片缓存中查找已渲染的图片
+     * @param sheet
+     * @param index 页码编号
+     * @param size 图片大小
+     * @param image 找到的图片
+     * @return 是否找到
+     */
+    static bool findCachedImage(DocSheet *sheet, int index, const QSize &size, QImage &image);
+
+    /**
+     * @brief clearSheetCache
+     * 文档关闭时清除其页面图片缓存和视图范围
+     * @param sheet
+     */
+    static void clearSheetCache(DocSheet *sheet);
+
     /**
      * @brief destroyForever
      * 销毁线程且不会再被创建
@@ -115,6 +161,8 @@ private:
 
     bool popNextDocCloseTask(DocCloseTask &task);
 
+    int viewportDistance(const DocPageNormalImageTask &task) const;
+
 private:
     bool execNextDocPageNormalImageTask();
 
@@ -157,6 +205,12 @@ private:
     QMutex closeMutex;
     QList<DocCloseTask> closeTasks;
 
+    mutable QMutex viewportMutex;
+    QHash<DocSheet *, QPair<int, int>> viewportRanges;
+
+    QMutex imageCacheMutex;
+    QCache<DocPageImageKey, QImage> imageCache;   //! 开销以KB计
+
     bool quitDoc { false };
 
     static bool quitForever;
@@ -7,6 +7,7 @@
 #include "browserpage.h"
 #include "sheetrenderer.h"
 #include "docsheet.h"
+#include "pagerenderthread.h"
 
 #include <DGuiApplicationHelper>
 
@@ -84,10 +85,14 @@ void SheetBrowser::onViewportChanged()
     int toIndex = 0;
     currentIndexRange(fromIndex, toIndex);
 
+    PageRenderThread::setViewportRange(docSheet, fromIndex, toIndex);
+
     foreach (BrowserPage *item, browserPageList) {
-        //! 上下多2个浮动
+        //! 上下多2个浮动,视图外的页取消渲染,浮动的页预取
         if (item->itemIndex() < fromIndex - 2 || item->itemIndex() > toIndex + 2) {
             item->clearPixmap();
+        } else if (item->itemIndex() < fromIndex || item->itemIndex() > toIndex) {
+            item->prefetch();
         }
     }
 }
@@ -152,6 +152,24 @@ QVariantHash TagProxyHandle::getAllFileWithTags()
     return data.toHash();
 }
 
+/*!
+ * \brief the tagged files in \a dirs.
+ * \param ok set to false if the query failed, an empty result means no file is tagged otherwise.
+ */
+QVariantHash TagProxyHandle::getFilesWithTagsInDirs(const QStringList &dirs, bool *ok)
+{
+    auto &&reply = d->tagDBusInterface->Query(int(QueryOpts::kFilesWithTagsInDirs), dirs);
+    reply.waitForFinished();
+    if (ok)
+        *ok = reply.isValid();
+    if (!reply.isValid()) {
+        fmWarning() << "getFilesWithTagsInDirs failed :" << reply.error();
+        return {};
+    }
+    const auto &data = d->parseDBusVariant(reply.value());
+    return data.toHash();
+}
+
 bool TagProxyHandle::addTags(const QVariantMap &value)
 {
     auto &&reply = d->tagDBusInterface->Insert(int(InsertOpts::kTags), value);
@@ -26,6 +26,7 @@ public:
     QVariantMap getFilesThroughTag(const QStringList &value);
     QVariantMap getTagsColor(const QStringList &value);
     QVariantHash getAllFileWithTags();
+    QVariantHash getFilesWithTagsInDirs(const QStringList &dirs, bool *ok = nullptr);
 
     bool addTags(const QVariantMap &value);
     bool addTagsForFiles(const QVariantMap &value);
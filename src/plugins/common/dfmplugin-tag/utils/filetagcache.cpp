@@ -28,6 +28,18 @@ void FileTagCacheWorker::loadFileTagsFromDatabase()
     FileTagCache::instance().loadFileTagsFromDatabase();
 }
 
+void FileTagCacheWorker::loadDirTags(const QStringList &dirs)
+{
+    FileTagCache::instance().loadDirs(dirs);
+}
+
+void FileTagCacheWorker::onDirTagsRequested(const QStringList &dirs)
+{
+    const auto &paths = FileTagCache::instance().loadDirs(dirs);
+    if (!paths.isEmpty())
+        emit FileTagCacheIns.dirTagsLoaded(paths);
+}
+
 void FileTagCacheWorker::onTagAdded(const QVariantMap &tags)
 {
     FileTagCache::instance().addTags(tags);
@@ -48,10 +60,8 @@ void FileTagCacheWorker::onTagsColorChanged(const QVariantMap &tagAndColorName)
 
 void FileTagCacheWorker::onTagsNameChanged(const QVariantMap &oldAndNew)
 {
+    // the files refer to the tag id, only the name of id is changed.
     FileTagCache::instance().changeTagName(oldAndNew);
-    auto &&map { oldAndNew.toStdMap() };
-    for (auto [oldName, newName] : map)
-        FileTagCache::instance().changeFilesTagName(oldName, newName.toString());
     emit FileTagCacheIns.tagsNameChanged(oldAndNew);
 }
 
@@ -76,6 +86,88 @@ FileTagCachePrivate::~FileTagCachePrivate()
 {
 }
 
+/*!
+ * \brief split \a path to the parent dir and the file name.
+ */
+QPair<QString, QString> FileTagCachePrivate::splitPath(const QString &path)
+{
+    const int idx = path.lastIndexOf('/');
+    if (idx < 0)
+        return { QString(), path };
+
+    return { idx == 0 ? QString("/") : path.left(idx), path.mid(idx + 1) };
+}
+
+int FileTagCachePrivate::tagId(const QString &name)
+{
+    auto it = tagIds.constFind(name);
+    if (it != tagIds.constEnd())
+        return it.value();
+
+    // reuse the id of deleted tag
+    int id = tagNames.indexOf(QString());
+    if (id < 0) {
+        id = tagNames.size();
+        tagNames.append(name);
+    } else {
+        tagNames[id] = name;
+    }
+
+    tagIds.insert(name, id);
+    return id;
+}
+
+FileTagCachePrivate::TagBits FileTagCachePrivate::toBits(const QStringList &tags)
+{
+    TagBits bits(tagNames.size());
+    for (const QString &tag : tags) {
+        if (tag.isEmpty())
+            continue;
+
+        const int id = tagId(tag);
+        if (id >= bits.size())
+            bits.resize(id + 1);
+        bits.setBit(id);
+    }
+
+    return bits;
+}
+
+QStringList FileTagCachePrivate::toNames(const TagBits &bits) const
+{
+    QStringList names;
+    const int count = qMin(bits.size(), tagNames.size());
+    for (int id = 0; id < count; ++id) {
+        if (bits.testBit(id) && !tagNames.at(id).isEmpty())
+            names.append(tagNames.at(id));
+    }
+
+    return names;
+}
+
+FileTagCachePrivate::TagBits FileTagCachePrivate::fileBits(const QString &path) const
+{
+    const auto &dirAndName = splitPath(path);
+    auto dir = dirTags.constFind(dirAndName.first);
+    if (dir == dirTags.constEnd())
+        return {};
+
+    return dir->value(dirAndName.second);
+}
+
+void FileTagCachePrivate::setFileBits(const QString &path, const TagBits &bits)
+{
+    const auto &dirAndName = splitPath(path);
+    if (bits.count(true) > 0) {
+        dirTags[dirAndName.first].insert(dirAndName.second, bits);
+        return;
+    }
+
+    auto dir = dirTags.find(dirAndName.first);
+    if (dir != dirTags.end())
+        dir->remove(dirAndName.second);
+}
+
 FileTagCache::FileTagCache(QObject *parent)
     : QObject(parent), d(new FileTagCachePrivate(this))
 {
@@ -87,53 +179,156 @@ FileTagCache &FileTagCache::instance()
     return cache;
 }
 
+/*!
+ * \brief load all tags, the tagged files are loaded per directory when they are queried.
+ */
 void FileTagCache::loadFileTagsFromDatabase()
 {
     fmInfo() << "Start initilize FileTagCache";
-    // 加载数据库所有文件标记,和标记属性到缓存
+    // 加载数据库所有标记属性到缓存,文件标记按目录懒加载
     if (!TagProxyHandle::instance()->isValid())
         fmWarning() << "tagService is inValid";
-    d->fileTagsCache = TagProxyHandle::instance()->getAllFileWithTags();
     const auto &tagsColor = TagProxyHandle::instance()->getAllTags();
+
+    QWriteLocker lk(&d->lock);
+    d->dirTags.clear();
+    d->loadedDirs.clear();
+    d->pendingDirs.clear();
     auto it = tagsColor.begin();
-    for (; it != tagsColor.end(); ++it)
+    for (; it != tagsColor.end(); ++it) {
         d->tagProperty.insert(it.key(), QColor(it.value().toString()));
+        d->tagId(it.key());
+    }
+}
+
+/*!
+ * \brief load the tagged files in \a dirs from database.
+ * \return the paths of the loaded files
+ */
+QStringList FileTagCache::loadDirs(const QStringList &dirs)
+{
+    QStringList toLoad;
+    {
+        QReadLocker lk(&d->lock);
+        for (const QString &dir : dirs)
+            if (!dir.isEmpty() && !d->loadedDirs.contains(dir) && !toLoad.contains(dir))
+                toLoad.append(dir);
+    }
+
+    if (toLoad.isEmpty())
+        return {};
+
+    if (!TagProxyHandle::instance()->isValid()) {
+        fmWarning() << "tagService is inValid, can not load tags of" << toLoad;
+        QWriteLocker lk(&d->lock);
+        for (const QString &dir : toLoad)
+            d->pendingDirs.remove(dir);
+        return {};
+    }
+
+    bool ok = false;
+    const auto &fileTags = TagProxyHandle::instance()->getFilesWithTagsInDirs(toLoad, &ok);
+    if (!ok) {
+        // loaded again at the next request
+        QWriteLocker lk(&d->lock);
+        for (const QString &dir : toLoad)
+            d->pendingDirs.remove(dir);
+        return {};
+    }
+
+    QStringList paths;
+    QWriteLocker lk(&d->lock);
+    for (const QString &dir : toLoad) {
+        d->dirTags.remove(dir);
+        d->loadedDirs.insert(dir);
+        d->pendingDirs.remove(dir);
+    }
+
+    for (auto it = fileTags.cbegin(); it != fileTags.cend(); ++it) {
+        d->setFileBits(it.key(), d->toBits(it.value().toStringList()));
+        paths.append(it.key());
+    }
+
+    return paths;
+}
+
+/*!
+ * \brief the dirs of \a paths that are not loaded yet.
+ */
+QStringList FileTagCache::unloadedDirs(const QStringList &paths) const
+{
+    QStringList dirs;
+    QReadLocker lk(&d->lock);
+    for (const QString &path : paths) {
+        const QString &dir = FileTagCachePrivate::splitPath(path).first;
+        if (!dir.isEmpty() && !d->loadedDirs.contains(dir) && !dirs.contains(dir))
+            dirs.append(dir);
+    }
+
+    return dirs;
+}
+
+/*!
+ * \brief mark \a dirs as being loaded.
+ * \return the dirs that were not being loaded.
+ */
+QStringList FileTagCache::markPending(const QStringList &dirs)
+{
+    QStringList ret;
+    QWriteLocker lk(&d->lock);
+    for (const QString &dir : dirs) {
+        if (d->pendingDirs.contains(dir))
+            continue;
+        d->pendingDirs.insert(dir);
+        ret.append(dir);
+    }
+
+    return ret;
 }
 
 void FileTagCache::addTags(const QVariantMap &tags)
 {
+    QWriteLocker lk(&d->lock);
     auto it = tags.begin();
     for (; it != tags.end(); ++it) {
         if (d->tagProperty.contains(it.key()))
             continue;
         d->tagProperty.insert(it.key(), QColor(it.value().toString()));
+        d->tagId(it.key());
     }
 }
 
 void FileTagCache::deleteTags(const QStringList &tags)
 {
-    QVariantMap map {};
+    QWriteLocker lk(&d->lock);
     for (const QString &tag : tags) {
         d->tagProperty.remove(tag);
 
-        auto iter = d->fileTagsCache.begin();
-        while (iter != d->fileTagsCache.end()) {
-            if (iter.value().toStringList().contains(tag)) {
-                QStringList fileTags = map[iter.key()].toStringList();
-                fileTags.append(tag);
-                map[iter.key()] = fileTags;
-            }
+        const int id = d->tagIds.value(tag, -1);
+        if (id < 0)
+            continue;
 
-            ++iter;
+        // free the id and untag the files.
+        d->tagIds.remove(tag);
+        d->tagNames[id].clear();
+        for (auto dir = d->dirTags.begin(); dir != d->dirTags.end(); ++dir) {
+            for (auto file = dir->begin(); file != dir->end();) {
+                if (id < file->size() && file->testBit(id)) {
+                    file->clearBit(id);
+                    if (file->count(true) == 0) {
+                        file = dir->erase(file);
+                        continue;
+                    }
+                }
+                ++file;
+            }
         }
     }
-
-    if (!map.isEmpty())
-        untaggeFiles(map);
 }
 
 void FileTagCache::changeTagColor(const QVariantMap &tagAndColorName)
 {
+    QWriteLocker lk(&d->lock);
     auto it = tagAndColorName.begin();
     for (; it != tagAndColorName.end(); ++it) {
         if (d->tagProperty.contains(it.key()))
@@ -143,6 +338,7 @@ void FileTagCache::changeTagColor(const QVariantMap &tagAndColorName)
 
 void FileTagCache::changeTagName(const QVariantMap &oldAndNew)
 {
+    QWriteLocker lk(&d->lock);
     auto it = oldAndNew.begin();
     for (; it != oldAndNew.end(); ++it) {
         const QString &oldName { it.key() };
@@ -152,57 +348,48 @@ void FileTagCache::changeTagName(const QVariantMap &oldAndNew)
             d->tagProperty.remove(oldName);
             d->tagProperty.insert(newName, color);
         }
-    }
-}
 
-void FileTagCache::changeFilesTagName(const QString &oldName, const QString &newName)
-{
-    std::for_each(d->fileTagsCache.begin(), d->fileTagsCache.end(), [oldName, newName](QVariant &var) {
-        QStringList tagNames { var.toStringList() };
-        auto result { std::find(tagNames.begin(), tagNames.end(), oldName) };
-        if (result != tagNames.end()) {
-            int index { result - tagNames.begin() };
-            tagNames.replace(index, newName);
-            var.setValue(tagNames);
+        // rename the id, the files keep it.
+        const int id = d->tagIds.value(oldName, -1);
+        if (id >= 0 && !d->tagIds.contains(newName)) {
+            d->tagIds.remove(oldName);
+            d->tagIds.insert(newName, id);
+            d->tagNames[id] = newName;
         }
-    });
+    }
 }
 
 void FileTagCache::taggeFiles(const QVariantMap &fileAndTags)
 {
+    QWriteLocker lk(&d->lock);
     auto it = fileAndTags.begin();
     for (; it != fileAndTags.end(); ++it) {
-        if (!d->fileTagsCache.contains(it.key())) {
-            d->fileTagsCache.insert(it.key(), it.value().toStringList());
-        } else {
-            const auto &lst = it.value().toStringList();
-            auto cacheLst = d->fileTagsCache.value(it.key()).toStringList();
-            for (const QString &tag : lst)
-                if (!cacheLst.contains(tag))
-                    cacheLst.append(tag);
-
-            d->fileTagsCache[it.key()] = cacheLst;
-        }
+        auto bits = d->fileBits(it.key());
+        auto added = d->toBits(it.value().toStringList());
+        const int size = qMax(bits.size(), added.size());
+        bits.resize(size);
+        added.resize(size);
+        bits |= added;
+        d->setFileBits(it.key(), bits);
     }
 }
 
 void FileTagCache::untaggeFiles(const QVariantMap &fileAndTags)
 {
+    QWriteLocker lk(&d->lock);
     auto it = fileAndTags.begin();
     for (; it != fileAndTags.end(); ++it) {
-        if (d->fileTagsCache.contains(it.key())) {
-            const auto &lst = it.value().toStringList();
-            auto cacheLst = d->fileTagsCache.value(it.key()).toStringList();
-            for (const QString &tag : lst)
-                if (cacheLst.contains(tag))
-                    cacheLst.removeOne(tag);
-
-            if (cacheLst.isEmpty()) {
-                d->fileTagsCache.remove(it.key());
-            } else {
-                d->fileTagsCache[it.key()] = cacheLst;
-            }
+        auto bits = d->fileBits(it.key());
+        if (bits.isEmpty())
+            continue;
+
+        const auto &lst = it.value().toStringList();
+        for (const QString &tag : lst) {
+            const int id = d->tagIds.value(tag, -1);
+            if (id >= 0 && id < bits.size())
+                bits.clearBit(id);
         }
+        d->setFileBits(it.key(), bits);
     }
 }
 
@@ -221,15 +408,14 @@ QStringList FileTagCache::getTagsByFiles(const QStringList &paths) const
         return {};
 
     QReadLocker wlk(&d->lock);
-    QStringList intersectionTags = d->fileTagsCache.value(paths.first()).toStringList();
-
-    for (const QString &path : paths) {
-        QStringList tags = d->fileTagsCache.value(path).toStringList();
-        intersectionTags = intersectionTags.toSet().intersect(tags.toSet()).values();
-        if (intersectionTags.isEmpty())
-            break;
+    auto intersection = d->fileBits(paths.first());
+    for (int i = 1; i < paths.size() && intersection.count(true) > 0; ++i) {
+        auto bits = d->fileBits(paths.at(i));
+        bits.resize(intersection.size());
+        intersection &= bits;
     }
-    return intersectionTags;
+
+    return d->toNames(intersection);
 }
 
 FileTagCache::TagColorMap FileTagCache::getTagsColor(const QStringList &tags) const
@@ -253,13 +439,36 @@ FileTagCacheController &FileTagCacheController::instance()
     return cacheController;
 }
 
+/*!
+ * \brief the tags of \a paths, the unloaded dirs are loaded before querying.
+ */
 QStringList FileTagCacheController::getTagsByFiles(const QStringList &paths)
 {
+    const auto &dirs = FileTagCache::instance().unloadedDirs(paths);
+    if (!dirs.isEmpty()) {
+        // load it in the worker thread to keep the order with the tag changes.
+        if (QThread::currentThread() == updateThread.data())
+            cacheWorker->loadDirTags(dirs);
+        else
+            QMetaObject::invokeMethod(cacheWorker.data(), "loadDirTags", Qt::BlockingQueuedConnection, Q_ARG(QStringList, dirs));
+    }
+
     return FileTagCache::instance().getTagsByFiles(paths);
 }
 
+/*!
+ * \brief the tags of \a path, it is called in painting and never waits for loading.
+ * The files are updated by dirTagsLoaded after the dir is loaded.
+ */
 QStringList FileTagCacheController::getTagsByFile(const QString &path)
 {
+    const auto &dirs = FileTagCache::instance().unloadedDirs({ path });
+    if (!dirs.isEmpty()) {
+        const auto &toLoad = FileTagCache::instance().markPending(dirs);
+        if (!toLoad.isEmpty())
+            emit dirTagsRequested(toLoad);
+    }
+
     return FileTagCache::instance().getTagsByFiles({ path });
 }
 
@@ -283,6 +492,7 @@ FileTagCacheController::FileTagCacheController(QObject *parent)
 void FileTagCacheController::init()
 {
     connect(this, &FileTagCacheController::initLoadTagInfos, cacheWorker.data(), &FileTagCacheWorker::loadFileTagsFromDatabase);
+    connect(this, &FileTagCacheController::dirTagsRequested, cacheWorker.data(), &FileTagCacheWorker::onDirTagsRequested);
     connect(TagProxyHandleIns, &TagProxyHandle::newTagsAdded, cacheWorker.data(), &FileTagCacheWorker::onTagAdded);
     connect(TagProxyHandleIns, &TagProxyHandle::tagsDeleted, cacheWorker.data(), &FileTagCacheWorker::onTagDeleted);
     connect(TagProxyHandleIns, &TagProxyHandle::tagsColorChanged, cacheWorker.data(), &FileTagCacheWorker::onTagsColorChanged);
@@ -24,6 +24,8 @@ public:
 
 public Q_SLOTS:
     void loadFileTagsFromDatabase();
+    void loadDirTags(const QStringList &dirs);
+    void onDirTagsRequested(const QStringList &dirs);
     void onTagAdded(const QVariantMap &tags);
     void onTagDeleted(const QVariant &tags);
     void onTagsColorChanged(const QVariantMap &tagAndColorName);
@@ -50,17 +52,19 @@ public:
     //query
     QStringList getTagsByFiles(const QStringList &paths) const;
     TagColorMap getTagsColor(const QStringList &tags) const;
+    QStringList unloadedDirs(const QStringList &paths) const;
 
 private:
     explicit FileTagCache(QObject *parent = nullptr);
     static FileTagCache &instance();
     void loadFileTagsFromDatabase();
+    QStringList loadDirs(const QStringList &dirs);
+    QStringList markPending(const QStringList &dirs);
 
     void addTags(const QVariantMap &tags);
     void deleteTags(const QStringList &tags);
     void changeTagColor(const QVariantMap &tagAndColorName);
     void changeTagName(const QVariantMap &oldAndNew);
-    void changeFilesTagName(const QString &oldName, const QString &newName);
     void taggeFiles(const QVariantMap &fileAndTags);
     void untaggeFiles(const QVariantMap &fileAndTags);
 
@@ -83,6 +87,8 @@ public:
 
 Q_SIGNALS:
     void initLoadTagInfos();
+    void dirTagsRequested(const QStringList &dirs);
+    void dirTagsLoaded(const QStringList &paths);
 
     void filesTagged(const QVariantMap &fileAndTags);
     void filesUntagged(const QVariantMap &fileAndTags);
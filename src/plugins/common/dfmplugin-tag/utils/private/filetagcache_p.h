@@ -7,7 +7,10 @@
 
 #include "utils/filetagcache.h"
 #include <QReadWriteLock>
+#include <QBitArray>
 #include <QMutex>
+#include <QColor>
+#include <QSet>
 
 namespace dfmplugin_tag {
 class FileTagCachePrivate
@@ -15,13 +18,26 @@ class FileTagCachePrivate
     friend class FileTagCache;
     FileTagCache *const q;
 
-    QHash<QString, QVariant> fileTagsCache;   // file path ->  tag name list
+    using TagBits = QBitArray;   // bit n is set if the file has the tag of id n
+
+    QHash<QString, QHash<QString, TagBits>> dirTags;   // dir path -> file name -> tags
+    QSet<QString> loadedDirs;   // the dirs have been loaded from database
+    QSet<QString> pendingDirs;   // the dirs are being loaded
+    QStringList tagNames;   // tag id -> tag name, empty if the id is free
+    QHash<QString, int> tagIds;   // tag name -> tag id
     QHash<QString, QColor> tagProperty;   // tag name -> QColor
-    QReadWriteLock lock;
+    mutable QReadWriteLock lock;
 
 public:
     explicit FileTagCachePrivate(FileTagCache *qq);
     virtual ~FileTagCachePrivate();
+
+    static QPair<QString, QString> splitPath(const QString &path);
+    int tagId(const QString &name);
+    TagBits toBits(const QStringList &tags);
+    QStringList toNames(const TagBits &bits) const;
+    TagBits fileBits(const QString &path) const;
+    void setFileBits(const QString &path, const TagBits &bits);
 };
 }
 
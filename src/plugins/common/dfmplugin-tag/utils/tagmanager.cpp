@@ -59,6 +59,11 @@ void TagManager::initializeConnection()
     connect(&FileTagCacheIns, &FileTagCacheController::tagsNameChanged, this, &TagManager::onTagNameChanged);
     connect(&FileTagCacheIns, &FileTagCacheController::filesTagged, this, &TagManager::onFilesTagged);
     connect(&FileTagCacheIns, &FileTagCacheController::filesUntagged, this, &TagManager::onFilesUntagged);
+    connect(&FileTagCacheIns, &FileTagCacheController::dirTagsLoaded, this, [](const QStringList &paths) {
+        // repaint the tags of the files that were painted before their dir is loaded.
+        for (const QString &path : paths)
+            TagEventCaller::sendFileUpdate(path);
+    });
 }
 
 TagManager *TagManager::instance()
@@ -8,6 +8,7 @@
 #include "model/canvasselectionmodel.h"
 #include "view/canvasview_p.h"
 #include "view/operator/fileoperatorproxy.h"
+#include "model/canvasproxymodel.h"
 
 #include <dfm-base/base/application/application.h>
 #include <dfm-base/base/application/settings.h>
@@ -21,6 +22,7 @@
 
 #include <DApplication>
 #include <DApplicationHelper>
+#include <DGuiApplicationHelper>
 
 #include <QPainter>
 #include <QPainterPath>
@@ -38,6 +40,7 @@ QT_END_NAMESPACE
 
 DFMBASE_USE_NAMESPACE
 DWIDGET_USE_NAMESPACE
+DGUI_USE_NAMESPACE
 using namespace ddplugin_canvas;
 
 #define EDITOR_SHOW_SUFFIX "_d_whether_show_suffix"
@@ -88,6 +91,119 @@ bool CanvasItemDelegatePrivate::needExpend(const QStyleOptionViewItem &option, c
     return calcNeedRect.height() > rText.height();
 }
 
+void CanvasItemDelegatePrivate::paintItem(QPainter *painter, const QStyleOptionViewItem &option,
+                                          const QStyleOptionViewItem &indexOption, const QModelIndex &index) const
+{
+    // draw icon
+    const QRect rIcon = q->iconRect(option.rect);
+    q->paintIcon(painter, indexOption.icon,
+                 { rIcon,
+                   Qt::AlignCenter,
+                   (option.state & QStyle::State_Enabled) ? QIcon::Normal : QIcon::Disabled,
+                   QIcon::Off,
+                   q->isThumnailIconIndex(index) });   // why Enabled?
+
+    // paint emblems to icon
+    q->paintEmblems(painter, rIcon, q->parent()->model()->fileInfo(index));
+
+    // do not draw text if index is in editing,
+    if (!q->parent()->isPersistentEditorOpen(index)) {
+        // draw text
+        q->paintLabel(painter, indexOption, index, q->labelRect(option.rect, rIcon));
+    }
+}
+
+bool CanvasItemDelegatePrivate::isCacheable(const QPainter *painter, const QStyleOptionViewItem &indexOption, const QModelIndex &index) const
+{
+    // the highlighted text may be expanded, and the drag image is painted on other device.
+    return !isHighlight(indexOption)
+            && painter->device() == q->parent()->viewport()
+            && !q->parent()->isPersistentEditorOpen(index);
+}
+
+/*!
+ * \brief the cached appearance of \a index, it is painted again only if the item or the theme is changed.
+ */
+QPixmap CanvasItemDelegatePrivate::itemPixmap(const QPainter *painter, const QStyleOptionViewItem &option,
+                                              const QStyleOptionViewItem &indexOption, const QModelIndex &index)
+{
+    watchModel(q->parent()->model());
+
+    const QUrl &url = q->parent()->model()->fileUrl(index);
+    const qreal pixelRatio = painter->device()->devicePixelRatioF();
+    const bool enabled = option.state & QStyle::State_Enabled;
+    const qint64 iconKey = indexOption.icon.cacheKey();
+    const ItemPixmap *it = itemPixmaps.object(url);
+    if (it && it->size == option.rect.size() && qFuzzyCompare(it->pixelRatio, pixelRatio)
+        && it->enabled == enabled && it->iconKey == iconKey && it->text == indexOption.text
+        && it->iconTheme == QIcon::themeName())
+        return it->pixmap;
+
+    const QRect paintRect = option.rect.adjusted(-kPixmapMargin, -kPixmapMargin, kPixmapMargin, kPixmapMargin);
+    QPixmap pixmap(paintRect.size() * pixelRatio);
+    pixmap.setDevicePixelRatio(pixelRatio);
+    pixmap.fill(Qt::transparent);
+    {
+        QPainter p(&pixmap);
+        p.setFont(painter->font());
+        p.setLayoutDirection(painter->layoutDirection());
+        p.setRenderHints(painter->renderHints());
+        p.translate(-paintRect.topLeft());
+        paintItem(&p, option, indexOption, index);
+    }
+
+    ItemPixmap *item = new ItemPixmap;
+    item->pixmap = pixmap;
+    item->size = option.rect.size();
+    item->pixelRatio = pixelRatio;
+    item->enabled = enabled;
+    item->iconKey = iconKey;
+    item->text = indexOption.text;
+    item->iconTheme = QIcon::themeName();
+    itemPixmaps.insert(url, item, pixmap.width() * pixmap.height() * 4);
+    return pixmap;
+}
+
+void CanvasItemDelegatePrivate::watchModel(CanvasProxyModel *model)
+{
+    if (watchedModel == model)
+        return;
+
+    if (watchedModel)
+        QObject::disconnect(watchedModel, nullptr, q, nullptr);
+
+    itemPixmaps.clear();
+    watchedModel = model;
+    if (!model)
+        return;
+
+    QObject::connect(model, &CanvasProxyModel::dataChanged, q, [this](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+        if (!topLeft.isValid() || !bottomRight.isValid()) {
+            clearPixmaps();
+            return;
+        }
+
+        for (int row = topLeft.row(); row <= bottomRight.row(); ++row)
+            itemPixmaps.remove(watchedModel->fileUrl(watchedModel->index(row)));
+    });
+    QObject::connect(model, &CanvasProxyModel::rowsAboutToBeRemoved, q, [this](const QModelIndex &, int first, int last) {
+        for (int row = first; row <= last; ++row)
+            itemPixmaps.remove(watchedModel->fileUrl(watchedModel->index(row)));
+    });
+    QObject::connect(model, &CanvasProxyModel::dataReplaced, q, [this](const QUrl &oldUrl, const QUrl &newUrl) {
+        itemPixmaps.remove(oldUrl);
+        itemPixmaps.remove(newUrl);
+    });
+    QObject::connect(model, &CanvasProxyModel::modelReset, q, [this]() {
+        clearPixmaps();
+    });
+}
+
+void CanvasItemDelegatePrivate::clearPixmaps()
+{
+    itemPixmaps.clear();
+}
+
 CanvasItemDelegate::CanvasItemDelegate(QAbstractItemView *parentPtr)
     : QStyledItemDelegate(parentPtr), d(new CanvasItemDelegatePrivate(this))
 {
@@ -101,6 +217,18 @@ CanvasItemDelegate::CanvasItemDelegate(QAbstractItemView *parentPtr)
     d->textLineHeight = parent()->fontMetrics().height();
 
     connect(ClipBoard::instance(), &ClipBoard::clipboardDataChanged, this, &CanvasItemDelegate::clipboardDataChanged);
+
+    // the cached items need to be repainted.
+    connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, this, [this]() {
+        d->clearPixmaps();
+    });
+    connect(qApp, &QApplication::fontChanged, this, [this]() {
+        d->clearPixmaps();
+    });
+    connect(Application::instance(), &Application::genericAttributeChanged, this, [this](Application::GenericAttribute ga) {
+        if (ga == Application::kShowedFileSuffix)
+            d->clearPixmaps();
+    });
 }
 
 CanvasItemDelegate::~CanvasItemDelegate()
@@ -130,24 +258,12 @@ void CanvasItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &op
 
     // get item paint geomerty
     // the method to get rect for each element is equal to paintGeomertys(option, index);
-    {
-        // draw icon
-        const QRect rIcon = iconRect(option.rect);
-        paintIcon(painter, indexOption.icon,
-                  { rIcon,
-                    Qt::AlignCenter,
-                    (option.state & QStyle::State_Enabled) ? QIcon::Normal : QIcon::Disabled,
-                    QIcon::Off,
-                    isThumnailIconIndex(index) });   // why Enabled?
-
-        // paint emblems to icon
-        paintEmblems(painter, rIcon, parent()->model()->fileInfo(index));
-
-        // do not draw text if index is in editing,
-        if (!parent()->isPersistentEditorOpen(index)) {
-            // draw text
-            paintLabel(painter, indexOption, index, labelRect(option.rect, rIcon));
-        }
+    if (d->isCacheable(painter, indexOption, index)) {
+        const QPixmap &px = d->itemPixmap(painter, option, indexOption, index);
+        const int margin = CanvasItemDelegatePrivate::kPixmapMargin;
+        painter->drawPixmap(option.rect.topLeft() - QPoint(margin, margin), px);
+    } else {
+        d->paintItem(painter, option, indexOption, index);
     }
 
     painter->restore();
@@ -568,6 +684,7 @@ int CanvasItemDelegate::setIconLevel(int lv)
 
     if (lv >= minimumIconLevel() && lv <= maximumIconLevel()) {
         d->currentIconLevel = lv;
+        d->clearPixmaps();
         parent()->setIconSize(iconSize(lv));
         return lv;
     }
@@ -10,11 +10,14 @@
 #include <dfm-base/utils/elidetextlayout.h>
 
 #include <QPointer>
+#include <QCache>
+#include <QPixmap>
 #include <QTextDocument>
 #include <QAbstractItemView>
 
 namespace ddplugin_canvas {
 
+class CanvasProxyModel;
 class CanvasItemDelegatePrivate
 {
 public:
@@ -39,6 +42,32 @@ public:
                     const QModelIndex &index, const QRect &rText, QRect *needText = nullptr) const;
 
     static void extendLayoutText(const FileInfoPointer &info,  dfmbase::ElideTextLayout *layout);
+
+    void paintItem(QPainter *painter, const QStyleOptionViewItem &option,
+                   const QStyleOptionViewItem &indexOption, const QModelIndex &index) const;
+    bool isCacheable(const QPainter *painter, const QStyleOptionViewItem &indexOption, const QModelIndex &index) const;
+    QPixmap itemPixmap(const QPainter *painter, const QStyleOptionViewItem &option,
+                       const QStyleOptionViewItem &indexOption, const QModelIndex &index);
+    void watchModel(CanvasProxyModel *model);
+    void clearPixmaps();
+
+public:
+    // the static appearance of an unselected item: icon, emblems and shadowed label.
+    struct ItemPixmap
+    {
+        QPixmap pixmap;
+        QSize size;
+        qreal pixelRatio = 1.0;
+        bool enabled = true;
+        qint64 iconKey = 0;
+        QString text;
+        QString iconTheme;
+    };
+
+    // the margin of the cached pixmap for the label shadow.
+    static constexpr int kPixmapMargin = 4;
+    // the bytes of the cached pixmaps, the least recently painted ones are dropped beyond it.
+    static constexpr int kPixmapCacheCost = 64 * 1024 * 1024;
 public:
     CanvasItemDelegate *const q = nullptr;
     // default icon size is 48px.
@@ -48,6 +77,9 @@ public:
     QSize itemSizeHint;
 
     QTextDocument *document { nullptr };
+
+    QCache<QUrl, ItemPixmap> itemPixmaps { kPixmapCacheCost };
+    QPointer<CanvasProxyModel> watchedModel;
 };
 
 }
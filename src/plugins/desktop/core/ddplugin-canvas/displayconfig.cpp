@@ -5,6 +5,7 @@
 #include "displayconfig.h"
 
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
+#include <dfm-base/utils/journaledstore.h>
 #include <dfm-io/dfmio_utils.h>
 
 #include <QThread>
@@ -15,6 +16,7 @@
 #include <QFileInfo>
 #include <QTimer>
 #include <QSettings>
+#include <QDataStream>
 #include <QDebug>
 
 using namespace ddplugin_canvas;
@@ -31,6 +33,7 @@ static const char *const kKeySortOrder = "SortOrder";
 static const char *const kKeyAutoAlign = "AutoSort";
 static const char *const kKeyIconLevel = "IconLevel";
 static const char *const kKeyCustomWaterMask = "WaterMaskUseJson";
+static const char *const kLayoutCoordinates = "coordinates/";
 
 namespace desktop_dconfig {
 static const char *const kConfigName = "org.deepin.dde.file-manager.desktop";
@@ -49,6 +52,27 @@ static void compatibilityFuncForDisbaleAutoMerage(QSettings *set)
     set->endGroup();
 }
 
+static QByteArray encodePosition(const QPoint &pos)
+{
+    QByteArray ret;
+    QDataStream out(&ret, QIODevice::WriteOnly);
+    out << static_cast<qint32>(pos.x()) << static_cast<qint32>(pos.y());
+    return ret;
+}
+
+static bool decodePosition(const QByteArray &data, QPoint &pos)
+{
+    QDataStream in(data);
+    qint32 x = -1;
+    qint32 y = -1;
+    in >> x >> y;
+    if (in.status() != QDataStream::Ok || x < 0 || y < 0)
+        return false;
+
+    pos = QPoint(x, y);
+    return true;
+}
+
 DisplayConfig *DisplayConfig::instance()
 {
     return displayConfig;
@@ -72,6 +96,9 @@ DisplayConfig::DisplayConfig(QObject *parent)
     // to disable automerge after upgrading
     compatibilityFuncForDisbaleAutoMerage(settings);
 
+    // the icon positions are rewritten on every move, they are journaled in a binary store.
+    layout = new dfmbase::JournaledStore(layoutPath());
+
     workThread = new QThread(this);
     moveToThread(workThread);
     workThread->start();
@@ -82,8 +109,13 @@ DisplayConfig::DisplayConfig(QObject *parent)
     syncTimer->setInterval(1000);
     connect(
             syncTimer, &QTimer::timeout, this, [this]() {
-                QMutexLocker lk(&mtxLock);
-                settings->sync();
+                {
+                    QMutexLocker lk(&mtxLock);
+                    settings->sync();
+                }
+
+                if (layout->needCompact())
+                    layout->compact();
             },
             Qt::QueuedConnection);
 }
@@ -103,6 +135,9 @@ DisplayConfig::~DisplayConfig()
     delete settings;
     settings = nullptr;
 
+    delete layout;
+    layout = nullptr;
+
     delete syncTimer;
     syncTimer = nullptr;
 }
@@ -126,17 +161,23 @@ QList<QString> DisplayConfig::profile()
 
 bool DisplayConfig::setProfile(const QList<QString> &profile)
 {
-    // clear all
-    remove(kKeyProfile, "");
-
     QHash<QString, QVariant> values;
+    QList<QString> saved;
     int idx = 1;
     for (auto iter = profile.cbegin(); iter != profile.cend(); ++iter, ++idx) {
         if (iter->isEmpty())
             continue;
         values.insert(QString::number(idx), *iter);
+        saved.append(*iter);
     }
 
+    // nothing changed, do not rewrite the file.
+    if (!saved.isEmpty() && saved == this->profile())
+        return true;
+
+    // clear all
+    remove(kKeyProfile, "");
+
     // save
     if (!values.isEmpty()) {
         setValues(kKeyProfile, values);
@@ -152,6 +193,18 @@ QHash<QString, QPoint> DisplayConfig::coordinates(const QString &key)
     if (key.isEmpty())
         return ret;
 
+    const auto &records = layout->values(kLayoutCoordinates + key + "/");
+    for (auto iter = records.cbegin(); iter != records.cend(); ++iter) {
+        QPoint pos;
+        if (iter.key().isEmpty() || !decodePosition(iter.value(), pos))
+            continue;
+        ret.insert(iter.key(), pos);
+    }
+
+    if (!records.isEmpty())
+        return ret;
+
+    // not migrated yet, read it from the old config.
     QMutexLocker lk(&mtxLock);
     settings->beginGroup(key);
     auto posKeys = settings->childKeys();
@@ -174,20 +227,36 @@ bool DisplayConfig::setCoordinates(const QString &key, const QHash<QString, QPoi
     if (key.isEmpty())
         return false;
 
-    // clear old data
-    remove(key, QString());
-
-    QHash<QString, QVariant> values;
+    const QString prefix = kLayoutCoordinates + key + "/";
+    QMap<QString, QByteArray> changed;
     for (auto iter = pos.cbegin(); iter != pos.cend(); ++iter) {
-        auto posKey = covertPostion(iter.value());
         // invaild pos
-        if (posKey.isEmpty() || iter.key().isEmpty())
+        if (covertPostion(iter.value()).isEmpty() || iter.key().isEmpty())
             continue;
-        values.insert(posKey, iter.key());
+        changed.insert(prefix + iter.key(), encodePosition(iter.value()));
     }
 
-    if (!values.isEmpty())
-        setValues(key, values);
+    QStringList removed;
+    const auto &records = layout->values(prefix);
+    for (auto iter = records.cbegin(); iter != records.cend(); ++iter) {
+        if (!changed.contains(prefix + iter.key()))
+            removed.append(prefix + iter.key());
+    }
+
+    // only the moved items are journaled.
+    layout->update(changed, removed);
+
+    // clear the old data that has been migrated.
+    bool legacy = false;
+    {
+        QMutexLocker lk(&mtxLock);
+        legacy = settings->childGroups().contains(key);
+    }
+
+    if (legacy)
+        remove(key, QString());
+    else
+        sync();
 
     return true;
 }
@@ -324,6 +393,15 @@ QString DisplayConfig::path() const
     return configPath;
 }
 
+QString DisplayConfig::layoutPath() const
+{
+    QString configPath = path();
+    if (configPath.endsWith(".conf"))
+        configPath.chop(5);
+
+    return configPath + ".layout";
+}
+
 bool DisplayConfig::covertPostion(const QString &strPos, QPoint &pos)
 {
     auto coords = strPos.split("_");
@@ -15,6 +15,10 @@ class QSettings;
 class QTimer;
 class QThread;
 
+namespace dfmbase {
+class JournaledStore;
+}
+
 namespace ddplugin_canvas {
 
 class DisplayConfig : public QObject
@@ -44,6 +48,7 @@ protected:
     void remove(const QString &group, const QString &key);
     void remove(const QString &group, const QStringList &keys);
     QString path() const;
+    QString layoutPath() const;
 private:
     static bool covertPostion(const QString &strPos, QPoint &pos);
     static QString covertPostion(const QPoint &pos);
@@ -52,6 +57,7 @@ private:
 
     QMutex mtxLock;
     QSettings *settings = nullptr;
+    dfmbase::JournaledStore *layout = nullptr;
     QTimer *syncTimer = nullptr;
     QThread *workThread = nullptr;
 };
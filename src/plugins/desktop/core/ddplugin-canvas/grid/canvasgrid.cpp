@@ -331,6 +331,7 @@ void CanvasGridPrivate::clean()
     posItem.clear();
     itemPos.clear();
     overload.clear();
+    clearOccupancy();
 }
 
 void CanvasGridPrivate::sequence(QStringList sortedItems)
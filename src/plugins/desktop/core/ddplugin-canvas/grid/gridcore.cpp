@@ -5,20 +5,70 @@
 #include "gridcore.h"
 #include "displayconfig.h"
 
+#include <QtAlgorithms>
+
 uint qHash(const QPoint &key, uint seed)
 {
-    QString val = QString("%1x%2").arg(key.x()).arg(key.y());
-    return qHash<QString>(val, seed);
+    return qHash(qMakePair(key.x(), key.y()), seed);
 }
 
 using namespace ddplugin_canvas;
 
+GridOccupancy::GridOccupancy(const QSize &sz)
+    : size(sz.width() > 0 && sz.height() > 0 ? sz : QSize(0, 0))
+{
+    bits.fill(0, (cells() + 63) / 64);
+}
+
+void GridOccupancy::setUsed(int cell, bool use)
+{
+    if (isUsed(cell) == use)
+        return;
+
+    quint64 &word = bits[cell >> 6];
+    const quint64 mask = Q_UINT64_C(1) << (cell & 63);
+    if (use) {
+        word |= mask;
+        ++used;
+        if (cell == cursor)
+            cursor = nextVoid(cell + 1);
+    } else {
+        word &= ~mask;
+        --used;
+        cursor = qMin(cursor, cell);
+    }
+}
+
+/*!
+ * \brief find the first void cell from \a from, a word of 64 cells is checked at a time.
+ * \return cells() if there is no void cell.
+ */
+int GridOccupancy::nextVoid(int from) const
+{
+    const int total = cells();
+    if (from >= total)
+        return total;
+
+    int w = from >> 6;
+    // the cells before \a from are regarded as used.
+    quint64 free = ~bits.at(w) & (~Q_UINT64_C(0) << (from & 63));
+    const int words = bits.size();
+    while (free == 0) {
+        if (++w >= words)
+            return total;
+        free = ~bits.at(w);
+    }
+
+    return qMin(total, (w << 6) + static_cast<int>(qCountTrailingZeroBits(free)));
+}
+
 GridCore::GridCore()
 {
 }
 
 GridCore::GridCore(const GridCore &other)
     : surfaces(other.surfaces), posItem(other.posItem), itemPos(other.itemPos), overload(other.overload)
+    , occupancies(other.occupancies)
 {
 }
 
@@ -44,38 +94,48 @@ bool GridCore::applay(GridCore *core)
     posItem = core->posItem;
     itemPos = core->itemPos;
     overload = core->overload;
+    occupancies = core->occupancies;
     return true;
 }
 
 void GridCore::insert(int index, const QPoint &pos, const QString &it)
 {
     itemPos[index].insert(it, pos);
-    posItem[index].insert(pos, it);
+    auto &items = posItem[index];
+    const int before = items.size();
+    items.insert(pos, it);
+    updateOccupancy(index, pos, true, before);
 }
 
 void GridCore::remove(int index, const QString &it)
 {
     auto pos = itemPos[index].take(it);
-    posItem[index].remove(pos);
+    auto &items = posItem[index];
+    const int before = items.size();
+    items.remove(pos);
+    updateOccupancy(index, pos, false, before);
 }
 
 void GridCore::remove(int index, const QPoint &pos)
 {
-    QString it = posItem[index].take(pos);
+    auto &items = posItem[index];
+    const int before = items.size();
+    QString it = items.take(pos);
     itemPos[index].remove(it);
+    updateOccupancy(index, pos, false, before);
 }
 
 QList<QPoint> GridCore::voidPos(int index) const
 {
     QList<QPoint> ret;
-    const QSize &size = surfaces.value(index, QSize(0, 0));
-    const QHash<QPoint, QString> &usedPos = posItem.value(index);
-    for (int x = 0; x < size.width(); ++x)
-        for (int y = 0; y < size.height(); ++y) {
-            QPoint pos(x, y);
-            if (!usedPos.contains(pos))
-                ret.append(pos);
-        }
+    const GridOccupancy &occ = occupancy(index);
+    const int total = occ.cells();
+    if (occ.used >= total)
+        return ret;
+
+    ret.reserve(total - occ.used);
+    for (int cell = occ.nextVoid(occ.cursor); cell < total; cell = occ.nextVoid(cell + 1))
+        ret.append(occ.point(cell));
 
     return ret;
 }
@@ -83,23 +143,16 @@ QList<QPoint> GridCore::voidPos(int index) const
 bool GridCore::findVoidPos(GridPos &pos) const
 {
     for (int idx : surfaceIndex()) {
-        const QHash<QPoint, QString> &usedPos = posItem.value(idx);
-        const QSize &size = surfaces.value(idx);
+        const GridOccupancy &occ = occupancy(idx);
 
         // no void pos
-        if (isFull(idx))
+        if (occ.cursor >= occ.cells())
             continue;
 
-        // find first void pos.
-        for (int x = 0; x < size.width(); ++x)
-            for (int y = 0; y < size.height(); ++y) {
-                QPoint curPos(x, y);
-                if (!usedPos.contains(curPos)) {
-                    pos.first = idx;
-                    pos.second = curPos;
-                    return true;
-                }
-            }
+        // the cursor is the first void pos.
+        pos.first = idx;
+        pos.second = occ.point(occ.cursor);
+        return true;
     }
 
     return false;
@@ -107,10 +160,61 @@ bool GridCore::findVoidPos(GridPos &pos) const
 
 bool GridCore::isFull(int index) const
 {
-    const QSize &size = surfaces.value(index, QSize(0, 0));
-    int itemCount = posItem.value(index).count();
+    const GridOccupancy &occ = occupancy(index);
+    return occ.used >= occ.cells();
+}
 
-    return itemCount >= size.width() * size.height();
+/*!
+ * \brief the occupancy bitmap of surface \a index.
+ * It is kept by insert and remove, and is rebuilt if the surface is resized
+ * or posItem is changed directly.
+ */
+const GridOccupancy &GridCore::occupancy(int index) const
+{
+    const QSize &size = surfaceSize(index);
+    const auto used = posItem.find(index);
+    const int items = used == posItem.end() ? 0 : used->size();
+
+    auto itor = occupancies.find(index);
+    if (itor != occupancies.end() && itor->size == size && itor->items == items)
+        return itor.value();
+
+    GridOccupancy occ(size);
+    if (used != posItem.end()) {
+        for (auto pos = used->keyBegin(); pos != used->keyEnd(); ++pos) {
+            if (CanvasGridSpecialist::isValid(*pos, occ.size))
+                occ.setUsed(occ.cell(*pos), true);
+        }
+    }
+    occ.items = items;
+    return occupancies.insert(index, occ).value();
+}
+
+/*!
+ * \brief drop all occupancy bitmaps, it must be called when posItem is reset
+ * without changing its size.
+ */
+void GridCore::clearOccupancy()
+{
+    occupancies.clear();
+}
+
+void GridCore::updateOccupancy(int index, const QPoint &pos, bool used, int before)
+{
+    auto itor = occupancies.find(index);
+    if (itor == occupancies.end())
+        return;
+
+    GridOccupancy &occ = itor.value();
+    if (occ.size != surfaceSize(index) || occ.items != before) {
+        // out of date, it will be rebuilt on using.
+        occupancies.erase(itor);
+        return;
+    }
+
+    occ.items = posItem.value(index).size();
+    if (occ.items != before && CanvasGridSpecialist::isValid(pos, occ.size))
+        occ.setUsed(occ.cell(pos), used);
 }
 
 bool GridCore::position(const QString &it, GridPos &pos) const
@@ -143,7 +247,10 @@ void GridCore::removeAll(const QStringList &items)
             if (!itemPos[index].contains(it))
                 continue;
             auto pos = itemPos[index].take(it);
-            posItem[index].remove(pos);
+            auto &items = posItem[index];
+            const int before = items.size();
+            items.remove(pos);
+            updateOccupancy(index, pos, false, before);
         }
     }
 }
@@ -245,18 +352,24 @@ QStringList AppendOper::appendAfter(QStringList items, int index, const QPoint &
     if (items.isEmpty())
         return items;
 
-    QList<QPoint> posList = voidPos(index);
-    for (const QPoint &pos : posList) {
-        if ((pos.x() > begin.x())
-            || (pos.x() == begin.x() && pos.y() >= begin.y())
-            || DisplayConfig::instance()->autoAlign()) {
-            // all items is appenped
-            if (items.isEmpty())
-                return items;
-
-            QString &&item = items.takeFirst();
-            insert(index, pos, item);
-        }
+    // the first cell at or after \a begin, all void pos are available if auto aligned.
+    int from = 0;
+    if (!DisplayConfig::instance()->autoAlign()) {
+        const int height = surfaceSize(index).height();
+        from = begin.y() < height ? begin.x() * height + qMax(0, begin.y())
+                                  : (begin.x() + 1) * height;
+        from = qMax(0, from);
+    }
+
+    while (!items.isEmpty()) {
+        const GridOccupancy &occ = occupancy(index);
+        const int cell = occ.nextVoid(qMax(from, occ.cursor));
+        if (cell >= occ.cells())
+            break;
+
+        QString &&item = items.takeFirst();
+        insert(index, occ.point(cell), item);
+        from = cell + 1;
     }
 
     return items;
@@ -265,15 +378,19 @@ QStringList AppendOper::appendAfter(QStringList items, int index, const QPoint &
 void AppendOper::append(QStringList items)
 {
     for (int idx : surfaceIndex()) {
-        auto posList = voidPos(idx);
-        for (const QPoint &pos : posList) {
-            // all items is appenped
-            if (items.isEmpty())
-                return;
+        // the cursor moves to the next void pos after inserting.
+        while (!items.isEmpty()) {
+            const GridOccupancy &occ = occupancy(idx);
+            if (occ.cursor >= occ.cells())
+                break;
 
             QString &&it = items.takeFirst();
-            insert(idx, pos, it);
+            insert(idx, occ.point(occ.cursor), it);
         }
+
+        // all items is appenped
+        if (items.isEmpty())
+            return;
     }
 
     // overload
@@ -9,12 +9,38 @@
 
 #include <QMap>
 #include <QSize>
+#include <QVector>
 
 extern uint qHash(const QPoint &key, uint seed);
 
 namespace ddplugin_canvas {
 
 typedef QPair<int, QPoint> GridPos;
+
+/*!
+ * \brief The GridOccupancy class is the occupancy bitmap of a surface.
+ * The cells are ordered column by column as the items are arranged, the cell of
+ * (x, y) is x * height + y. \a cursor is the first void cell.
+ */
+class GridOccupancy
+{
+public:
+    GridOccupancy() {}
+    explicit GridOccupancy(const QSize &size);
+    inline int cells() const { return size.width() * size.height(); }
+    inline int cell(const QPoint &pos) const { return pos.x() * size.height() + pos.y(); }
+    inline QPoint point(int cell) const { return QPoint(cell / size.height(), cell % size.height()); }
+    inline bool isUsed(int cell) const { return bits.at(cell >> 6) & (Q_UINT64_C(1) << (cell & 63)); }
+    void setUsed(int cell, bool used);
+    int nextVoid(int from) const;
+public:
+    QSize size { 0, 0 };
+    QVector<quint64> bits;
+    int used = 0;
+    int cursor = 0;
+    int items = 0;   // the count of posItem it was built from.
+};
+
 class GridCore
 {
 protected:
@@ -34,6 +60,10 @@ public:
     virtual bool position(const QString &item, GridPos &pos) const;
     virtual QString item(const GridPos &pos) const;
     virtual void removeAll(const QStringList &items);
+    const GridOccupancy &occupancy(int index) const;
+    void clearOccupancy();
+protected:
+    void updateOccupancy(int index, const QPoint &pos, bool used, int before);
 public:
     inline QSize surfaceSize(int index) const {
         return surfaces.value(index, QSize(0, 0));
@@ -55,6 +85,9 @@ public:
     QMap<int, QHash<QPoint, QString>> posItem;
     QMap<int, QHash<QString, QPoint>> itemPos;
     QStringList overload;
+private:
+    // rebuilt from posItem when it is changed out of insert and remove.
+    mutable QMap<int, GridOccupancy> occupancies;
 };
 
 class MoveGridOper : public GridCore
@@ -96,15 +96,26 @@ void CanvasProxyModelPrivate::sourceRowsAboutToBeRemoved(const QModelIndex &sour
     if (files.isEmpty())
         return;
 
-    // remove one by one
+    QList<int> rows;
+    rows.reserve(files.size());
     for (const QUrl &url : files) {
-        int row = fileList.indexOf(url);
-        if (row < 0)
-            continue;
-
-        q->beginRemoveRows(q->rootIndex(), row, row);
-        fileList.removeAt(row);
-        fileMap.remove(url);
+        int row = rowOf(url);
+        if (row >= 0)
+            rows.append(row);
+    }
+    std::sort(rows.begin(), rows.end());
+
+    // remove the continuous rows at once, from the bottom to keep the upper rows valid.
+    int idx = rows.size() - 1;
+    while (idx >= 0) {
+        const int last = rows.at(idx);
+        int first = last;
+        while (idx > 0 && rows.at(idx - 1) == first - 1)
+            first = rows.at(--idx);
+        --idx;
+
+        q->beginRemoveRows(q->rootIndex(), first, last);
+        removeRows(first, last - first + 1);
         q->endRemoveRows();
     }
 }
@@ -114,12 +125,11 @@ void CanvasProxyModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &
     // canvas filter
     bool ignore = renameFilter(oldUrl, newUrl);
 
-    int row = fileList.indexOf(oldUrl);
+    int row = rowOf(oldUrl);
     if (ignore) {
         if (row >= 0) {
             q->beginRemoveRows(q->rootIndex(), row, row);
-            fileList.removeAt(row);
-            fileMap.remove(oldUrl);
+            removeRows(row, 1);
             q->endRemoveRows();
         }
         return;
@@ -140,15 +150,17 @@ void CanvasProxyModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &
         if (fileMap.contains(newUrl)) {
             //! treat as removing if newurl is existed in canvas.
             q->beginRemoveRows(q->rootIndex(), row, row);
-            fileList.removeAt(row);
-            fileMap.remove(oldUrl);
+            removeRows(row, 1);
             q->endRemoveRows();
 
-            row = fileList.indexOf(newUrl);
+            row = rowOf(newUrl);
         } else {
             fileList.replace(row, newUrl);
             fileMap.remove(oldUrl);
             fileMap.insert(newUrl, newInfo);
+            fileRows.remove(oldUrl);
+            if (row < numberedRows)
+                fileRows.insert(newUrl, row);
             emit q->dataReplaced(oldUrl, newUrl);
         }
 
@@ -332,6 +344,58 @@ void CanvasProxyModelPrivate::clearMapping()
 {
     fileList.clear();
     fileMap.clear();
+    resetRows();
+}
+
+/*!
+ * \brief the row of \a url, the unnumbered rows are indexed at the first lookup after a change.
+ */
+int CanvasProxyModelPrivate::rowOf(const QUrl &url) const
+{
+    auto it = fileRows.constFind(url);
+    if (it != fileRows.constEnd()) {
+        const int row = it.value();
+        if (row < fileList.size() && fileList.at(row) == url)
+            return row;
+
+        // the list was changed without updating the rows.
+        if (row < numberedRows)
+            numberedRows = 0;
+    }
+
+    if (numberedRows > fileList.size())
+        numberedRows = 0;
+    if (numberedRows == 0)
+        fileRows.clear();
+
+    for (int i = numberedRows; i < fileList.size(); ++i)
+        fileRows.insert(fileList.at(i), i);
+    numberedRows = fileList.size();
+
+    const int row = fileRows.value(url, -1);
+    if (row >= 0 && fileList.at(row) == url)
+        return row;
+
+    fileRows.remove(url);
+    return -1;
+}
+
+void CanvasProxyModelPrivate::resetRows()
+{
+    fileRows.clear();
+    numberedRows = 0;
+}
+
+void CanvasProxyModelPrivate::removeRows(int first, int count)
+{
+    for (int i = first; i < first + count; ++i) {
+        const QUrl &url = fileList.at(i);
+        fileMap.remove(url);
+        fileRows.remove(url);
+    }
+
+    fileList.erase(fileList.begin() + first, fileList.begin() + first + count);
+    numberedRows = qMin(numberedRows, first);
 }
 
 void CanvasProxyModelPrivate::createMapping()
@@ -345,13 +409,14 @@ void CanvasProxyModelPrivate::createMapping()
     resetFilter(urls);
 
     // sort
-    QMap<QUrl, FileInfoPointer> maps;
+    QHash<QUrl, FileInfoPointer> maps;
     for (const QUrl &url : urls)
         maps.insert(url, srcModel->fileInfo(srcModel->index(url)));
 
     // set unsorted files into model to enable create module index that doSort will used.
     fileList = urls;
     fileMap = maps;
+    resetRows();
 
     doSort(urls);
 
@@ -364,6 +429,7 @@ void CanvasProxyModelPrivate::createMapping()
 
     fileList = urls;
     fileMap = maps;
+    resetRows();
 }
 
 QModelIndexList CanvasProxyModelPrivate::indexs() const
@@ -471,8 +537,9 @@ QModelIndex CanvasProxyModel::index(const QUrl &url, int column) const
         return QModelIndex();
 
     if (d->fileMap.contains(url)) {
-        int row = d->fileList.indexOf(url);
-        return createIndex(row, column);
+        int row = d->rowOf(url);
+        if (row >= 0)
+            return createIndex(row, column);
     }
 
     return QModelIndex();
@@ -799,7 +866,7 @@ bool CanvasProxyModel::sort()
     if (d->fileList.isEmpty())
         return true;
 
-    QMap<QUrl, FileInfoPointer> tempFileMap;
+    QHash<QUrl, FileInfoPointer> tempFileMap;
     QList<QUrl> orderFiles = d->fileList;
     if (!d->doSort(orderFiles))
         return false;
@@ -815,6 +882,7 @@ bool CanvasProxyModel::sort()
 
         d->fileList = orderFiles;
         d->fileMap = tempFileMap;
+        d->resetRows();
 
         // get the indexs of fromUlrs after sorting
         QModelIndexList to = d->indexs(fromUlrs);
@@ -898,15 +966,14 @@ bool CanvasProxyModel::take(const QUrl &url)
     // canvas filter
     d->removeFilter(url);
 
-    int row = d->fileList.indexOf(url);
+    int row = d->rowOf(url);
     if (Q_UNLIKELY(row < 0)) {
         fmCritical() << "invaild index of" << url;
         return false;
     }
 
     beginRemoveRows(rootIndex(), row, row);
-    d->fileList.removeAt(row);
-    d->fileMap.remove(url);
+    d->removeRows(row, 1);
     endRemoveRows();
     return true;
 }
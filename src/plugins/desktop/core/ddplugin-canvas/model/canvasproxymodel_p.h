@@ -27,6 +27,9 @@ public:
     QModelIndexList indexs(const QList<QUrl> &files) const;
     bool doSort(QList<QUrl> &files) const;
     bool lessThan(const QUrl &left, const QUrl &right) const;
+    int rowOf(const QUrl &url) const;
+    void resetRows();
+    void removeRows(int first, int count);
 public slots:
     void doRefresh(bool global, bool updateFile);
     void sourceDataChanged(const QModelIndex &sourceTopleft,
@@ -59,7 +62,10 @@ private:
 public:
     QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System;
     QList<QUrl> fileList;
-    QMap<QUrl, FileInfoPointer> fileMap;
+    QHash<QUrl, FileInfoPointer> fileMap;
+    // the rows of the urls, the rows before numberedRows are exact and the others are refreshed on demand.
+    mutable QHash<QUrl, int> fileRows;
+    mutable int numberedRows = 0;
     FileInfoModel *srcModel = nullptr;
     QSharedPointer<QTimer> refreshTimer;
     int fileSortRole = DFMGLOBAL_NAMESPACE::ItemRoles::kItemFileMimeTypeRole;
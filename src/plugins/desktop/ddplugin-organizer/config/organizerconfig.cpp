@@ -11,6 +11,7 @@
 #include <QApplication>
 #include <QFileInfo>
 #include <QDir>
+#include <QSet>
 #include <QDebug>
 
 using namespace ddplugin_organizer;
@@ -44,6 +45,36 @@ inline constexpr char kKeyCustomGeo[] { "CustomGeometry" };
 inline constexpr char kGroupClassifierType[] { "Classifier_Type" };
 inline constexpr char kKeyEnabledItems[] { "EnabledItems" };
 
+// the items of collections are saved in the journaled store, keyed by "items/<mode>/<collection key>".
+inline QString itemsPrefix(bool custom)
+{
+    return custom ? QStringLiteral("items/customed/") : QStringLiteral("items/normalized/");
+}
+
+inline QByteArray encodeItems(const QList<QUrl> &urls)
+{
+    QStringList strs;
+    strs.reserve(urls.size());
+    for (const QUrl &url : urls)
+        strs.append(url.toString());
+    return strs.join('\n').toUtf8();
+}
+
+inline QList<QUrl> decodeItems(const QByteArray &data)
+{
+    QList<QUrl> ret;
+    if (data.isEmpty())
+        return ret;
+
+    const QStringList &strs = QString::fromUtf8(data).split('\n');
+    for (const QString &str : strs) {
+        QUrl url(str);
+        if (url.isValid())
+            ret.append(url);
+    }
+    return ret;
+}
+
 }   // namepace
 
 OrganizerConfigPrivate::OrganizerConfigPrivate(OrganizerConfig *qq)
@@ -55,6 +86,9 @@ OrganizerConfigPrivate::~OrganizerConfigPrivate()
 {
     delete settings;
     settings = nullptr;
+
+    delete items;
+    items = nullptr;
 }
 
 QVariant OrganizerConfigPrivate::value(const QString &group, const QString &key, const QVariant &defaultVar)
@@ -81,6 +115,26 @@ void OrganizerConfigPrivate::setValue(const QString &group, const QString &key,
     settings->endGroup();
 }
 
+/*!
+ * \brief write \a base in the current group, the keys are written only if they are changed
+ * and the items are collected in \a items to be journaled.
+ */
+void OrganizerConfigPrivate::writeBase(const CollectionBaseDataPtr &base, QMap<QString, QByteArray> *items, const QString &itemsPrefix)
+{
+    settings->beginGroup(base->key);
+    if (settings->value(kKeyName).toString() != base->name)
+        settings->setValue(kKeyName, base->name);
+    if (settings->value(kKeyKey).toString() != base->key)
+        settings->setValue(kKeyKey, base->key);
+
+    // the old items have been migrated.
+    if (settings->childGroups().contains(kGroupItems))
+        settings->remove(kGroupItems);
+    settings->endGroup();
+
+    items->insert(itemsPrefix + base->key, encodeItems(base->items));
+}
+
 OrganizerConfig::OrganizerConfig(QObject *parent)
     : QObject(parent), d(new OrganizerConfigPrivate(this))
 {
@@ -96,10 +150,17 @@ OrganizerConfig::OrganizerConfig(QObject *parent)
 
     d->settings = new QSettings(configPath, QSettings::IniFormat);
 
+    QString itemsPath = configPath;
+    if (itemsPath.endsWith(".conf"))
+        itemsPath.chop(5);
+    d->items = new DFMBASE_NAMESPACE::JournaledStore(itemsPath + ".layout");
+
     // delay sync
     d->syncTimer.setSingleShot(true);
     connect(&d->syncTimer, &QTimer::timeout, this, [this]() {
         d->settings->sync();
+        if (d->items->needCompact())
+            d->items->compact();
     },
             Qt::QueuedConnection);
 }
@@ -156,9 +217,11 @@ void OrganizerConfig::setScreenInfo(const QMap<QString, QString> info)
 
 void OrganizerConfig::sync(int ms)
 {
-    if (ms < 1)
+    if (ms < 1) {
         d->settings->sync();
-    else
+        if (d->items->needCompact())
+            d->items->compact();
+    } else
         d->syncTimer.start(ms);
 }
 
@@ -199,7 +262,11 @@ CollectionBaseDataPtr OrganizerConfig::collectionBase(bool custom, const QString
     base->name = d->settings->value(kKeyName, "").toString();
     base->key = d->settings->value(kKeyKey, "").toString();
 
-    {
+    const QString itemsKey = itemsPrefix(custom) + key;
+    if (d->items->contains(itemsKey)) {
+        base->items = decodeItems(d->items->value(itemsKey));
+    } else {
+        // not migrated yet, read the items from the old config.
         d->settings->beginGroup(kGroupItems);
         auto keys = d->settings->childKeys();
         // must be sorted by int value
@@ -229,63 +296,48 @@ CollectionBaseDataPtr OrganizerConfig::collectionBase(bool custom, const QString
 
 void OrganizerConfig::updateCollectionBase(bool custom, const CollectionBaseDataPtr &base)
 {
+    QMap<QString, QByteArray> items;
     d->settings->beginGroup(custom ? kGroupCollectionCustomed : kGroupCollectionNormalized);
     d->settings->beginGroup(kGroupCollectionBase);
-    // delete old datas
-    d->settings->remove(base->key);
-
-    d->settings->beginGroup(base->key);
-    d->settings->setValue(kKeyName, base->name);
-    d->settings->setValue(kKeyKey, base->key);
-
-    {
-        d->settings->beginGroup(kGroupItems);
-
-        int index = 0;
-        for (auto iter = base->items.begin(); iter != base->items.end();) {
-            d->settings->setValue(QString::number(index), iter->toString());
-            ++index;
-            ++iter;
-        }
-
-        d->settings->endGroup();
-    }
-
-    d->settings->endGroup();
+    d->writeBase(base, &items, itemsPrefix(custom));
     d->settings->endGroup();
     d->settings->endGroup();
+
+    // the store skips the unchanged items.
+    d->items->update(items, {});
 }
 
 void OrganizerConfig::writeCollectionBase(bool custom, const QList<CollectionBaseDataPtr> &base)
 {
+    QSet<QString> keys;
+    for (const CollectionBaseDataPtr &ptr : base)
+        keys.insert(ptr->key);
+
+    QMap<QString, QByteArray> items;
     d->settings->beginGroup(custom ? kGroupCollectionCustomed : kGroupCollectionNormalized);
-    // delete all old datas
-    d->settings->remove(kGroupCollectionBase);
     d->settings->beginGroup(kGroupCollectionBase);
 
-    for (auto iter = base.begin(); iter != base.end(); ++iter) {
-        d->settings->beginGroup((*iter)->key);
-        d->settings->setValue(kKeyName, (*iter)->name);
-        d->settings->setValue(kKeyKey, (*iter)->key);
-
-        {
-            d->settings->beginGroup(kGroupItems);
+    // delete the removed collections
+    for (const QString &key : d->settings->childGroups()) {
+        if (!keys.contains(key))
+            d->settings->remove(key);
+    }
 
-            int index = 0;
-            for (auto it = (*iter)->items.begin(); it != (*iter)->items.end();) {
-                d->settings->setValue(QString::number(index), it->toString());
-                ++index;
-                ++it;
-            }
+    for (auto iter = base.begin(); iter != base.end(); ++iter)
+        d->writeBase(*iter, &items, itemsPrefix(custom));
 
-            d->settings->endGroup();
-        }
+    d->settings->endGroup();
+    d->settings->endGroup();
 
-        d->settings->endGroup();
+    QStringList removed;
+    const QString &prefix = itemsPrefix(custom);
+    const auto &olds = d->items->values(prefix);
+    for (auto iter = olds.cbegin(); iter != olds.cend(); ++iter) {
+        if (!keys.contains(iter.key()))
+            removed.append(prefix + iter.key());
     }
 
-    d->settings->endGroup();
-    d->settings->endGroup();
+    d->items->update(items, removed);
 }
 
 CollectionStyle OrganizerConfig::collectionStyle(bool custom, const QString &key) const
@@ -7,6 +7,8 @@
 
 #include "organizerconfig.h"
 
+#include <dfm-base/utils/journaledstore.h>
+
 #include <QSettings>
 #include <QTimer>
 
@@ -19,7 +21,9 @@ public:
     ~OrganizerConfigPrivate();
     QVariant value(const QString &group, const QString &key, const QVariant &defaultVar);
     void setValue(const QString &group, const QString &key, const QVariant &var);
+    void writeBase(const CollectionBaseDataPtr &base, QMap<QString, QByteArray> *items, const QString &itemsPrefix);
     QSettings *settings = nullptr;
+    dfmbase::JournaledStore *items = nullptr;
     QTimer syncTimer;
 private:
     OrganizerConfig *q;
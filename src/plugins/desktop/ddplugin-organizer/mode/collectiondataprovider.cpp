@@ -64,6 +64,15 @@ bool CollectionDataProvider::contains(const QString &key, const QUrl &url) const
     return (*it)->items.contains(url);
 }
 
+int CollectionDataProvider::indexOf(const QString &key, const QUrl &url) const
+{
+    auto it = collections.find(key);
+    if (it == collections.end())
+        return -1;
+
+    return (*it)->items.indexOf(url);
+}
+
 bool CollectionDataProvider::sorted(const QString &key, const QList<QUrl> &urls)
 {
     auto it = collections.find(key);
@@ -99,37 +108,21 @@ void CollectionDataProvider::moveUrls(const QList<QUrl> &urls, const QString &ta
         // same collection
         auto it = collections.find(sourceId);
         if (it != collections.end()) {
-            for (auto url : urls) {
-                int oldIndex = it.value()->items.indexOf(url);
-                if (-1 == oldIndex) {
-                    fmWarning() << "unknow error:" << url << it.value()->items;
-                    continue;
-                }
-                if (oldIndex < targetIndex)
-                    targetIndex--;
-                it.value()->items.removeOne(url);
-            }
-            for (auto url : urls) {
-                it.value()->items.insert(targetIndex++, url);
-            }
+            it.value()->items.move(urls, targetIndex);
             emit itemsChanged(sourceId);
         }
     } else {
         // collection to other collection
         auto it = collections.find(sourceId);
         if (it != collections.end()) {
-            for (auto url : urls) {
-                it.value()->items.removeOne(url);
-            }
+            it.value()->items.remove(urls);
             emit itemsChanged(sourceId);
         } else {
             fmWarning() << "can not found :" << sourceId;
         }
         it = collections.find(targetKey);
         if (it != collections.end()) {
-            for (auto url : urls) {
-                it.value()->items.insert(targetIndex++, url);
-            }
+            it.value()->items.insert(targetIndex, urls);
             emit itemsChanged(targetKey);
         }
     }
@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "collectionitems.h"
+
+#include <QSet>
+
+using namespace ddplugin_organizer;
+
+CollectionItems::CollectionItems(const QList<QUrl> &urls)
+{
+    *this = urls;
+}
+
+CollectionItems &CollectionItems::operator=(const QList<QUrl> &urls)
+{
+    clear();
+    list.reserve(urls.size());
+    positions.reserve(urls.size());
+    for (const QUrl &url : urls)
+        append(url);
+
+    return *this;
+}
+
+int CollectionItems::indexOf(const QUrl &url) const
+{
+    auto it = positions.constFind(url);
+    if (it == positions.constEnd())
+        return -1;
+
+    if (it.value() < numbered)
+        return it.value();
+
+    renumber();
+    return positions.value(url, -1);
+}
+
+void CollectionItems::append(const QUrl &url)
+{
+    if (positions.contains(url))
+        return;
+
+    const int index = list.size();
+    list.append(url);
+    positions.insert(url, index);
+
+    // keep the positions exact if they were.
+    if (numbered == index)
+        numbered = index + 1;
+}
+
+void CollectionItems::insert(int index, const QUrl &url)
+{
+    index = qBound(0, index, list.size());
+    if (index == list.size()) {
+        append(url);
+        return;
+    }
+
+    if (positions.contains(url))
+        return;
+
+    list.insert(index, url);
+    positions.insert(url, index);
+    invalidate(index);
+}
+
+void CollectionItems::replace(int index, const QUrl &url)
+{
+    if (index < 0 || index >= list.size() || list.at(index) == url)
+        return;
+
+    // the url must be held once.
+    const int other = indexOf(url);
+    if (other >= 0) {
+        removeAt(other);
+        if (other < index)
+            --index;
+    }
+
+    positions.remove(list.at(index));
+    list.replace(index, url);
+    positions.insert(url, index);
+}
+
+bool CollectionItems::removeOne(const QUrl &url)
+{
+    const int index = indexOf(url);
+    if (index < 0)
+        return false;
+
+    removeAt(index);
+    return true;
+}
+
+void CollectionItems::removeAt(int index)
+{
+    if (index < 0 || index >= list.size())
+        return;
+
+    positions.remove(list.at(index));
+    list.removeAt(index);
+    invalidate(index);
+}
+
+void CollectionItems::clear()
+{
+    list.clear();
+    positions.clear();
+    numbered = 0;
+}
+
+void CollectionItems::insert(int index, const QList<QUrl> &urls)
+{
+    index = qBound(0, index, list.size());
+    QList<QUrl> fresh;
+    fresh.reserve(urls.size());
+    for (const QUrl &url : urls) {
+        if (positions.contains(url))
+            continue;
+        // it is renumbered on the next lookup.
+        positions.insert(url, index);
+        fresh.append(url);
+    }
+
+    if (fresh.isEmpty())
+        return;
+
+    QList<QUrl> merged;
+    merged.reserve(list.size() + fresh.size());
+    merged.append(list.mid(0, index));
+    merged.append(fresh);
+    merged.append(list.mid(index));
+    list = merged;
+    invalidate(index);
+}
+
+int CollectionItems::remove(const QList<QUrl> &urls)
+{
+    QSet<QUrl> removed;
+    for (const QUrl &url : urls) {
+        if (positions.remove(url))
+            removed.insert(url);
+    }
+
+    if (removed.isEmpty())
+        return 0;
+
+    int first = list.size();
+    QList<QUrl> kept;
+    kept.reserve(list.size() - removed.size());
+    for (int i = 0; i < list.size(); ++i) {
+        if (removed.contains(list.at(i)))
+            first = qMin(first, i);
+        else
+            kept.append(list.at(i));
+    }
+
+    list = kept;
+    invalidate(first);
+    return removed.size();
+}
+
+/*!
+ * \brief move \a urls to \a index in their order, \a index is the position before moving.
+ * The urls not in the collection are ignored.
+ */
+void CollectionItems::move(const QList<QUrl> &urls, int index)
+{
+    QList<QUrl> moving;
+    QSet<QUrl> moved;
+    for (const QUrl &url : urls) {
+        if (positions.contains(url) && !moved.contains(url)) {
+            moving.append(url);
+            moved.insert(url);
+        }
+    }
+
+    if (moving.isEmpty())
+        return;
+
+    int first = list.size();
+    int target = index;
+    QList<QUrl> kept;
+    kept.reserve(list.size());
+    for (int i = 0; i < list.size(); ++i) {
+        if (moved.contains(list.at(i))) {
+            first = qMin(first, i);
+            if (i < index)
+                --target;
+        } else {
+            kept.append(list.at(i));
+        }
+    }
+
+    target = qBound(0, target, kept.size());
+    for (const QUrl &url : moving)
+        positions.insert(url, target);
+
+    list = kept.mid(0, target);
+    list.append(moving);
+    list.append(kept.mid(target));
+    invalidate(qMin(first, target));
+}
+
+void CollectionItems::invalidate(int index) const
+{
+    numbered = qMin(numbered, index);
+}
+
+void CollectionItems::renumber() const
+{
+    for (int i = numbered; i < list.size(); ++i)
+        positions.insert(list.at(i), i);
+
+    numbered = list.size();
+}
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef COLLECTIONITEMS_H
+#define COLLECTIONITEMS_H
+
+#include "ddplugin_organizer_global.h"
+
+#include <QList>
+#include <QHash>
+#include <QUrl>
+
+namespace ddplugin_organizer {
+
+/*!
+ * \brief The CollectionItems class is the ordered urls of a collection with a hash index.
+ * The membership is checked by the hash. The position in the hash is renumbered lazily:
+ * it is exact before the first index changed since the last lookup, appending keeps it.
+ * An url is held at most once, inserting an existed url is ignored.
+ */
+class CollectionItems
+{
+public:
+    typedef QList<QUrl>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
+    CollectionItems() = default;
+    CollectionItems(const QList<QUrl> &urls);
+    CollectionItems &operator=(const QList<QUrl> &urls);
+    inline operator QList<QUrl>() const { return list; }
+    inline const QList<QUrl> &toList() const { return list; }
+
+    inline int size() const { return list.size(); }
+    inline int count() const { return list.size(); }
+    inline bool isEmpty() const { return list.isEmpty(); }
+    inline const QUrl &at(int i) const { return list.at(i); }
+    inline const QUrl &first() const { return list.first(); }
+    inline const QUrl &last() const { return list.last(); }
+    inline const_iterator begin() const { return list.constBegin(); }
+    inline const_iterator end() const { return list.constEnd(); }
+    inline const_iterator constBegin() const { return list.constBegin(); }
+    inline const_iterator constEnd() const { return list.constEnd(); }
+
+    inline bool contains(const QUrl &url) const { return positions.contains(url); }
+    int indexOf(const QUrl &url) const;
+
+    void append(const QUrl &url);
+    inline void append(const QList<QUrl> &urls) { insert(list.size(), urls); }
+    inline void push_back(const QUrl &url) { append(url); }
+    inline CollectionItems &operator<<(const QUrl &url) { append(url); return *this; }
+    inline void prepend(const QUrl &url) { insert(0, url); }
+    void insert(int index, const QUrl &url);
+    void replace(int index, const QUrl &url);
+    bool removeOne(const QUrl &url);
+    inline int removeAll(const QUrl &url) { return removeOne(url) ? 1 : 0; }
+    void removeAt(int index);
+    void clear();
+
+    // batch, each costs one pass over the items
+    void insert(int index, const QList<QUrl> &urls);
+    int remove(const QList<QUrl> &urls);
+    void move(const QList<QUrl> &urls, int index);
+
+private:
+    void invalidate(int index) const;
+    void renumber() const;
+
+private:
+    QList<QUrl> list;
+    mutable QHash<QUrl, int> positions;
+    mutable int numbered = 0;   // the positions before it are exact.
+};
+
+inline bool operator==(const CollectionItems &items, const QList<QUrl> &urls)
+{
+    return items.toList() == urls;
+}
+
+inline bool operator==(const CollectionItems &t1, const CollectionItems &t2)
+{
+    return t1.toList() == t2.toList();
+}
+
+}
+
+#endif   // COLLECTIONITEMS_H
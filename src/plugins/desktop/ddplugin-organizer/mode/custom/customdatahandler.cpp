@@ -23,13 +23,12 @@ CustomDataHandler::~CustomDataHandler()
 void CustomDataHandler::check(const QSet<QUrl> &vaild)
 {
     for (auto iter = collections.begin(); iter != collections.end(); ++iter) {
-        for (auto it = iter.value()->items.begin(); it != iter.value()->items.end();) {
-            if (vaild.contains(*it)) {
-                ++it;
-            } else {
-                it = iter.value()->items.erase(it);
-            }
+        QList<QUrl> invalid;
+        for (const QUrl &url : iter.value()->items) {
+            if (!vaild.contains(url))
+                invalid.append(url);
         }
+        iter.value()->items.remove(invalid);
     }
 }
 
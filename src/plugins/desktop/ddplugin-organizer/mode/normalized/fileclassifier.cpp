@@ -43,8 +43,11 @@ void FileClassifier::reset(const QList<QUrl> &urls)
         collections.insert(id, dp);
     }
 
-    for (const QUrl &url : urls) {
-        auto type = classify(url);
+    const QStringList &types = classifyAll(urls);
+    Q_ASSERT(types.size() == urls.size());
+    for (int i = 0; i < urls.size(); ++i) {
+        const QUrl &url = urls.at(i);
+        const QString &type = types.at(i);
         if (type.isEmpty()) {
             fmWarning() << "can not find file:" << url;
             continue;
@@ -58,6 +61,19 @@ void FileClassifier::reset(const QList<QUrl> &urls)
     }
 }
 
+/*!
+ * \brief classify \a urls in one call, the result is in the same order.
+ */
+QStringList FileClassifier::classifyAll(const QList<QUrl> &urls) const
+{
+    QStringList types;
+    types.reserve(urls.size());
+    for (const QUrl &url : urls)
+        types.append(classify(url));
+
+    return types;
+}
+
 QList<CollectionBaseDataPtr> FileClassifier::baseData() const
 {
     return collections.values();
@@ -69,9 +85,13 @@ CollectionBaseDataPtr FileClassifier::baseData(const QString &key) const
 }
 
 QString FileClassifier::replace(const QUrl &oldUrl, const QUrl &newUrl)
+{
+    return doReplace(oldUrl, newUrl, classify(newUrl));
+}
+
+QString FileClassifier::doReplace(const QUrl &oldUrl, const QUrl &newUrl, const QString &newType)
 {
     QString oldType = key(oldUrl);
-    QString newType = classify(newUrl);
     QString newKey = key(newUrl);
 #if 1
     //! the newUrl must be not existed,
@@ -144,7 +164,12 @@ QString FileClassifier::replace(const QUrl &oldUrl, const QUrl &newUrl)
 
 QString FileClassifier::append(const QUrl &url)
 {
-    QString ret = classify(url);
+    return doAppend(url, classify(url));
+}
+
+QString FileClassifier::doAppend(const QUrl &url, const QString &type)
+{
+    QString ret = type;
     if (ret.isEmpty()) {
         fmWarning() << "can not find file:" << url;
         return ret;
@@ -176,7 +201,12 @@ QString FileClassifier::append(const QUrl &url)
 
 QString FileClassifier::prepend(const QUrl &url)
 {
-    QString ret = classify(url);
+    return doPrepend(url, classify(url));
+}
+
+QString FileClassifier::doPrepend(const QUrl &url, const QString &type)
+{
+    QString ret = type;
     if (ret.isEmpty()) {
         fmWarning() << "can not find file:" << url;
         return ret;
@@ -32,6 +32,7 @@ public:
     virtual ModelDataHandler *dataHandler() const = 0;
     virtual QStringList classes() const = 0;
     virtual QString classify(const QUrl &) const = 0;
+    virtual QStringList classifyAll(const QList<QUrl> &urls) const;
     virtual QString className(const QString &) const = 0;
     virtual void reset(const QList<QUrl> &);
     virtual void updateClassifier() = 0;
@@ -51,6 +52,12 @@ public:
 public:
     bool acceptInsert(const QUrl &url) override;
     bool acceptRename(const QUrl &oldUrl, const QUrl &newUrl) override;
+
+protected:
+    // \a type is the result of classify.
+    QString doReplace(const QUrl &oldUrl, const QUrl &newUrl, const QString &newType);
+    QString doAppend(const QUrl &url, const QString &type);
+    QString doPrepend(const QUrl &url, const QString &type);
 };
 
 }
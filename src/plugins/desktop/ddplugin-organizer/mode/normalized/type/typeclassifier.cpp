@@ -9,6 +9,8 @@
 #include <dfm-base/file/local/syncfileinfo.h>
 #include <dfm-base/base/schemefactory.h>
 
+#include <QtConcurrent>
+
 using namespace ddplugin_organizer;
 DFMBASE_USE_NAMESPACE
 
@@ -22,6 +24,19 @@ inline const char kTypeSuffixMuz[] = "au,snd,mid,mp3,aif,aifc,aiff,m3u,ra,ram,wa
 inline const char kTypeSuffixVid[] = "avi,mov,mp4,mp2,mpa,mpg,mpeg,mpe,qt,rm,rmvb,mkv,asx,asf,flv,3gp";
 inline const char kTypeSuffixApp[] = "desktop";
 //inline const char kTypeMimeApp[] = "application/x-shellscript,application/x-desktop,application/x-executable";
+
+// the batch smaller than it is classified in the calling thread.
+inline constexpr int kParallelClassifyCount = 64;
+
+struct ClassifyFunctor
+{
+    typedef QString result_type;
+    const TypeClassifier *classifier = nullptr;
+    QString operator()(const QUrl &url) const
+    {
+        return classifier->classify(url);
+    }
+};
 }
 
 #define InitSuffixTable(table, suffix)                                 \
@@ -45,6 +60,49 @@ TypeClassifierPrivate::~TypeClassifierPrivate()
 {
 }
 
+QString TypeClassifierPrivate::classify(FileInfoPointer itemInfo) const
+{
+    QString key;
+    //Classify whether it is a symlink according to the symlink's target
+    if (itemInfo->isAttributes(OptInfoType::kIsSymLink)) {
+        QUrl fileUrl = itemInfo->urlOf(UrlInfoType::kRedirectedFileUrl);
+        itemInfo = InfoFactory::create<FileInfo>(fileUrl);
+        if (!itemInfo || itemInfo->isAttributes(OptInfoType::kIsSymLink)) {
+            key = kTypeKeyOth;
+            return key;
+        }
+    }
+
+    if (itemInfo->isAttributes(OptInfoType::kIsDir)) {
+        key = kTypeKeyFld;
+    } else {
+        // classified by suffix.
+        const QString &suffix = itemInfo->nameOf(NameInfoType::kSuffix).toLower();
+        if (docSuffix.contains(suffix))
+            key = kTypeKeyDoc;
+        else if (appSuffix.contains(suffix))
+            key = kTypeKeyApp;
+        else if (vidSuffix.contains(suffix))
+            key = kTypeKeyVid;
+        else if (picSuffix.contains(suffix))
+            key = kTypeKeyPic;
+        else if (muzSuffix.contains(suffix))
+            key = kTypeKeyMuz;
+    }
+
+    // set it to other if it not belong to any category
+    // if its category is disabled. use: `d->categories.testFlag(d->categoryKey.key(key)`
+    if (key.isEmpty())
+        key = kTypeKeyOth;
+    return key;
+}
+
+void TypeClassifierPrivate::forget(const QUrl &url)
+{
+    QMutexLocker lk(&classifiedMutex);
+    classified.remove(url);
+}
+
 TypeClassifier::TypeClassifier(QObject *parent)
     : FileClassifier(parent), d(new TypeClassifierPrivate(this))
 {
@@ -124,45 +182,40 @@ QStringList TypeClassifier::classes() const
 
 QString TypeClassifier::classify(const QUrl &url) const
 {
+    // the info is shared with the canvas model by the info cache.
     auto itemInfo = InfoFactory::create<FileInfo>(url);
     if (!itemInfo)
         return QString();   // must return null string to represent the file is not existed.
 
-    QString key;
-    //Classify whether it is a symlink according to the symlink's target
-    if (itemInfo->isAttributes(OptInfoType::kIsSymLink)) {
-        QUrl fileUrl = itemInfo->urlOf(UrlInfoType::kRedirectedFileUrl);
-        itemInfo = InfoFactory::create<FileInfo>(fileUrl);
-        if (itemInfo->isAttributes(OptInfoType::kIsSymLink)) {
-            key = kTypeKeyOth;
-            return key;
-        }
+    const qint64 modified = itemInfo->timeOf(TimeInfoType::kLastModifiedSecond).value<qint64>();
+    {
+        QMutexLocker lk(&d->classifiedMutex);
+        auto it = d->classified.constFind(url);
+        if (it != d->classified.constEnd() && it->modified == modified)
+            return it->type;
     }
 
-    if (itemInfo->isAttributes(OptInfoType::kIsDir)) {
-        key = kTypeKeyFld;
-    } else {
-        // classified by suffix.
-        const QString &suffix = itemInfo->nameOf(NameInfoType::kSuffix).toLower();
-        if (d->docSuffix.contains(suffix))
-            key = kTypeKeyDoc;
-        else if (d->appSuffix.contains(suffix))
-            key = kTypeKeyApp;
-        else if (d->vidSuffix.contains(suffix))
-            key = kTypeKeyVid;
-        else if (d->picSuffix.contains(suffix))
-            key = kTypeKeyPic;
-        else if (d->muzSuffix.contains(suffix))
-            key = kTypeKeyMuz;
+    const QString &key = d->classify(itemInfo);
+    {
+        QMutexLocker lk(&d->classifiedMutex);
+        d->classified.insert(url, { modified, key });
     }
-
-    // set it to other if it not belong to any category
-    // if its category is disabled. use: `d->categories.testFlag(d->categoryKey.key(key)`
-    if (key.isEmpty())
-        key = kTypeKeyOth;
     return key;
 }
 
+/*!
+ * \brief classify \a urls on the global thread pool, it is thread safe to classify.
+ */
+QStringList TypeClassifier::classifyAll(const QList<QUrl> &urls) const
+{
+    if (urls.size() < kParallelClassifyCount)
+        return FileClassifier::classifyAll(urls);
+
+    ClassifyFunctor functor;
+    functor.classifier = this;
+    return QtConcurrent::blockingMapped<QStringList>(urls, functor);
+}
+
 QString TypeClassifier::className(const QString &key) const
 {
     return d->keyNames.value(key);
@@ -175,36 +228,42 @@ void TypeClassifier::updateClassifier()
 
 QString TypeClassifier::replace(const QUrl &oldUrl, const QUrl &newUrl)
 {
-    if (!classes().contains(classify(newUrl)))
-        return classify(newUrl);
-    return FileClassifier::replace(oldUrl, newUrl);
+    d->forget(oldUrl);
+    const QString &type = classify(newUrl);
+    if (!classes().contains(type))
+        return type;
+    return doReplace(oldUrl, newUrl, type);
 }
 
 QString TypeClassifier::append(const QUrl &url)
 {
-    if (!classes().contains(classify(url)))
-        return classify(url);
-    return FileClassifier::append(url);
+    const QString &type = classify(url);
+    if (!classes().contains(type))
+        return type;
+    return doAppend(url, type);
 }
 
 QString TypeClassifier::prepend(const QUrl &url)
 {
-    if (!classes().contains(classify(url)))
-        return classify(url);
-    return FileClassifier::prepend(url);
+    const QString &type = classify(url);
+    if (!classes().contains(type))
+        return type;
+    return doPrepend(url, type);
 }
 
 QString TypeClassifier::remove(const QUrl &url)
 {
     // 当此接口被调用时，文件可能已经被真正的移除了
     // 因此无法通过创建文件信息判断类型
+    d->forget(url);
     return FileClassifier::remove(url);
 }
 
 QString TypeClassifier::change(const QUrl &url)
 {
-    if (!classes().contains(classify(url)))
-        return classify(url);
+    const QString &type = classify(url);
+    if (!classes().contains(type))
+        return type;
     return FileClassifier::change(url);
 }
 
@@ -213,16 +272,11 @@ bool TypeClassifier::acceptRename(const QUrl &oldUrl, const QUrl &newUrl)
     if (!CfgPresenter->organizeOnTriggered())
         return FileClassifier::acceptRename(oldUrl, newUrl);
 
-    QList<QUrl> collected;
-    for (auto base : baseData())
-        collected.append(base->items);
-    if (collected.contains(newUrl)) {
+    if (!key(newUrl).isEmpty()) {
         // if the newUrl existed in collections, means new file replaced the old file.
         // remove it from collection
         remove(newUrl);
         return true;
-    } else if (collected.contains(oldUrl)) {
-        return true;
     }
-    return false;
+    return !key(oldUrl).isEmpty();
 }
@@ -24,6 +24,7 @@ public:
     ModelDataHandler *dataHandler() const override;
     QStringList classes() const override;
     QString classify(const QUrl &) const override;
+    QStringList classifyAll(const QList<QUrl> &urls) const override;
     QString className(const QString &key) const override;
     void updateClassifier() override;
 
@@ -7,6 +7,10 @@
 
 #include "typeclassifier.h"
 
+#include <dfm-base/interfaces/fileinfo.h>
+
+#include <QMutex>
+
 namespace ddplugin_organizer {
 
 class TypeClassifierPrivate
@@ -14,6 +18,8 @@ class TypeClassifierPrivate
 public:
     explicit TypeClassifierPrivate(TypeClassifier *qq);
     ~TypeClassifierPrivate();
+    QString classify(FileInfoPointer info) const;
+    void forget(const QUrl &url);
 
 public:
     ItemCategories categories;
@@ -24,6 +30,15 @@ public:
     const QSet<QString> vidSuffix;
     const QSet<QString> appSuffix;
     //const QSet<QString> appMimeType;
+
+    // the type of url, it is valid while the modified time is the same.
+    struct Classified
+    {
+        qint64 modified = 0;
+        QString type;
+    };
+    mutable QMutex classifiedMutex;
+    mutable QHash<QUrl, Classified> classified;
 private:
     TypeClassifier *q;
 };
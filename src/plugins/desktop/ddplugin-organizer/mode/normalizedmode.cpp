@@ -415,13 +415,16 @@ void NormalizedModePrivate::restore(const QList<CollectionBaseDataPtr> &cfgs, bo
     // order by config
     for (const CollectionBaseDataPtr &cfg : cfgs) {
         if (auto base = classifier->baseData(cfg->key)) {
-            QList<QUrl> org = base->items;
-            QList<QUrl> ordered;
+            CollectionItems ordered;
             for (const QUrl &old : cfg->items) {
-                if (org.contains(old)) {
+                if (base->items.contains(old))
                     ordered << old;
-                    org.removeOne(old);
-                }
+            }
+
+            QList<QUrl> org;
+            for (const QUrl &url : base->items) {
+                if (!ordered.contains(url))
+                    org << url;
             }
 
             // those are not in config files should not be organized.
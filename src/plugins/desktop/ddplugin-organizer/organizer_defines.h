@@ -6,6 +6,7 @@
 #define ORGANIZER_DEFINES_H
 
 #include "ddplugin_organizer_global.h"
+#include "mode/collectionitems.h"
 
 #include <QString>
 #include <QUrl>
@@ -81,7 +82,7 @@ class CollectionBaseData
 public:
     QString name;
     QString key;
-    QList<QUrl> items;
+    CollectionItems items;
 };
 
 typedef QSharedPointer<CollectionBaseData> CollectionBaseDataPtr;
@@ -948,7 +948,7 @@ void CollectionViewPrivate::continuousSelection(const QPersistentModelIndex &new
     q->selectionModel()->setCurrentIndex(newCurrent, QItemSelectionModel::NoUpdate);
 
     auto &&currentSelectionStartFile = q->model()->fileUrl(currentSelectionStartIndex);
-    auto &&currentSelectionStartNode = provider->items(id).indexOf(currentSelectionStartFile);
+    auto &&currentSelectionStartNode = provider->indexOf(id, currentSelectionStartFile);
     if (Q_UNLIKELY(-1 == currentSelectionStartNode)) {
         fmWarning() << "warning:can not find file:" << currentSelectionStartFile << " in collection:" << id
                     << ".Or no file is selected.So fix to 0.";
@@ -956,7 +956,7 @@ void CollectionViewPrivate::continuousSelection(const QPersistentModelIndex &new
     }
 
     auto &&currentSelectionEndFile = q->model()->fileUrl(newCurrent);
-    auto &&currentSelectionEndNode = provider->items(id).indexOf(currentSelectionEndFile);
+    auto &&currentSelectionEndNode = provider->indexOf(id, currentSelectionEndFile);
     if (Q_UNLIKELY(-1 == currentSelectionEndNode)) {
         fmWarning() << "warning:can not find file:" << currentSelectionEndFile << " in collection:" << id
                     << ".Give up switch selection!";
@@ -1373,10 +1373,10 @@ QRect CollectionView::visualRect(const QModelIndex &index) const
         return QRect();
 
     QUrl url = model()->fileUrl(index);
-    if (!d->provider->items(d->id).contains(url))
+    int node = d->provider->indexOf(d->id, url);
+    if (node < 0)
         return QRect();
 
-    int node = d->provider->items(d->id).indexOf(url);
     const QPoint &&pos = d->nodeToPos(node);
 
     return d->visualRect(pos);
@@ -1469,7 +1469,7 @@ QModelIndex CollectionView::moveCursor(CursorAction cursorAction, Qt::KeyboardMo
     }
 
     auto currentUrl = model()->fileUrl(current);
-    auto node = d->provider->items(d->id).indexOf(currentUrl);
+    auto node = d->provider->indexOf(d->id, currentUrl);
     if (Q_UNLIKELY(-1 == node)) {
         fmWarning() << "current url not belong to me." << currentUrl << d->provider->items(d->id);
         return QModelIndex();
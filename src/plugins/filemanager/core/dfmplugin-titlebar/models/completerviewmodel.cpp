@@ -20,13 +20,19 @@ CompleterViewModel::~CompleterViewModel()
 void CompleterViewModel::setStringList(const QStringList &list)
 {
     removeAll();
+
+    // insert all rows at once, the completer refilters on every insertion
+    QList<QStandardItem *> items;
+    items.reserve(list.size());
     for (const auto &str : list) {
         if (str.isEmpty())
             continue;
 
-        QStandardItem *item = new QStandardItem(str);
-        appendRow(item);
+        items.append(new QStandardItem(str));
     }
+
+    if (!items.isEmpty())
+        invisibleRootItem()->appendRows(items);
 }
 
 void CompleterViewModel::removeAll()
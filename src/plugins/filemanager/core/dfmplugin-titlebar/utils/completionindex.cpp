@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "completionindex.h"
+
+#include <dfm-base/utils/chinese2pinyin.h>
+
+#include <QBitArray>
+
+#include <algorithm>
+#include <tuple>
+
+using namespace dfmplugin_titlebar;
+
+static constexpr int kMaxVisitedParents { 256 };
+
+// the visits of the paths entered in the address bar, only touched in the main thread
+static QHash<QString, QHash<QString, int>> &visitedPaths()
+{
+    static QHash<QString, QHash<QString, int>> visits;
+    return visits;
+}
+
+CompletionIndex::CompletionIndex(const QStringList &names)
+    : names(names)
+{
+    std::sort(this->names.begin(), this->names.end(), [](const QString &a, const QString &b) {
+        const int ret = a.compare(b, Qt::CaseInsensitive);
+        return ret == 0 ? a < b : ret < 0;
+    });
+
+    keys.reserve(this->names.size());
+    for (int i = 0; i < this->names.size(); ++i) {
+        const QString &name = this->names.at(i);
+        keys.append({ name.toLower(), i });
+
+        QString full;
+        QString initials;
+        if (Pinyin::Chinese2PinyinKeys(name, &full, &initials)) {
+            full = full.toLower();
+            initials = initials.toLower();
+            keys.append({ full, i });
+            if (initials != full)
+                keys.append({ initials, i });
+        }
+    }
+
+    std::sort(keys.begin(), keys.end());
+}
+
+int CompletionIndex::size() const
+{
+    return names.size();
+}
+
+/*!
+ * \brief the names starting with \a prefix, case insensitive and pinyin aware.
+ * The names visited more often come first, then the ones matching the case of \a prefix,
+ * the rest keep the name order.
+ */
+QStringList CompletionIndex::match(const QString &prefix, const QHash<QString, int> &weights, int limit) const
+{
+    const QString &folded = prefix.toLower();
+    auto iter = std::lower_bound(keys.cbegin(), keys.cend(), folded,
+                                 [](const QPair<QString, int> &key, const QString &value) {
+                                     return key.first < value;
+                                 });
+
+    // (-weight, case mismatched, row)
+    QBitArray matched(names.size());
+    QVector<std::tuple<int, int, int>> rows;
+    for (; iter != keys.cend() && iter->first.startsWith(folded); ++iter) {
+        const int row = iter->second;
+        if (matched.testBit(row))
+            continue;
+        matched.setBit(row);
+
+        const QString &name = names.at(row);
+        rows.append(std::make_tuple(-weights.value(name), name.startsWith(prefix) ? 0 : 1, row));
+    }
+
+    std::sort(rows.begin(), rows.end());
+    if (limit >= 0 && rows.size() > limit)
+        rows.resize(limit);
+
+    QStringList result;
+    result.reserve(rows.size());
+    for (const auto &row : rows)
+        result.append(names.at(std::get<2>(row)));
+    return result;
+}
+
+void CompletionIndex::recordVisit(const QString &parentPath, const QString &name)
+{
+    if (parentPath.isEmpty() || name.isEmpty())
+        return;
+
+    auto &visits = visitedPaths();
+    if (!visits.contains(parentPath) && visits.size() >= kMaxVisitedParents)
+        visits.clear();
+    ++visits[parentPath][name];
+}
+
+QHash<QString, int> CompletionIndex::visitWeights(const QString &parentPath)
+{
+    return visitedPaths().value(parentPath);
+}
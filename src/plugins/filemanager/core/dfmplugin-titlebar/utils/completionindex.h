@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef COMPLETIONINDEX_H
+#define COMPLETIONINDEX_H
+
+#include "dfmplugin_titlebar_global.h"
+
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QSharedPointer>
+
+namespace dfmplugin_titlebar {
+
+/*!
+ * \brief The CompletionIndex class is a sorted prefix index of the children names of a directory.
+ * Every name is indexed by its lower case form, and names with chinese characters also
+ * by their full pinyin and pinyin initials, so a prefix is matched by a binary search.
+ *
+ * The index is immutable once it is built, it is built in the traversal thread and shared
+ * by the keystrokes while the parent directory stays the same.
+ */
+class CompletionIndex
+{
+public:
+    CompletionIndex() = default;
+    explicit CompletionIndex(const QStringList &names);
+
+    int size() const;
+    QStringList match(const QString &prefix, const QHash<QString, int> &weights = {}, int limit = -1) const;
+
+    static void recordVisit(const QString &parentPath, const QString &name);
+    static QHash<QString, int> visitWeights(const QString &parentPath);
+
+private:
+    QStringList names;
+    QVector<QPair<QString, int>> keys;
+};
+
+using CompletionIndexPointer = QSharedPointer<const CompletionIndex>;
+
+}
+
+Q_DECLARE_METATYPE(DPTITLEBAR_NAMESPACE::CompletionIndexPointer)
+
+#endif   // COMPLETIONINDEX_H
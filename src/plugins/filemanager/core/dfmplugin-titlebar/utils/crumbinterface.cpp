@@ -16,9 +16,14 @@
 using namespace dfmplugin_titlebar;
 DFMBASE_USE_NAMESPACE
 
+static constexpr int kMaxCachedIndexes { 8 };
+static constexpr qint64 kCachedIndexLifetime { 10 * 1000 };   // ms
+
 CrumbInterface::CrumbInterface(QObject *parent)
-    : QObject(parent)
+    : QObject(parent),
+      completionIndexes(kMaxCachedIndexes)
 {
+    qRegisterMetaType<CompletionIndexPointer>();
 }
 
 void CrumbInterface::setKeepAddressBar(bool keep)
@@ -107,21 +112,29 @@ QList<CrumbData> CrumbInterface::seprateUrl(const QUrl &url)
  *
  * \param url The base url need to be completed.
  *
- * Since completion list can be long, so we need do async completion. Calling this
- * function will start a completion request and the completion list item will be sent
- * via signal completionFound. When user no longer need current completion list and
- * the transmission isn't completed, you should call cancelCompletionListTransmission.
- * When transmission completed, it will send completionListTransmissionCompleted signal.
+ * The children of the url are enumerated and indexed in the traversal thread, then
+ * the index is sent via signal completionIndexReady, followed by completionListTransmissionCompleted.
+ * A directory indexed recently is answered from the cache without enumerating it again.
+ * Starting a new request or calling cancelCompletionListTransmission drops the pending one.
  *
- * \sa completionFound, completionListTransmissionCompleted, cancelCompletionListTransmission
+ * \sa completionIndexReady, completionListTransmissionCompleted, cancelCompletionListTransmission
  */
 void CrumbInterface::requestCompletionList(const QUrl &url)
 {
-    if (folderCompleterJobPointer) {
-        folderCompleterJobPointer->disconnect();
-        folderCompleterJobPointer->stopAndDeleteLater();
-        folderCompleterJobPointer->setParent(nullptr);
+    cancelCompletionListTransmission();
+    const quint64 generation = ++completionGeneration;
+
+    CachedIndex *cached = completionIndexes.object(url);
+    if (cached && cached->age.elapsed() < kCachedIndexLifetime) {
+        CompletionIndexPointer index = cached->index;
+        QMetaObject::invokeMethod(
+                this, [this, generation, url, index]() {
+                    onCompletionIndexBuilt(generation, url, index);
+                },
+                Qt::QueuedConnection);
+        return;
     }
+
     folderCompleterJobPointer = new TraversalDirThread(url, QStringList(),
                                                        QDir::Dirs | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::NoIteratorFlags);
     folderCompleterJobPointer->setQueryAttributes("standard::standard::name");
@@ -129,38 +142,64 @@ void CrumbInterface::requestCompletionList(const QUrl &url)
     if (folderCompleterJobPointer.isNull())
         return;
 
-    connect(folderCompleterJobPointer.data(), &TraversalDirThread::updateChildren, this,
-            &CrumbInterface::onUpdateChildren, Qt::DirectConnection);
+    // the names are collected and indexed in the traversal thread
+    QSharedPointer<QStringList> names(new QStringList);
+    connect(
+            folderCompleterJobPointer.data(), &TraversalDirThread::updateChildren, folderCompleterJobPointer.data(),
+            [names](QList<QUrl> children) {
+                for (const auto &child : children)
+                    names->append(child.fileName());
+            },
+            Qt::DirectConnection);
 
+    QPointer<CrumbInterface> guard(this);
     connect(
-            folderCompleterJobPointer.data(), &TraversalDirThread::finished, this,
-            [this]() {
-                emit completionListTransmissionCompleted();
+            folderCompleterJobPointer.data(), &TraversalDirThread::finished, folderCompleterJobPointer.data(),
+            [guard, generation, url, names]() {
+                names->removeAll(QString());
+                CompletionIndexPointer index(new CompletionIndex(*names));
+                if (guard)
+                    QMetaObject::invokeMethod(
+                            guard.data(), [guard, generation, url, index]() {
+                                if (guard)
+                                    guard->onCompletionIndexBuilt(generation, url, index);
+                            },
+                            Qt::QueuedConnection);
             },
-            Qt::QueuedConnection);
-    // TODO(liyigang): imple follow interfaces
-    //    folderCompleterJobPointer->setTimeCeiling(1000);
-    //    folderCompleterJobPointer->setCountCeiling(500);
+            Qt::DirectConnection);
+
     folderCompleterJobPointer->start();
 }
 
 /*!
  * \brief Cancel the started completion list transmission.
  *
- * \sa completionFound, completionListTransmissionCompleted, requestCompletionList
+ * \sa completionIndexReady, completionListTransmissionCompleted, requestCompletionList
  */
 void CrumbInterface::cancelCompletionListTransmission()
 {
-    if (folderCompleterJobPointer)
-        folderCompleterJobPointer->stop();
+    ++completionGeneration;
+    if (folderCompleterJobPointer) {
+        folderCompleterJobPointer->disconnect();
+        folderCompleterJobPointer->stopAndDeleteLater();
+        folderCompleterJobPointer->setParent(nullptr);
+    }
 }
 
-void CrumbInterface::onUpdateChildren(QList<QUrl> children)
+void CrumbInterface::onCompletionIndexBuilt(quint64 generation, const QUrl &url, CompletionIndexPointer index)
 {
-    QStringList list;
+    // a stale enumeration
+    if (generation != completionGeneration)
+        return;
 
-    for (const auto &child : children) {
-        list.append(child.fileName());
+    CachedIndex *cached = completionIndexes.object(url);
+    if (!cached || cached->index != index) {
+        cached = new CachedIndex;
+        cached->index = index;
+        cached->age.start();
+        completionIndexes.insert(url, cached);
     }
-    emit completionFound(list);
+
+    emit completionIndexReady(url, index);
+    emit completionListTransmissionCompleted();
 }
@@ -6,11 +6,14 @@
 #define CRUMBINTERFACE_H
 
 #include "dfmplugin_titlebar_global.h"
+#include "utils/completionindex.h"
 
 #include <dfm-base/utils/traversaldirthread.h>
 
 #include <QObject>
 #include <QPointer>
+#include <QCache>
+#include <QElapsedTimer>
 
 namespace dfmplugin_titlebar {
 
@@ -44,16 +47,24 @@ signals:
     void pauseSearch();
     void keepAddressBar(const QUrl &url);
     void hideAddrAndUpdateCrumbs(const QUrl &url);
-    void completionFound(const QStringList &completions);   //< emit multiple times with less or equials to 10 items in a group.
+    void completionIndexReady(const QUrl &url, CompletionIndexPointer index);   //< emit once the children of url are indexed.
     void completionListTransmissionCompleted();   //< emit when all avaliable completions has been sent.
 
-private slots:
-    void onUpdateChildren(QList<QUrl> children);
+private:
+    void onCompletionIndexBuilt(quint64 generation, const QUrl &url, CompletionIndexPointer index);
 
 private:
+    struct CachedIndex
+    {
+        CompletionIndexPointer index;
+        QElapsedTimer age;
+    };
+
     QString curScheme;
     bool keepAddr { false };
     QPointer<DFMBASE_NAMESPACE::TraversalDirThread> folderCompleterJobPointer;
+    quint64 completionGeneration { 0 };
+    QCache<QUrl, CachedIndex> completionIndexes;
 };
 
 }
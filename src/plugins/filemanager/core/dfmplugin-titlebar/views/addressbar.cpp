@@ -28,6 +28,8 @@
 
 using namespace dfmplugin_titlebar;
 
+static constexpr int kMaxCompletionCount { 1000 };
+
 /*!
  * \class AddressBarPrivate
  * \brief parent
@@ -283,16 +285,26 @@ void AddressBarPrivate::doComplete()
     return;
 }
 
-void AddressBarPrivate::appendToCompleterModel(const QStringList &stringList)
+void AddressBarPrivate::onCompletionIndexReady(const QUrl &url, CompletionIndexPointer index)
 {
-    for (const QString &str : stringList) {
-        // 防止出现空的补全提示
-        if (str.isEmpty())
-            continue;
+    Q_UNUSED(url)
 
-        QStandardItem *item = new QStandardItem(str);
-        completerModel.appendRow(item);
-    }
+    completionIndex = index;
+    filterCompletion(completionPrefix);
+}
+
+/*!
+ * \brief Fill the completer model with the indexed children matching \a prefix.
+ *
+ * The completer itself does not filter the model, its completion prefix stays empty.
+ */
+void AddressBarPrivate::filterCompletion(const QString &prefix)
+{
+    completionPrefix = prefix;
+    if (!completionIndex)
+        return;
+
+    completerModel.setStringList(completionIndex->match(prefix, CompletionIndex::visitWeights(completionParentPath), kMaxCompletionCount));
 }
 
 void AddressBarPrivate::onTravelCompletionListFinished()
@@ -394,7 +406,7 @@ void AddressBarPrivate::requestCompleteByUrl(const QUrl &url)
         }
         crumbController->setParent(q);
         // connections
-        connect(crumbController, &CrumbInterface::completionFound, this, &AddressBarPrivate::appendToCompleterModel);
+        connect(crumbController, &CrumbInterface::completionIndexReady, this, &AddressBarPrivate::onCompletionIndexReady);
         connect(crumbController, &CrumbInterface::completionListTransmissionCompleted, this, &AddressBarPrivate::onTravelCompletionListFinished);
     }
     crumbController->requestCompletionList(url);
@@ -465,24 +477,28 @@ void AddressBarPrivate::completeLocalPath(const QString &text, const QUrl &url,
         return;
 
     // Check if we should start a new completion transmission.
+    // The index of the parent is reused while the parent stays the same.
     if (!isHistoryInCompleterModel
         && (this->completerBaseString == text.left(slashIndex + 1)
             || UrlRoute::fromUserInput(completerBaseString) == UrlRoute::fromUserInput(text.left(slashIndex + 1)))) {
-        urlCompleter->setCompletionPrefix(text.mid(slashIndex + 1));   // set completion prefix first
+        filterCompletion(text.mid(slashIndex + 1));
         onCompletionModelCountChanged();   // will call complete()
         return;
     }
 
     // Set Base String
     completerBaseString = text.left(slashIndex + 1);
+    completionParentPath = QDir::cleanPath(url.path());
+    completionIndex.reset();
 
     // start request
     // 由于下方urlCompleter->setCompletionPrefix会触发onCompletionModelCountChanged接口
     // 因此在这之前需要将completerModel清空，否则会使用上一次model中的数据
     clearCompleterModel();
 
-    // set completion prefix.
-    urlCompleter->setCompletionPrefix(text.mid(slashIndex + 1));
+    // the model is filtered by the completion index
+    completionPrefix = text.mid(slashIndex + 1);
+    urlCompleter->setCompletionPrefix("");
 
     // URL completion.
     requestCompleteByUrl(url);
@@ -527,7 +543,14 @@ void AddressBarPrivate::onReturnPressed()
         return;
 
     // add search history list
-    if (!dfmbase::FileUtils::isLocalFile(UrlRoute::fromUserInput(text))) {
+    const QUrl &inputUrl = UrlRoute::fromUserInput(text);
+    if (dfmbase::FileUtils::isLocalFile(inputUrl)) {
+        // rank the visited children first in the next completions
+        const QString &path = QDir::cleanPath(inputUrl.path());
+        const int slashIndex = path.lastIndexOf('/');
+        if (slashIndex >= 0)
+            CompletionIndex::recordVisit(slashIndex == 0 ? QString("/") : path.left(slashIndex), path.mid(slashIndex + 1));
+    } else {
         if (DConfigManager::instance()->value(DConfigSearch::kSearchCfgPath,
                                               DConfigSearch::kDisplaySearchHistory, true).toBool()) {
             if (!historyList.contains(text))
@@ -599,13 +622,15 @@ void AddressBarPrivate::onCompletionHighlighted(const QString &highlightedComple
         q->setText(highlightedCompletion);
         q->setSelection(0, selectLength);
     } else {
-        int completionPrefixLen = indicatorType == AddressBar::IndicatorType::Search
-                ? completionPrefix.length() : urlCompleter->completionPrefix().length();
+        int completionPrefixLen = completionPrefix.length();
         int selectBeginPos = highlightedCompletion.length() - completionPrefixLen;
         if (highlightedCompletion == QObject::tr("Clear search history")) {
             q->setText(completerBaseString + lastEditedString);
             isClearSearch = true;
         } else {
+            // the names matched by pinyin or initials do not start with the typed text, select the whole name
+            if (!highlightedCompletion.startsWith(completionPrefix, Qt::CaseInsensitive))
+                selectBeginPos = highlightedCompletion.length();
             q->setText(completerBaseString + highlightedCompletion);
             isClearSearch = false;
         }
@@ -10,6 +10,7 @@
 #include "views/completerview.h"
 #include "views/completerviewdelegate.h"
 #include "models/completerviewmodel.h"
+#include "utils/completionindex.h"
 
 #include <dfm-base/base/urlroute.h>
 
@@ -75,6 +76,8 @@ class AddressBarPrivate : public QObject
     QRegExp ipRegExp;   // 0.0.0.0-255.255.255.255
     QRegExp protocolIPRegExp;   // smb://ip, ftp://ip, sftp://ip
     QString completionPrefix;
+    QString completionParentPath;
+    CompletionIndexPointer completionIndex;
     bool inputIsIpAddress { false };
 
 public:
@@ -94,6 +97,7 @@ public:
     void completeSearchHistory(const QString &text);
     void completeIpAddress(const QString &text);
     void completeLocalPath(const QString &text, const QUrl &url, int slashIndex);
+    void filterCompletion(const QString &prefix);
 
 public Q_SLOTS:
     void startSpinner();
@@ -104,7 +108,7 @@ public Q_SLOTS:
     void onCompletionHighlighted(const QString &highlightedCompletion);
     void updateIndicatorIcon();
     void onCompletionModelCountChanged();
-    void appendToCompleterModel(const QStringList &stringList);
+    void onCompletionIndexReady(const QUrl &url, CompletionIndexPointer index);
     void onTravelCompletionListFinished();
     void onIndicatorTriggerd();
     void onDConfigValueChanged(const QString &config, const QString &key);
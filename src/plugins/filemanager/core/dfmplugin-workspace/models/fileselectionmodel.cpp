@@ -75,6 +75,23 @@ void FileSelectionModel::clearSelectList()
     d->selectedList.clear();
 }
 
+/*!
+ * \brief the file and folder counts of the selection, they are updated by the changed rows
+ * only, so reading them costs nothing while selecting.
+ */
+FileSelectionModel::SelectionStatistics FileSelectionModel::selectionStatistics() const
+{
+    if (d->statisticsDirty)
+        d->rebuildStatistics();
+
+    SelectionStatistics statistics;
+    statistics.fileCount = d->statisticsFiles;
+    statistics.folderCount = d->statisticsFolders.count();
+    statistics.fileSize = d->statisticsFileSize;
+    statistics.folderUrls = d->statisticsFolders.values();
+    return statistics;
+}
+
 void FileSelectionModel::updateSelecteds()
 {
     QItemSelectionModel::select(d->selection, d->currentCommand);
@@ -126,6 +143,8 @@ void FileSelectionModel::clear()
     d->selection.clear();
     d->firstSelectedIndex = QModelIndex();
     d->lastSelectedIndex = QModelIndex();
+    // the delayed selection is not known by the base class, its rows are not reported as deselected
+    d->invalidateStatistics();
 
     QItemSelectionModel::clear();
 }
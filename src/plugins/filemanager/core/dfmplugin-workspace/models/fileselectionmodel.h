@@ -8,6 +8,7 @@
 #include "dfmplugin_workspace_global.h"
 
 #include <QItemSelectionModel>
+#include <QUrl>
 
 namespace dfmplugin_workspace {
 
@@ -17,6 +18,14 @@ class FileSelectionModel : public QItemSelectionModel
     Q_OBJECT
 
 public:
+    struct SelectionStatistics
+    {
+        int fileCount { 0 };
+        int folderCount { 0 };
+        qint64 fileSize { 0 };
+        QList<QUrl> folderUrls;
+    };
+
     explicit FileSelectionModel(QAbstractItemModel *model = nullptr);
     explicit FileSelectionModel(QAbstractItemModel *model, QObject *parent);
     ~FileSelectionModel() override;
@@ -25,6 +34,7 @@ public:
     int selectedCount() const;
     QModelIndexList selectedIndexes() const;
     void clearSelectList();
+    SelectionStatistics selectionStatistics() const;
 
 public slots:
     void updateSelecteds();
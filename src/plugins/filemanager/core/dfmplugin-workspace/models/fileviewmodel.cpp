@@ -8,6 +8,7 @@
 #include "utils/fileoperatorhelper.h"
 #include "utils/filedatamanager.h"
 #include "utils/filesortworker.h"
+#include "utils/fileinfoprefetcher.h"
 #include "models/rootinfo.h"
 #include "models/fileitemdata.h"
 #include "events/workspaceeventsequence.h"
@@ -38,6 +39,8 @@ DFMBASE_USE_NAMESPACE
 using namespace dfmplugin_workspace;
 
 inline constexpr char kDdeFileManager[] { "dde-fileManager" };
+// the rows prefetched before and after the visible rows, in pages
+inline constexpr int kPrefetchPages { 1 };
 
 FileViewModel::FileViewModel(QAbstractItemView *parent)
     : QAbstractItemModel(parent)
@@ -51,11 +54,14 @@ FileViewModel::FileViewModel(QAbstractItemView *parent)
     connect(DConfigManager::instance(), &DConfigManager::valueChanged, this, &FileViewModel::onDConfigChanged);
     connect(&waitTimer, &QTimer::timeout, this, &FileViewModel::onSetCursorWait);
     waitTimer.setInterval(50);
+
+    initFileInfoPrefetcher();
 }
 
 FileViewModel::~FileViewModel()
 {
     closeCursorTimer();
+    quitFileInfoPrefetcher();
     quitFilterSortWork();
 
     if (itemRootData) {
@@ -119,6 +125,8 @@ QModelIndex FileViewModel::setRootUrl(const QUrl &url)
     // insert root index
     beginResetModel();
     closeCursorTimer();
+    if (infoPrefetcher)
+        infoPrefetcher->cancel();
     // create root by url
     dirRootUrl = url;
     RootInfo *root = FileDataManager::instance()->fetchRoot(dirRootUrl);
@@ -359,6 +367,8 @@ QVariant FileViewModel::headerData(int column, Qt::Orientation, int role) const
 void FileViewModel::refresh()
 {
     FileDataManager::instance()->cleanRoot(dirRootUrl, currentKey, true);
+    if (infoPrefetcher)
+        infoPrefetcher->cancel();
 
     Q_EMIT requestRefreshAllChildren();
 }
@@ -742,6 +752,67 @@ void FileViewModel::onFileThumbUpdated(const QUrl &url, const QString &thumb)
     }
 }
 
+/*!
+ * \brief prefetch the file infos of the rows in [first, last] and the rows around them,
+ * the requests of the previous range are dropped.
+ */
+void FileViewModel::setVisibleRange(int first, int last)
+{
+    if (!infoPrefetcher || filterSortWorker.isNull())
+        return;
+
+    const int count = filterSortWorker->childrenCount();
+    first = qMax(first, 0);
+    last = qMin(last, count - 1);
+    if (first > last) {
+        infoPrefetcher->cancel();
+        return;
+    }
+
+    auto appendUrl = [this](int row, QList<QUrl> *urls) {
+        const auto &item = filterSortWorker->childData(row);
+        if (item && !item->fileInfo())
+            urls->append(item->data(Global::ItemRoles::kItemUrlRole).toUrl());
+    };
+
+    const int margin = (last - first + 1) * kPrefetchPages;
+    QList<QUrl> visibleUrls;
+    QList<QUrl> prefetchUrls;
+    for (int row = first; row <= last; ++row)
+        appendUrl(row, &visibleUrls);
+    // scrolling down is more common, fetch the next rows first
+    for (int row = last + 1; row <= qMin(last + margin, count - 1); ++row)
+        appendUrl(row, &prefetchUrls);
+    for (int row = first - 1; row >= qMax(first - margin, 0); --row)
+        appendUrl(row, &prefetchUrls);
+
+    infoPrefetcher->setRequests(visibleUrls, prefetchUrls);
+}
+
+bool FileViewModel::isFileInfoPending(const QModelIndex &index) const
+{
+    if (!infoPrefetcher || !index.isValid())
+        return false;
+
+    return infoPrefetcher->isPending(index.data(Global::ItemRoles::kItemUrlRole).toUrl());
+}
+
+void FileViewModel::onFileInfoPrepared(const QUrl &url)
+{
+    const QModelIndex &updateIndex = getIndexByUrl(url);
+    if (!updateIndex.isValid())
+        return;
+
+    // the info is cached by the prefetcher, it's cheap to create it here
+    updateIndex.data(Global::ItemRoles::kItemCreateFileInfoRole);
+    auto view = qobject_cast<FileView *>(QObject::parent());
+    if (view) {
+        view->update(updateIndex);
+    } else {
+        Q_EMIT dataChanged(updateIndex, updateIndex);
+    }
+}
+
 void FileViewModel::onFileUpdated(int show)
 {
     auto view = qobject_cast<FileView *>(QObject::parent());
@@ -961,6 +1032,27 @@ void FileViewModel::quitFilterSortWork()
     }
 }
 
+void FileViewModel::initFileInfoPrefetcher()
+{
+    prefetchThread.reset(new QThread);
+    infoPrefetcher.reset(new FileInfoPrefetcher);
+    infoPrefetcher->moveToThread(prefetchThread.data());
+    connect(infoPrefetcher.data(), &FileInfoPrefetcher::fileInfoPrepared, this, &FileViewModel::onFileInfoPrepared, Qt::QueuedConnection);
+    prefetchThread->start();
+}
+
+void FileViewModel::quitFileInfoPrefetcher()
+{
+    if (!infoPrefetcher.isNull()) {
+        infoPrefetcher->disconnect();
+        infoPrefetcher->cancel();
+    }
+    if (!prefetchThread.isNull()) {
+        prefetchThread->quit();
+        prefetchThread->wait();
+    }
+}
+
 void FileViewModel::discardFilterSortObjects()
 {
     if (!filterSortThread.isNull() && !filterSortWorker.isNull()) {
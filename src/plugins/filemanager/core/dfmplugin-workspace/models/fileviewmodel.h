@@ -28,6 +28,7 @@ namespace dfmplugin_workspace {
 class FileView;
 class FileItemData;
 class FileSortWorker;
+class FileInfoPrefetcher;
 class RootInfo;
 class FileViewModel : public QAbstractItemModel
 {
@@ -95,6 +96,9 @@ public:
     void updateThumbnailIcon(const QModelIndex &index, const QString &thumb);
     void setTreeView(const bool isTree);
 
+    void setVisibleRange(int first, int last);
+    bool isFileInfoPending(const QModelIndex &index) const;
+
 Q_SIGNALS:
     void stateChanged();
     void renameFileProcessStarted();
@@ -134,12 +138,15 @@ public Q_SLOTS:
     void onHiddenSettingChanged(bool value);
     void onWorkFinish(int visiableCount, int totalCount);
     void onDataChanged(int first, int last);
+    void onFileInfoPrepared(const QUrl &url);
 
 private:
     void connectRootAndFilterSortWork(RootInfo *root, const bool refresh = false);
     void initFilterSortWork();
     void quitFilterSortWork();
     void discardFilterSortObjects();
+    void initFileInfoPrefetcher();
+    void quitFileInfoPrefetcher();
 
     void changeState(ModelState newState);
     void closeCursorTimer();
@@ -155,6 +162,8 @@ private:
 
     QSharedPointer<QThread> filterSortThread { nullptr };
     QSharedPointer<FileSortWorker> filterSortWorker { nullptr };
+    QSharedPointer<QThread> prefetchThread { nullptr };
+    QSharedPointer<FileInfoPrefetcher> infoPrefetcher { nullptr };
     FileViewFilterCallback filterCallback { nullptr };
     QVariant filterData;
     QString currentKey;
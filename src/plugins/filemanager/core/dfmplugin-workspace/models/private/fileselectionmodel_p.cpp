@@ -4,8 +4,11 @@
 
 #include "fileselectionmodel_p.h"
 
+#include <dfm-base/dfm_global_defines.h>
+
 #include <QItemSelectionModel>
 
+DFMGLOBAL_USE_NAMESPACE
 using namespace dfmplugin_workspace;
 
 FileSelectionModelPrivate::FileSelectionModelPrivate(FileSelectionModel *qq)
@@ -14,4 +17,120 @@ FileSelectionModelPrivate::FileSelectionModelPrivate(FileSelectionModel *qq)
 {
     timer.setSingleShot(true);
     QObject::connect(&timer, &QTimer::timeout, q, &FileSelectionModel::updateSelecteds);
+    QObject::connect(q, &QItemSelectionModel::selectionChanged, this, &FileSelectionModelPrivate::onSelectionChanged);
+    QObject::connect(q, &QItemSelectionModel::modelChanged, this, &FileSelectionModelPrivate::connectModel);
+    connectModel();
+}
+
+void FileSelectionModelPrivate::connectModel()
+{
+    invalidateStatistics();
+    if (!q->model())
+        return;
+
+    // the rows are moved, the statistics are collected again when they are read
+    auto model = q->model();
+    QObject::connect(model, &QAbstractItemModel::rowsInserted, this, &FileSelectionModelPrivate::invalidateStatistics, Qt::UniqueConnection);
+    QObject::connect(model, &QAbstractItemModel::rowsRemoved, this, &FileSelectionModelPrivate::invalidateStatistics, Qt::UniqueConnection);
+    QObject::connect(model, &QAbstractItemModel::rowsMoved, this, &FileSelectionModelPrivate::invalidateStatistics, Qt::UniqueConnection);
+    QObject::connect(model, &QAbstractItemModel::modelReset, this, &FileSelectionModelPrivate::invalidateStatistics, Qt::UniqueConnection);
+    QObject::connect(model, &QAbstractItemModel::layoutChanged, this, &FileSelectionModelPrivate::invalidateStatistics, Qt::UniqueConnection);
+    QObject::connect(model, &QAbstractItemModel::dataChanged, this, &FileSelectionModelPrivate::onDataChanged, Qt::UniqueConnection);
+}
+
+/*!
+ * \brief apply the changed rows to the statistics. The changes of the delayed selection are
+ * reported twice, the selected rows are recorded in statisticsRows so a row is never counted twice.
+ */
+void FileSelectionModelPrivate::onSelectionChanged(const QItemSelection &selected, const QItemSelection &deselected)
+{
+    if (statisticsDirty || !q->model())
+        return;
+
+    auto apply = [this](const QItemSelection &selection, bool isSelected) {
+        for (const QItemSelectionRange &range : selection) {
+            if (!range.isValid())
+                continue;
+            for (int row = range.top(); row <= range.bottom(); ++row)
+                updateStatistics(q->model()->index(row, 0, range.parent()), isSelected);
+        }
+    };
+
+    apply(deselected, false);
+    apply(selected, true);
+}
+
+/*!
+ * \brief count the changed rows again if they are selected, the other rows are not touched.
+ */
+void FileSelectionModelPrivate::onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    if (statisticsDirty || !q->model() || !topLeft.isValid() || !bottomRight.isValid())
+        return;
+
+    const int last = qMin(bottomRight.row(), statisticsRows.size() - 1);
+    for (int row = topLeft.row(); row <= last; ++row) {
+        if (!statisticsRows.testBit(row))
+            continue;
+        const QModelIndex &index = q->model()->index(row, 0, topLeft.parent());
+        updateStatistics(index, false);
+        updateStatistics(index, true);
+    }
+}
+
+void FileSelectionModelPrivate::invalidateStatistics()
+{
+    statisticsDirty = true;
+    statisticsRows.clear();
+    statisticsFiles = 0;
+    statisticsFileSize = 0;
+    statisticsFileSizes.clear();
+    statisticsFolders.clear();
+}
+
+void FileSelectionModelPrivate::rebuildStatistics() const
+{
+    statisticsRows.clear();
+    statisticsFiles = 0;
+    statisticsFileSize = 0;
+    statisticsFileSizes.clear();
+    statisticsFolders.clear();
+
+    for (const QModelIndex &index : q->selectedIndexes())
+        updateStatistics(index, true);
+
+    statisticsDirty = false;
+}
+
+void FileSelectionModelPrivate::updateStatistics(const QModelIndex &index, bool selected) const
+{
+    if (!index.isValid())
+        return;
+
+    const int row = index.row();
+    if (row >= statisticsRows.size())
+        statisticsRows.resize(row + 1);
+
+    if (statisticsRows.testBit(row) == selected)
+        return;
+    statisticsRows.setBit(row, selected);
+
+    // a deselected row is removed as it was counted, its data may be changed since then
+    if (!selected) {
+        if (statisticsFolders.remove(row) > 0)
+            return;
+        statisticsFiles -= 1;
+        statisticsFileSize -= statisticsFileSizes.take(row);
+        return;
+    }
+
+    if (index.data(ItemRoles::kItemFileIsDirRole).toBool()) {
+        statisticsFolders.insert(row, index.data(ItemRoles::kItemUrlRole).toUrl());
+        return;
+    }
+
+    const qint64 size = index.data(ItemRoles::kItemFileSizeIntRole).toLongLong();
+    statisticsFiles += 1;
+    statisticsFileSize += size;
+    statisticsFileSizes.insert(row, size);
 }
@@ -8,6 +8,8 @@
 #include "models/fileselectionmodel.h"
 
 #include <QTimer>
+#include <QBitArray>
+#include <QHash>
 
 namespace dfmplugin_workspace {
 
@@ -19,12 +21,28 @@ class FileSelectionModelPrivate : public QObject
 
 public:
     explicit FileSelectionModelPrivate(FileSelectionModel *qq);
+
+    void connectModel();
+    void onSelectionChanged(const QItemSelection &selected, const QItemSelection &deselected);
+    void onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void invalidateStatistics();
+    void rebuildStatistics() const;
+    void updateStatistics(const QModelIndex &index, bool selected) const;
+
     mutable QModelIndexList selectedList;
     QItemSelection selection;
     QModelIndex firstSelectedIndex;
     QModelIndex lastSelectedIndex;
     QItemSelectionModel::SelectionFlags currentCommand;
     QTimer timer;
+
+    // the statistics of the selected rows, updated by the selection changes
+    mutable bool statisticsDirty { true };
+    mutable QBitArray statisticsRows;
+    mutable int statisticsFiles { 0 };
+    mutable qint64 statisticsFileSize { 0 };
+    mutable QHash<int, qint64> statisticsFileSizes;
+    mutable QHash<int, QUrl> statisticsFolders;
 };
 
 }
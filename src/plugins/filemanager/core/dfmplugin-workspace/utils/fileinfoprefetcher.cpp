@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fileinfoprefetcher.h"
+
+#include <dfm-base/base/schemefactory.h>
+#include <dfm-base/dfm_global_defines.h>
+
+DFMBASE_USE_NAMESPACE
+using namespace dfmplugin_workspace;
+
+FileInfoPrefetcher::FileInfoPrefetcher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/*!
+ * \brief replace the pending requests, called in the main thread.
+ * \param visibleUrls the urls of the visible rows, they are fetched first
+ * \param prefetchUrls the urls of the rows around the visible rows
+ */
+void FileInfoPrefetcher::setRequests(const QList<QUrl> &visibleUrls, const QList<QUrl> &prefetchUrls)
+{
+    QMutexLocker lk(&mutex);
+    canceled = false;
+    requests.clear();
+    pendingUrls.clear();
+    for (const auto &urls : { visibleUrls, prefetchUrls }) {
+        for (const QUrl &url : urls) {
+            if (!url.isValid() || pendingUrls.contains(url))
+                continue;
+            pendingUrls.insert(url);
+            requests.append(url);
+        }
+    }
+
+    if (requests.isEmpty() || processing)
+        return;
+
+    processing = true;
+    QMetaObject::invokeMethod(this, "processRequests", Qt::QueuedConnection);
+}
+
+void FileInfoPrefetcher::cancel()
+{
+    QMutexLocker lk(&mutex);
+    canceled = true;
+    requests.clear();
+    pendingUrls.clear();
+}
+
+bool FileInfoPrefetcher::isPending(const QUrl &url) const
+{
+    QMutexLocker lk(&mutex);
+    return pendingUrls.contains(url);
+}
+
+void FileInfoPrefetcher::processRequests()
+{
+    forever {
+        QUrl url;
+        {
+            QMutexLocker lk(&mutex);
+            if (requests.isEmpty() || canceled) {
+                processing = false;
+                return;
+            }
+            url = requests.takeFirst();
+        }
+
+        prepareFileInfo(url);
+
+        {
+            QMutexLocker lk(&mutex);
+            // the url may be requested again while it is being prepared
+            if (!requests.contains(url))
+                pendingUrls.remove(url);
+        }
+
+        if (!canceled)
+            Q_EMIT fileInfoPrepared(url);
+    }
+}
+
+void FileInfoPrefetcher::prepareFileInfo(const QUrl &url)
+{
+    const auto &info = InfoFactory::create<FileInfo>(url);
+    if (!info)
+        return;
+
+    // the attributes are cached in the info, painting the row later reads them directly.
+    // the icon is left to the main thread, the icon theme loader is not thread safe.
+    info->fileMimeType();
+    info->displayOf(DisPlayInfoType::kSizeDisplayName);
+    info->displayOf(DisPlayInfoType::kMimeTypeDisplayName);
+}
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FILEINFOPREFETCHER_H
+#define FILEINFOPREFETCHER_H
+
+#include "dfmplugin_workspace_global.h"
+
+#include <QObject>
+#include <QMutex>
+#include <QUrl>
+#include <QList>
+#include <QSet>
+
+#include <atomic>
+
+namespace dfmplugin_workspace {
+
+/*!
+ * \brief The FileInfoPrefetcher class creates the file infos of the rows shown in the view
+ * and fetches their expensive attributes (mime type, size) in a worker thread.
+ * The visible rows are fetched first, then the rows around them. Each new request replaces
+ * the previous one, so the rows scrolled away are never fetched.
+ */
+class FileInfoPrefetcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FileInfoPrefetcher(QObject *parent = nullptr);
+
+    void setRequests(const QList<QUrl> &visibleUrls, const QList<QUrl> &prefetchUrls);
+    void cancel();
+    bool isPending(const QUrl &url) const;
+
+Q_SIGNALS:
+    void fileInfoPrepared(const QUrl &url);
+
+private Q_SLOTS:
+    void processRequests();
+
+private:
+    void prepareFileInfo(const QUrl &url);
+
+    mutable QMutex mutex;
+    QList<QUrl> requests;
+    QSet<QUrl> pendingUrls;
+    bool processing { false };
+    std::atomic_bool canceled { false };
+};
+
+}
+
+#endif   // FILEINFOPREFETCHER_H
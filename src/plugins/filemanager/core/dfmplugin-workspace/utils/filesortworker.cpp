@@ -10,16 +10,23 @@
 #include <dfm-base/utils/fileinfohelper.h>
 #include <dfm-base/base/standardpaths.h>
 #include <dfm-base/utils/universalutils.h>
+#include <dfm-base/utils/tracer.h>
 #include "workspacehelper.h"
 
 #include <dfm-io/dfmio_utils.h>
 
 #include <QStandardPaths>
+#include <QElapsedTimer>
+#include <QTimer>
 
 using namespace dfmplugin_workspace;
 using namespace dfmbase::Global;
 using namespace dfmio;
 
+// the interval of inserting the iterated children, in milliseconds
+static constexpr int kMinFlushInterval { 16 };
+static constexpr int kMaxFlushInterval { 200 };
+
 FileSortWorker::FileSortWorker(const QUrl &url, const QString &key, FileViewFilterCallback callfun, const QStringList &nameFilters, const QDir::Filters filters, const QDirIterator::IteratorFlags flags, QObject *parent)
     : QObject(parent), current(url), nameFilters(nameFilters), filters(filters), flags(flags), filterCallback(callfun), currentKey(key)
 {
@@ -137,7 +144,7 @@ void FileSortWorker::cancel()
 int FileSortWorker::getChildShowIndex(const QUrl &url)
 {
     QReadLocker lk(&locker);
-    return visibleChildren.indexOf(url);
+    return visibleIndexOf(url);
 }
 
 QList<QUrl> FileSortWorker::getChildrenUrls()
@@ -173,6 +180,7 @@ void FileSortWorker::handleIteratorLocalChildren(const QString &key,
                                                  const Qt::SortOrder sortOrder,
                                                  const bool isMixDirAndFile)
 {
+    flushIteratorChildren();
     handleAddChildren(key, children, {}, sortRole, sortOrder, isMixDirAndFile, false, false);
 }
 
@@ -182,16 +190,41 @@ void FileSortWorker::handleSourceChildren(const QString &key,
                                           const Qt::SortOrder sortOrder, const bool isMixDirAndFile,
                                           const bool isFinished)
 {
+    flushIteratorChildren();
     handleAddChildren(key, children, {}, sortRole, sortOrder, isMixDirAndFile, true, isFinished);
 }
 
+/*!
+ * \brief the iterated children are collected and inserted by flushIteratorChildren once
+ * per interval, so a large directory costs one row insertion per interval instead of one per batch.
+ */
 void FileSortWorker::handleIteratorChildren(const QString &key, const QList<SortInfoPointer> children, const QList<FileInfoPointer> infos)
 {
-    handleAddChildren(key, children, infos, sortRole, sortOrder, isMixDirAndFile, false, false, false);
+    if (currentKey != key || isCanceled || children.isEmpty())
+        return;
+
+    // the batches of the same dir are merged, the infos must stay aligned with the children
+    const QUrl &parentUrl = parantUrl(children.first()->fileUrl());
+    const bool aligned = infos.isEmpty() || infos.count() == children.count();
+    if (!pendingChildren.isEmpty()) {
+        auto &last = pendingChildren.last();
+        const bool lastAligned = last.infos.isEmpty() || last.infos.count() == last.children.count();
+        if (aligned && lastAligned && last.key == key && last.parent == parentUrl
+            && last.infos.isEmpty() == infos.isEmpty()) {
+            last.children.append(children);
+            last.infos.append(infos);
+            scheduleIteratorFlush();
+            return;
+        }
+    }
+
+    pendingChildren.append({ key, parentUrl, children, infos });
+    scheduleIteratorFlush();
 }
 
 void FileSortWorker::handleTraversalFinish(const QString &key)
 {
+    flushIteratorChildren();
     if (currentKey != key)
         return;
 
@@ -202,6 +235,7 @@ void FileSortWorker::handleTraversalFinish(const QString &key)
 
 void FileSortWorker::handleSortDir(const QString &key, const QUrl &parent)
 {
+    flushIteratorChildren();
     if (currentKey != key)
         return;
     auto dirUrl = parent;
@@ -221,11 +255,13 @@ void FileSortWorker::handleModelGetSourceData()
 
 void FileSortWorker::handleFilters(QDir::Filters filters)
 {
+    flushIteratorChildren();
     resetFilters(filters);
 }
 
 void FileSortWorker::HandleNameFilters(const QStringList &filters)
 {
+    flushIteratorChildren();
     nameFilters = filters;
     QHash<QUrl, FileItemDataPointer>::iterator itr = childrenDataMap.begin();
     for (; itr != childrenDataMap.end(); ++itr) {
@@ -236,6 +272,7 @@ void FileSortWorker::HandleNameFilters(const QStringList &filters)
 
 void FileSortWorker::handleFilterData(const QVariant &data)
 {
+    flushIteratorChildren();
     if (isCanceled)
         return;
 
@@ -248,6 +285,7 @@ void FileSortWorker::handleFilterData(const QVariant &data)
 
 void FileSortWorker::handleFilterCallFunc(FileViewFilterCallback callback)
 {
+    flushIteratorChildren();
     if (isCanceled)
         return;
 
@@ -260,6 +298,7 @@ void FileSortWorker::handleFilterCallFunc(FileViewFilterCallback callback)
 
 void FileSortWorker::onToggleHiddenFiles()
 {
+    flushIteratorChildren();
     auto tmpfilters = filters;
     tmpfilters = ~(tmpfilters ^ QDir::Filter(~QDir::Hidden));
     resetFilters(tmpfilters);
@@ -267,6 +306,7 @@ void FileSortWorker::onToggleHiddenFiles()
 
 void FileSortWorker::onShowHiddenFileChanged(bool isShow)
 {
+    flushIteratorChildren();
     if (isCanceled)
         return;
     QDir::Filters newFilters = filters;
@@ -281,6 +321,7 @@ void FileSortWorker::onShowHiddenFileChanged(bool isShow)
 
 void FileSortWorker::handleWatcherAddChildren(const QList<SortInfoPointer> &children)
 {
+    flushIteratorChildren();
     bool added = false;
     for (const auto &sortInfo : children) {
         if (isCanceled)
@@ -302,6 +343,7 @@ void FileSortWorker::handleWatcherAddChildren(const QList<SortInfoPointer> &chil
 
 void FileSortWorker::handleWatcherRemoveChildren(const QList<SortInfoPointer> &children)
 {
+    flushIteratorChildren();
     if (children.isEmpty())
         return;
     auto parentUrl = parantUrl(children.first()->fileUrl());
@@ -340,9 +382,9 @@ void FileSortWorker::handleWatcherRemoveChildren(const QList<SortInfoPointer> &c
         int showIndex = -1;
         {
             QReadLocker lk(&locker);
-            if (!visibleChildren.contains(sortInfo->fileUrl()))
+            showIndex = visibleIndexOf(sortInfo->fileUrl());
+            if (showIndex < 0)
                 continue;
-            showIndex = visibleChildren.indexOf(sortInfo->fileUrl());
         }
 
         Q_EMIT removeRows(showIndex, 1);
@@ -350,6 +392,7 @@ void FileSortWorker::handleWatcherRemoveChildren(const QList<SortInfoPointer> &c
         {
             QWriteLocker lk(&locker);
             visibleChildren.removeAt(showIndex);
+            invalidateVisibleIndex(showIndex);
         }
     }
     if (removed)
@@ -360,6 +403,7 @@ void FileSortWorker::handleWatcherRemoveChildren(const QList<SortInfoPointer> &c
 
 bool FileSortWorker::handleWatcherUpdateFile(const SortInfoPointer child)
 {
+    flushIteratorChildren();
     if (isCanceled)
         return false;
 
@@ -388,6 +432,7 @@ bool FileSortWorker::handleWatcherUpdateFile(const SortInfoPointer child)
 
 void FileSortWorker::handleWatcherUpdateFiles(const QList<SortInfoPointer> &children)
 {
+    flushIteratorChildren();
     bool added = false;
     for (auto sort : children) {
         if (isCanceled)
@@ -403,6 +448,7 @@ void FileSortWorker::handleWatcherUpdateFiles(const QList<SortInfoPointer> &chil
 
 void FileSortWorker::handleWatcherUpdateHideFile(const QUrl &hidUrl)
 {
+    flushIteratorChildren();
     if (isCanceled)
         return;
     auto hiddenFileInfo = InfoFactory::create<FileInfo>(hidUrl);
@@ -433,6 +479,7 @@ void FileSortWorker::handleWatcherUpdateHideFile(const QUrl &hidUrl)
 
 void FileSortWorker::handleResort(const Qt::SortOrder order, const ItemRoles sortRole, const bool isMixDirAndFile)
 {
+    flushIteratorChildren();
     if (isCanceled)
         return;
 
@@ -465,6 +512,7 @@ void FileSortWorker::onAppAttributeChanged(Application::ApplicationAttribute aa,
 
 bool FileSortWorker::handleUpdateFile(const QUrl &url)
 {
+    flushIteratorChildren();
     if (isCanceled)
         return false;
 
@@ -479,8 +527,8 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
     int childIndex = -1;
     {
         QReadLocker lk(&locker);
-        childVisible = visibleChildren.contains(url);
-        childIndex = visibleChildren.indexOf(url);
+        childIndex = visibleIndexOf(url);
+        childVisible = childIndex >= 0;
     }
 
     if (childVisible) {
@@ -489,6 +537,7 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
             {
                 QWriteLocker lk(&locker);
                 visibleChildren.removeAt(childIndex);
+                invalidateVisibleIndex(childIndex);
             }
             Q_EMIT removeFinish();
             return false;
@@ -539,6 +588,7 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
         {
             QWriteLocker lk(&locker);
             visibleChildren.insert(showIndex, sortInfo->fileUrl());
+            invalidateVisibleIndex(showIndex);
         }
         added = true;
 
@@ -565,6 +615,7 @@ void FileSortWorker::handleUpdateFiles(const QList<QUrl> &urls)
 
 void FileSortWorker::handleRefresh()
 {
+    flushIteratorChildren();
     int childrenCount = this->childrenCount();
     if (childrenCount > 0)
         Q_EMIT removeRows(0, childrenCount);
@@ -572,6 +623,7 @@ void FileSortWorker::handleRefresh()
     {
         QWriteLocker lk(&locker);
         visibleChildren.clear();
+        invalidateVisibleIndex(0);
     }
     children.clear();
     visibleTreeChildren.clear();
@@ -655,6 +707,7 @@ void FileSortWorker::handleSortByMimeType()
 
 void FileSortWorker::handleCloseExpand(const QString &key, const QUrl &parent)
 {
+    flushIteratorChildren();
     if (isCanceled || key != currentKey || UniversalUtils::urlEquals(parent, current))
         return;
     if (!children.keys().contains(parent))
@@ -664,6 +717,7 @@ void FileSortWorker::handleCloseExpand(const QString &key, const QUrl &parent)
 
 void FileSortWorker::handleSwitchTreeView(const bool isTree)
 {
+    flushIteratorChildren();
     if (isTree == istree)
         return;
     istree = isTree;
@@ -674,6 +728,40 @@ void FileSortWorker::handleSwitchTreeView(const bool isTree)
     }
 }
 
+void FileSortWorker::scheduleIteratorFlush()
+{
+    if (flushScheduled)
+        return;
+
+    flushScheduled = true;
+    QTimer::singleShot(flushInterval, this, &FileSortWorker::flushIteratorChildren);
+}
+
+/*!
+ * \brief insert the collected children, it's also called before handling any other
+ * change to keep the order of the requests.
+ */
+void FileSortWorker::flushIteratorChildren()
+{
+    flushScheduled = false;
+    if (pendingChildren.isEmpty())
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const auto batches = std::move(pendingChildren);
+    pendingChildren.clear();
+    for (const auto &batch : batches) {
+        if (isCanceled)
+            return;
+        handleAddChildren(batch.key, batch.children, batch.infos, sortRole, sortOrder, isMixDirAndFile, false, false, false);
+    }
+
+    // keep inserting from taking the whole thread, the interval follows the cost of the last insertion
+    flushInterval = qBound(kMinFlushInterval, static_cast<int>(timer.elapsed()) * 2, kMaxFlushInterval);
+}
+
 void FileSortWorker::handleAddChildren(const QString &key,
                                        QList<SortInfoPointer> children,
                                        const QList<FileInfoPointer> &childInfos,
@@ -818,6 +906,7 @@ void FileSortWorker::filterAndSortFiles(const QUrl &dir, const bool fileter, con
 {
     if (isCanceled)
         return;
+    dfmTraceSpan("sort", "FileSortWorker::filterAndSortFiles");
     // 先排深度是0的url
     QList<QUrl> visibleList;
     auto startPos = findStartPos(dir);
@@ -857,6 +946,7 @@ void FileSortWorker::resortCurrent(const bool reverse)
 {
     if (isCanceled)
         return;
+    dfmTraceSpan("sort", "FileSortWorker::resortCurrent");
 
     QList<QUrl> visibleList;
 
@@ -923,6 +1013,7 @@ void FileSortWorker::filterTreeDirFiles(const QUrl &parent, const bool byInfo)
             Q_EMIT removeRows(0, visibleChildren.count());
             QWriteLocker lk(&locker);
             visibleChildren.clear();
+            invalidateVisibleIndex(0);
             Q_EMIT removeFinish();
         }
         return;
@@ -1003,6 +1094,7 @@ bool FileSortWorker::addChild(const SortInfoPointer &sortInfo,
     {
         QWriteLocker lk(&locker);
         visibleChildren.insert(showIndex, sortInfo->fileUrl());
+        invalidateVisibleIndex(showIndex);
     }
 
     if (sort == AbstractSortFilter::SortScenarios::kSortScenariosWatcherAddFile)
@@ -1311,6 +1403,7 @@ void FileSortWorker::removeVisibleChildren(const int startPos, const int size)
 
         QWriteLocker lk(&locker);
         visibleChildren = visibleList;
+        invalidateVisibleIndex(startPos);
     }
 
     Q_EMIT removeFinish();
@@ -1661,7 +1754,44 @@ int FileSortWorker::findRealShowIndex(const QUrl &preItemUrl)
 int FileSortWorker::indexOfVisibleChild(const QUrl &itemUrl)
 {
     QReadLocker lk(&locker);
-    return visibleChildren.indexOf(itemUrl);
+    return visibleIndexOf(itemUrl);
+}
+
+/*!
+ * \brief the row of the url in visibleChildren, the caller must hold the locker.
+ * The rows before visibleIndexValid are indexed, the others are indexed when they are
+ * looked up, so appending rows never reindexes the rows before them.
+ */
+int FileSortWorker::visibleIndexOf(const QUrl &url)
+{
+    QMutexLocker lk(&visibleIndexMutex);
+    const int count = visibleChildren.count();
+    if (visibleIndexValid < count) {
+        // the entries of removed rows are left in the hash, drop them once they pile up
+        if (visibleIndex.count() > count * 2) {
+            visibleIndex.clear();
+            visibleIndexValid = 0;
+        }
+        visibleIndex.reserve(count);
+        for (int row = visibleIndexValid; row < count; ++row)
+            visibleIndex.insert(visibleChildren.at(row), row);
+        visibleIndexValid = count;
+    }
+
+    const int row = visibleIndex.value(url, -1);
+    if (row < 0 || row >= count || visibleChildren.at(row) != url)
+        return -1;
+
+    return row;
+}
+
+// the caller must hold the write locker
+void FileSortWorker::invalidateVisibleIndex(const int fromRow)
+{
+    QMutexLocker lk(&visibleIndexMutex);
+    visibleIndexValid = qMax(0, qMin(visibleIndexValid, fromRow));
+    if (visibleIndexValid == 0)
+        visibleIndex.clear();
 }
 
 int FileSortWorker::setVisibleChildren(const int startPos, const QList<QUrl> &filterUrls, const FileSortWorker::InsertOpt opt, const int endPos)
@@ -1685,6 +1815,7 @@ int FileSortWorker::setVisibleChildren(const int startPos, const QList<QUrl> &fi
 
     QWriteLocker lk(&locker);
     visibleChildren = visibleList;
+    invalidateVisibleIndex(opt == InsertOpt::kInsertOptForce ? 0 : startPos);
 
     return visibleList.length();
 }
@@ -19,6 +19,7 @@
 #include <QObject>
 #include <QDirIterator>
 #include <QReadWriteLock>
+#include <QMutex>
 #include <QMultiMap>
 
 using namespace dfmbase;
@@ -38,6 +39,14 @@ class FileSortWorker : public QObject
         kInsertOptForce = 2,
     };
 
+    struct PendingChildren
+    {
+        QString key;
+        QUrl parent;
+        QList<SortInfoPointer> children;
+        QList<FileInfoPointer> infos;
+    };
+
 public:
     explicit FileSortWorker(const QUrl &url,
                             const QString &key,
@@ -157,6 +166,8 @@ private:
     bool handleAddChildren(const QString &key,
                            const QList<SortInfoPointer> &children,
                            const QList<FileInfoPointer> &childInfos);
+    void scheduleIteratorFlush();
+    void flushIteratorChildren();
     void setSourceHandleState(const bool isFinished);
     void resetFilters(const QDir::Filters filters = QDir::NoFilter);
     void checkNameFilters(const FileItemDataPointer itemData);
@@ -203,6 +214,8 @@ private:
     int8_t getDepth(const QUrl &url);
     int findRealShowIndex(const QUrl &preItemUrl);
     int indexOfVisibleChild(const QUrl &itemUrl);
+    int visibleIndexOf(const QUrl &url);
+    void invalidateVisibleIndex(const int fromRow);
     int setVisibleChildren(const int startPos, const QList<QUrl> &filterUrls,
                             const InsertOpt opt = InsertOpt::kInsertOptAppend, const int endPos = -1);
     bool checkAndUpdateFileInfoUpdate();
@@ -219,6 +232,9 @@ private:
     QHash<QUrl, FileItemDataPointer> childrenDataLastMap {};
     QList<QUrl> visibleChildren {};
     QReadWriteLock locker;
+    QMutex visibleIndexMutex;
+    QHash<QUrl, int> visibleIndex {};
+    int visibleIndexValid { 0 };
     AbstractSortFilterPointer sortAndFilter { nullptr };
     FileViewFilterCallback filterCallback { nullptr };
     QVariant filterData;
@@ -238,6 +254,9 @@ private:
     QTimer *updateRefresh {nullptr};
     std::atomic_bool mimeSorting{ false };
     QSet<QUrl> waitUpdatedFiles;
+    QList<PendingChildren> pendingChildren;
+    bool flushScheduled { false };
+    int flushInterval { 16 };
 };
 
 }
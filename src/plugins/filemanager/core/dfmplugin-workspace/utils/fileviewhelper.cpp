@@ -90,7 +90,8 @@ bool FileViewHelper::isTransparent(const QModelIndex &index) const
 
 const FileInfoPointer FileViewHelper::fileInfo(const QModelIndex &index) const
 {
-    if (!parent()->isVerticalScrollBarSliderDragging())
+    // the pending info is being prepared by the prefetcher, the row is updated once it is ready
+    if (!parent()->isVerticalScrollBarSliderDragging() && !parent()->model()->isFileInfoPending(index))
         index.data(kItemCreateFileInfoRole);
 
     return parent()->model()->fileInfo(index);
@@ -214,6 +215,13 @@ QModelIndex FileViewHelper::findIndex(const QByteArray &keys, bool matchStart, i
                        : pinyinName.contains(keys, Qt::CaseInsensitive)) {
             return index;
         }
+
+        const QString &pinyinInitials = parent()->model()->data(index, kItemFilePinyinInitialsRole).toString();
+        if (pinyinInitials != pinyinName
+            && (matchStart ? pinyinInitials.startsWith(keys, Qt::CaseInsensitive)
+                           : pinyinInitials.contains(keys, Qt::CaseInsensitive))) {
+            return index;
+        }
     }
 
     return QModelIndex();
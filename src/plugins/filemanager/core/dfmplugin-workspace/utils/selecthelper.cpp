@@ -12,6 +12,8 @@
 #include <DSizeMode>
 #endif
 
+#include <algorithm>
+
 DFMBASE_USE_NAMESPACE
 using namespace dfmplugin_workspace;
 
@@ -110,8 +112,8 @@ bool SelectHelper::select(const QList<QUrl> &urls)
     QModelIndex lastIndex;
     const QModelIndex &root = view->rootIndex();
     view->selectionModel()->clearSelection();
-    QList<QModelIndex> indexes {};
-    QItemSelection selection;
+    QVector<int> rows;
+    rows.reserve(urls.count());
     for (const QUrl &url : urls) {
         const QModelIndex &index = view->model()->getIndexByUrl(url);
 
@@ -119,7 +121,7 @@ bool SelectHelper::select(const QList<QUrl> &urls)
             continue;
         }
 
-        selection.merge(QItemSelection(index, index), QItemSelectionModel::Select);
+        rows.append(index.row());
 
         if (!firstIndex.isValid())
             firstIndex = index;
@@ -127,9 +129,28 @@ bool SelectHelper::select(const QList<QUrl> &urls)
         lastIndex = index;
     }
 
-    if (selection.indexes().isEmpty())
+    if (rows.isEmpty())
         return false;
 
+    // merge the sorted rows into contiguous ranges in one pass
+    std::sort(rows.begin(), rows.end());
+    QItemSelection selection;
+    int rangeBegin = rows.first();
+    int rangeEnd = rangeBegin;
+    auto appendRange = [&] {
+        selection.append(QItemSelectionRange(view->model()->index(rangeBegin, 0, root),
+                                             view->model()->index(rangeEnd, 0, root)));
+    };
+    for (int row : rows) {
+        if (row <= rangeEnd + 1) {
+            rangeEnd = qMax(rangeEnd, row);
+            continue;
+        }
+        appendRange();
+        rangeBegin = rangeEnd = row;
+    }
+    appendRange();
+
     view->selectionModel()->select(selection, QItemSelectionModel::Select);
 
     if (lastIndex.isValid())
@@ -16,6 +16,9 @@ using namespace dfmbase;
 using namespace dfmplugin_workspace;
 USING_IO_NAMESPACE
 
+static constexpr int kFirstBatchTime { 100 };
+static constexpr int kFirstBatchCount { 64 };
+
 TraversalDirThreadManager::TraversalDirThreadManager(const QUrl &url,
                                                      const QStringList &nameFilters,
                                                      QDir::Filters filters,
@@ -149,6 +152,9 @@ int TraversalDirThreadManager::iteratorOneByOne(const QElapsedTimer &timere)
     QList<FileInfoPointer> childrenList;   // 当前遍历出来的所有文件
     QSet<QUrl> urls;
     int filecount = 0;
+    // the first batch is small to show the first screen soon, the later ones grow to cut the signals
+    int batchTime = qMin(kFirstBatchTime, timeCeiling);
+    int batchCount = qMin(kFirstBatchCount, countCeiling);
     while (dirIterator->hasNext()) {
         if (stopFlag)
             break;
@@ -173,10 +179,12 @@ int TraversalDirThreadManager::iteratorOneByOne(const QElapsedTimer &timere)
         childrenList.append(fileInfo);
         filecount++;
 
-        if (timer->elapsed() > timeCeiling || childrenList.count() > countCeiling) {
+        if (timer->elapsed() > batchTime || childrenList.count() > batchCount) {
             emit updateChildrenManager(childrenList, traversalToken);
             timer->restart();
             childrenList.clear();
+            batchTime = qMin(batchTime * 2, timeCeiling);
+            batchCount = qMin(batchCount * 2, countCeiling);
         }
     }
 
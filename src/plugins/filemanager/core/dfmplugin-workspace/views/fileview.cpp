@@ -88,6 +88,7 @@ FileView::FileView(const QUrl &url, QWidget *parent)
     initializeStatusBar();
     initializeConnect();
     initializeScrollBarWatcher();
+    initializeVisibleRangeWatcher();
     initializePreSelectTimer();
 
     viewport()->installEventFilter(this);
@@ -1148,6 +1149,7 @@ void FileView::onRowCountChanged()
     static_cast<FileSelectionModel *>(selectionModel())->clearSelectList();
 
     delayUpdateStatusBar();
+    delayUpdateVisibleRange();
     updateContentLabel();
 }
 
@@ -1204,6 +1206,7 @@ void FileView::resizeEvent(QResizeEvent *event)
         updateViewportContentsMargins(itemSizeHint());
 
     verticalScrollBar()->setFixedHeight(rect().height() - d->statusBar->height() - (d->headerView ? d->headerView->height() : 0));
+    delayUpdateVisibleRange();
 }
 
 void FileView::setSelection(const QRect &rect, QItemSelectionModel::SelectionFlags flags)
@@ -1946,6 +1949,16 @@ void FileView::initializeScrollBarWatcher()
     });
 }
 
+void FileView::initializeVisibleRangeWatcher()
+{
+    d->visibleRangeTimer = new QTimer(this);
+    d->visibleRangeTimer->setInterval(50);
+    d->visibleRangeTimer->setSingleShot(true);
+
+    connect(d->visibleRangeTimer, &QTimer::timeout, this, &FileView::updateVisibleRange);
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &FileView::delayUpdateVisibleRange);
+}
+
 void FileView::initializePreSelectTimer()
 {
     d->preSelectTimer = new QTimer(this);
@@ -1958,6 +1971,40 @@ void FileView::initializePreSelectTimer()
     });
 }
 
+void FileView::delayUpdateVisibleRange()
+{
+    if (d->visibleRangeTimer)
+        d->visibleRangeTimer->start();
+}
+
+void FileView::updateVisibleRange()
+{
+    if (!model())
+        return;
+
+    // prefetch nothing while dragging the slider, the rows are skipped anyway
+    if (isVerticalScrollBarSliderDragging()) {
+        delayUpdateVisibleRange();
+        return;
+    }
+
+    const QRect &rect = viewport()->rect().translated(horizontalOffset(), verticalOffset());
+    const RandeIndexList &list = visibleIndexes(rect);
+    if (list.isEmpty()) {
+        model()->setVisibleRange(0, -1);
+        return;
+    }
+
+    int first = list.first().first;
+    int last = list.first().second;
+    for (const RandeIndex &range : list) {
+        first = qMin(first, range.first);
+        last = qMax(last, range.second);
+    }
+
+    model()->setVisibleRange(first, last);
+}
+
 void FileView::updateStatusBar()
 {
     if (model()->currentState() != ModelState::kIdle)
@@ -1970,21 +2017,8 @@ void FileView::updateStatusBar()
         return;
     }
 
-    QList<QUrl> list;
-    int selectFiles = 0;
-    int selectFolders = 0;
-    qint64 filesizes = 0;
-    for (const auto &index : selectedIndexes()) {
-        if (index.data(Global::ItemRoles::kItemFileIsDirRole).toBool()) {
-            selectFolders++;
-            list << index.data(Global::ItemRoles::kItemUrlRole).value<QUrl>();
-        } else {
-            selectFiles++;
-            filesizes += index.data(Global::ItemRoles::kItemFileSizeIntRole).toLongLong();
-        }
-    }
-
-    d->statusBar->itemSelected(selectFiles, selectFolders, filesizes, list);
+    const auto &statistics = static_cast<FileSelectionModel *>(selectionModel())->selectionStatistics();
+    d->statusBar->itemSelected(statistics.fileCount, statistics.folderCount, statistics.fileSize, statistics.folderUrls);
 }
 
 void FileView::updateLoadingIndicator()
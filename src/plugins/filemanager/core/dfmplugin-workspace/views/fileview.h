@@ -193,8 +193,11 @@ private:
     void initializeConnect();
     void initializeScrollBarWatcher();
     void initializePreSelectTimer();
+    void initializeVisibleRangeWatcher();
 
     void delayUpdateStatusBar();
+    void delayUpdateVisibleRange();
+    void updateVisibleRange();
     void updateStatusBar();
     void updateLoadingIndicator();
     void updateContentLabel();
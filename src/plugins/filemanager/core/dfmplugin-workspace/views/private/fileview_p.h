@@ -72,6 +72,7 @@ class FileViewPrivate
     QMap<QString, bool> columnForRoleHiddenMap;
 
     QTimer *scrollBarValueChangedTimer { nullptr };
+    QTimer *visibleRangeTimer { nullptr };
     bool scrollBarSliderPressed { false };
 
     bool pressedStartWithExpand { false };
@@ -12,6 +12,7 @@
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/utils/tracer.h>
 
 // Lucune++ headers
 #include <FileUtils.h>
@@ -250,6 +251,7 @@ DocumentPtr FullTextSearcherPrivate::fileDocument(const QString &file)
 
 bool FullTextSearcherPrivate::createIndex(const QString &path)
 {
+    dfmTraceSpan("search", "FullTextSearcher::createIndex");
     QDir dir;
     if (!dir.exists(path)) {
         fmWarning() << "Source directory doesn't exist: " << path;
@@ -293,6 +295,7 @@ bool FullTextSearcherPrivate::createIndex(const QString &path)
 
 bool FullTextSearcherPrivate::updateIndex(const QString &path)
 {
+    dfmTraceSpan("search", "FullTextSearcher::updateIndex");
     QString bindPath = FileUtils::bindPathTransform(path, false);
     try {
         IndexReaderPtr reader = newIndexReader();
@@ -318,6 +321,7 @@ bool FullTextSearcherPrivate::updateIndex(const QString &path)
 
 bool FullTextSearcherPrivate::doSearch(const QString &path, const QString &keyword)
 {
+    dfmTraceSpan("search", "FullTextSearcher::doSearch");
     fmInfo() << "search path: " << path << " keyword: " << keyword;
     notifyTimer.start();
 
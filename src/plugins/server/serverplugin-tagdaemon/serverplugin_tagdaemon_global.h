@@ -24,7 +24,8 @@ enum class QueryOpts : int {
     kTagsOfFile,   // get tags of a file
     kFilesOfTag,   // get files of a tag
     kColorOfTags,   // get color-tag map
-    kTagIntersectionOfFiles   // get tag intersection of files
+    kTagIntersectionOfFiles,   // get tag intersection of files
+    kFilesWithTagsInDirs   // get files with tags in the directories, not recursively
 };
 
 enum class InsertOpts : int {
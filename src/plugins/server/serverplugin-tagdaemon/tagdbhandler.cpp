@@ -180,6 +180,42 @@ QVariantHash TagDbHandler::getAllFileWithTags()
     return fileTagsMap;
 }
 
+/*!
+ * \brief the tagged files directly in \a dirs, file path -> tag names
+ */
+QVariantHash TagDbHandler::getFilesWithTagsInDirs(const QStringList &dirs)
+{
+    DFMBASE_NAMESPACE::FinallyUtil finally([&]() { lastErr.clear(); });
+    if (dirs.isEmpty()) {
+        lastErr = "input parameter is empty!";
+        return {};
+    }
+
+    // query
+    const auto &field = Expression::Field<FileTagInfo>;
+    QVariantHash fileTagsMap;
+    for (const QString &dir : dirs) {
+        const QString prefix = dir.endsWith('/') ? dir : dir + '/';
+        const auto &beans = handle->query<FileTagInfo>().where(field("filePath") & QString(prefix + "%")).toBeans();
+        for (auto &bean : beans) {
+            const QString &path = bean->getFilePath();
+            // the wildcards in dir and the files in sub directories are matched too.
+            if (!path.startsWith(prefix) || path.indexOf('/', prefix.size()) >= 0)
+                continue;
+
+            QStringList list { fileTagsMap.value(path).toStringList() };
+            const QString &tagName { bean->getTagName() };
+            if (!list.contains(tagName)) {
+                list.append(tagName);
+                fileTagsMap[path] = list;
+            }
+        }
+    }
+
+    finally.dismiss();
+    return fileTagsMap;
+}
+
 bool TagDbHandler::addTagProperty(const QVariantMap &data)
 {
     DFMBASE_NAMESPACE::FinallyUtil finally([&]() { lastErr.clear(); });
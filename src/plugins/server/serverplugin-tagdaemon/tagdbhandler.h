@@ -45,6 +45,7 @@ public:
     QVariant getSameTagsOfDiffUrls(const QStringList &urlList);
     QVariantMap getFilesByTag(const QStringList &tags);
     QVariantHash getAllFileWithTags();
+    QVariantHash getFilesWithTagsInDirs(const QStringList &dirs);
 
     bool addTagProperty(const QVariantMap &data);
     bool addTagsForFiles(const QVariantMap &data);
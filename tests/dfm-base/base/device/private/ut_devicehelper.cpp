@@ -176,6 +176,22 @@ TEST_F(UT_DeviceHelper, IsEjectableBlockDev)
     EXPECT_EQ("device is not removable or is not ejectable optical item", reason);
 }
 
+TEST_F(UT_DeviceHelper, IsMatchedQueryOptions)
+{
+    using namespace GlobalServerDefines;
+    QVariantMap devCase { { DeviceProperty::kRemovable, true },
+                          { DeviceProperty::kMountPoint, "/media/test" },
+                          { DeviceProperty::kOptical, false } };
+    EXPECT_TRUE(DeviceHelper::isMatchedQueryOptions(devCase, DeviceQueryOption::kNoCondition));
+    EXPECT_TRUE(DeviceHelper::isMatchedQueryOptions(devCase, DeviceQueryOption::kMounted | DeviceQueryOption::kRemovable));
+    EXPECT_FALSE(DeviceHelper::isMatchedQueryOptions(devCase, DeviceQueryOption::kNotMounted));
+    EXPECT_FALSE(DeviceHelper::isMatchedQueryOptions(devCase, DeviceQueryOption::kOptical));
+
+    devCase[DeviceProperty::kMountPoint] = "";
+    EXPECT_FALSE(DeviceHelper::isMatchedQueryOptions(devCase, DeviceQueryOption::kMounted));
+    EXPECT_TRUE(DeviceHelper::isMatchedQueryOptions(devCase, DeviceQueryOption::kNotMounted));
+}
+
 TEST_F(UT_DeviceHelper, AskForStopScanning)
 {
     bool isScanning = false;
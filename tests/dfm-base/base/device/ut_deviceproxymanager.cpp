@@ -277,3 +277,50 @@ TEST_F(UT_DeviceProxyManagerPrivate, RemoveMounts)
     EXPECT_NO_FATAL_FAILURE(DevProxyMng->d->removeMounts(""));
     EXPECT_NO_FATAL_FAILURE(DevProxyMng->d->removeMounts("1234"));
 }
+
+TEST_F(UT_DeviceProxyManagerPrivate, UpdateBlockReplicaOnEject)
+{
+    using namespace GlobalServerDefines;
+    const QString id("/org/freedesktop/UDisks2/block_devices/sr0");
+    auto d = DevProxyMng->d.data();
+    d->blockReplica.insert(id, QVariantMap { { DeviceProperty::kOptical, true },
+                                             { DeviceProperty::kOpticalMediaType, "dvd_r" },
+                                             { DeviceProperty::kOpticalWriteSpeed, QStringList { "4x" } },
+                                             { DeviceProperty::kSizeTotal, 4096 },
+                                             { DeviceProperty::kSizeFree, 1024 },
+                                             { DeviceProperty::kSizeUsed, 3072 },
+                                             { DeviceProperty::kMountPoint, "/media/disc" } });
+    d->replicaReady = true;
+
+    int reloads = 0;
+    stub.set_lamda(&DeviceProxyManagerPrivate::isDBusConnected, [] { __DBG_STUB_INVOKE__ return true; });
+    stub.set_lamda(&OrgDeepinFilemanagerServerDeviceManagerInterface::QueryBlockDeviceInfo, [&reloads] {
+        __DBG_STUB_INVOKE__
+        ++reloads;
+        return QDBusPendingReply<QVariantMap> {};
+    });
+
+    // the media is reloaded from the server, it's updated in place if the server fails
+    d->updateBlockReplicaProperty(id, DeviceProperty::kMediaAvailable, false);
+    EXPECT_EQ(1, reloads);
+    d->updateBlockReplicaProperty(id, DeviceProperty::kMountPoints, QStringList());
+    d->updateBlockReplicaProperty(id, DeviceProperty::kOptical, false);
+    EXPECT_EQ(1, reloads);
+
+    QVariantMap info;
+    ASSERT_TRUE(d->findReplica(id, true, &info));
+    EXPECT_FALSE(info.value(DeviceProperty::kMediaAvailable).toBool());
+    EXPECT_FALSE(info.value(DeviceProperty::kOptical).toBool());
+    EXPECT_TRUE(info.value(DeviceProperty::kOpticalMediaType).toString().isEmpty());
+    EXPECT_TRUE(info.value(DeviceProperty::kOpticalWriteSpeed).toStringList().isEmpty());
+    EXPECT_EQ(0, info.value(DeviceProperty::kSizeTotal).toLongLong());
+    EXPECT_EQ(0, info.value(DeviceProperty::kSizeUsed).toLongLong());
+    // the mount point is removed when the device is unmounted
+    EXPECT_EQ(QString("/media/disc"), info.value(DeviceProperty::kMountPoint).toString());
+
+    d->updateBlockReplicaProperty(id, DeviceProperty::kMountPoints, QStringList { "/media/other" });
+    ASSERT_TRUE(d->findReplica(id, true, &info));
+    EXPECT_EQ(QString("/media/other"), info.value(DeviceProperty::kMountPoint).toString());
+
+    d->resetReplica();
+}
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/mimetype/mimeappsindex.h"
+
+#include <QTemporaryDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+static void writeDesktopFile(const QString &path, const QString &mimeTypes)
+{
+    QFile file(path);
+    file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    file.write(QString("[Desktop Entry]\nName=Test\nExec=test %U\nType=Application\nMimeType=%1\n")
+                       .arg(mimeTypes)
+                       .toUtf8());
+    file.close();
+}
+
+class UT_MimeAppsIndex : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(appsDir.isValid());
+        ASSERT_TRUE(cacheDir.isValid());
+        writeDesktopFile(appsDir.filePath("a.desktop"), "text/plain;image/png;");
+        writeDesktopFile(appsDir.filePath("b.desktop"), "text/plain;");
+    }
+
+    QTemporaryDir appsDir;
+    QTemporaryDir cacheDir;
+};
+
+TEST_F(UT_MimeAppsIndex, refreshBuildsMimeApps)
+{
+    MimeAppsIndex index(cacheDir.filePath("MimeApps.index"));
+    EXPECT_TRUE(index.refresh({ appsDir.path() }, {}));
+    EXPECT_EQ(index.entries().size(), 2);
+    EXPECT_EQ(index.appsForMimeType("text/plain").size(), 2);
+    EXPECT_EQ(index.appsForMimeType("image/png"), QStringList { appsDir.filePath("a.desktop") });
+
+    // nothing changed on disk
+    EXPECT_FALSE(index.refresh({ appsDir.path() }, {}));
+}
+
+TEST_F(UT_MimeAppsIndex, refreshChangedFile)
+{
+    MimeAppsIndex index(cacheDir.filePath("MimeApps.index"));
+    index.refresh({ appsDir.path() }, {});
+
+    QFile::remove(appsDir.filePath("b.desktop"));
+    EXPECT_TRUE(index.refresh({ appsDir.path() }, {}, { appsDir.filePath("b.desktop") }));
+    EXPECT_EQ(index.entries().size(), 1);
+    EXPECT_EQ(index.appsForMimeType("text/plain"), QStringList { appsDir.filePath("a.desktop") });
+}
+
+TEST_F(UT_MimeAppsIndex, saveAndLoad)
+{
+    const QString &indexFile = cacheDir.filePath("MimeApps.index");
+    {
+        MimeAppsIndex index(indexFile);
+        index.refresh({ appsDir.path() }, {});
+        EXPECT_TRUE(index.save());
+    }
+
+    MimeAppsIndex index(indexFile);
+    EXPECT_TRUE(index.load());
+    EXPECT_EQ(index.entries().size(), 2);
+    EXPECT_EQ(index.appsForMimeType("text/plain").size(), 2);
+    EXPECT_FALSE(index.refresh({ appsDir.path() }, {}));
+    EXPECT_FALSE(index.load());
+}
+
+TEST_F(UT_MimeAppsIndex, ownSaveNotReloaded)
+{
+    const QString &indexFile = cacheDir.filePath("MimeApps.index");
+    MimeAppsIndex index(indexFile);
+    index.refresh({ appsDir.path() }, {});
+    EXPECT_TRUE(index.save());
+
+    // the file written by itself is not an external change
+    EXPECT_FALSE(index.load());
+}
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/mimetype/mimetypecache.h"
+#include "dfm-base/mimetype/dmimedatabase.h"
+#include "dfm-base/base/device/deviceutils.h"
+
+#include <stubext.h>
+
+#include <QTemporaryDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+class UT_MimeTypeCache : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(dir.isValid());
+        filePath = dir.filePath("test.txt");
+        QFile file(filePath);
+        file.open(QIODevice::WriteOnly);
+        file.write("hello");
+        file.close();
+        MimeTypeCache::instance()->clear();
+    }
+
+    QTemporaryDir dir;
+    QString filePath;
+};
+
+TEST_F(UT_MimeTypeCache, makeKey)
+{
+    MimeTypeCacheKey key;
+    EXPECT_TRUE(MimeTypeCache::makeKey(filePath, QMimeDatabase::MatchDefault, &key));
+    EXPECT_EQ(key.size, 5);
+    EXPECT_FALSE(MimeTypeCache::makeKey(dir.path(), QMimeDatabase::MatchDefault, &key));
+    EXPECT_FALSE(MimeTypeCache::makeKey(dir.filePath("none"), QMimeDatabase::MatchDefault, &key));
+}
+
+TEST_F(UT_MimeTypeCache, findAndInsert)
+{
+    MimeTypeCacheKey key;
+    ASSERT_TRUE(MimeTypeCache::makeKey(filePath, QMimeDatabase::MatchDefault, &key));
+
+    const auto before = MimeTypeCache::instance()->statistics();
+    QString name;
+    EXPECT_FALSE(MimeTypeCache::instance()->find(filePath, key, &name));
+
+    MimeTypeCache::instance()->insert(filePath, key, "text/plain");
+    EXPECT_TRUE(MimeTypeCache::instance()->find(filePath, key, &name));
+    EXPECT_EQ(name, QString("text/plain"));
+
+    const auto after = MimeTypeCache::instance()->statistics();
+    EXPECT_EQ(after.hits - before.hits, 1);
+    EXPECT_EQ(after.misses - before.misses, 1);
+}
+
+TEST_F(UT_MimeTypeCache, changedFileMissed)
+{
+    MimeTypeCacheKey key;
+    ASSERT_TRUE(MimeTypeCache::makeKey(filePath, QMimeDatabase::MatchDefault, &key));
+    MimeTypeCache::instance()->insert(filePath, key, "text/plain");
+
+    QFile file(filePath);
+    file.open(QIODevice::Append);
+    file.write(" world");
+    file.close();
+
+    MimeTypeCacheKey newKey;
+    ASSERT_TRUE(MimeTypeCache::makeKey(filePath, QMimeDatabase::MatchDefault, &newKey));
+    EXPECT_FALSE(MimeTypeCache::instance()->find(filePath, newKey, nullptr));
+}
+
+TEST_F(UT_MimeTypeCache, uncachedModes)
+{
+    stub_ext::StubExt stub;
+    int keys = 0;
+    stub.set_lamda(&MimeTypeCache::makeKey, [&keys] {
+        __DBG_STUB_INVOKE__
+        ++keys;
+        return false;
+    });
+
+    DMimeDatabase db;
+    EXPECT_EQ(db.mimeTypeForFile(filePath, QMimeDatabase::MatchExtension, QString()).name(), QString("text/plain"));
+    EXPECT_EQ(keys, 0);
+
+    db.mimeTypeForFile(filePath, QMimeDatabase::MatchDefault, QString());
+    EXPECT_EQ(keys, 1);
+}
+
+TEST_F(UT_MimeTypeCache, lowSpeedDeviceOnMiss)
+{
+    stub_ext::StubExt stub;
+    int checks = 0;
+    bool lowSpeed = true;
+    stub.set_lamda(&DeviceUtils::isLowSpeedDevice, [&checks, &lowSpeed] {
+        __DBG_STUB_INVOKE__
+        ++checks;
+        return lowSpeed;
+    });
+
+    // the files on low speed devices are not cached
+    DMimeDatabase db;
+    db.mimeTypeForFile(filePath, QMimeDatabase::MatchDefault, QString());
+    auto before = MimeTypeCache::instance()->statistics();
+    db.mimeTypeForFile(filePath, QMimeDatabase::MatchDefault, QString());
+    EXPECT_EQ(MimeTypeCache::instance()->statistics().misses - before.misses, 1);
+
+    // a cached file is found without checking the device
+    lowSpeed = false;
+    db.mimeTypeForFile(filePath, QMimeDatabase::MatchDefault, QString());
+    checks = 0;
+    before = MimeTypeCache::instance()->statistics();
+    EXPECT_EQ(db.mimeTypeForFile(filePath, QMimeDatabase::MatchDefault, QString()).name(), QString("text/plain"));
+    EXPECT_EQ(MimeTypeCache::instance()->statistics().hits - before.hits, 1);
+    EXPECT_EQ(checks, 0);
+}
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/thumbnail/thumbnailindex.h"
+
+#include <QTemporaryDir>
+#include <QCryptographicHash>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+DFMGLOBAL_USE_NAMESPACE
+
+static QByteArray md5Of(const QString &url)
+{
+    return QCryptographicHash::hash(url.toLocal8Bit(), QCryptographicHash::Md5).toHex();
+}
+
+class UT_ThumbnailIndex : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(cacheDir.isValid());
+    }
+
+    QTemporaryDir cacheDir;
+};
+
+TEST_F(UT_ThumbnailIndex, markAndLookup)
+{
+    ThumbnailIndex index(cacheDir.filePath("thumbnail.index"), 64);
+    const QByteArray &a = md5Of("file:///tmp/a.png");
+    const QByteArray &b = md5Of("file:///tmp/b.png");
+
+    EXPECT_EQ(index.state(a, kLarge, 100), ThumbnailIndex::kNeedGenerate);
+
+    index.markFresh(a, kLarge, 100);
+    index.markFailed(b, kLarge, 200);
+    EXPECT_EQ(index.state(a, kLarge, 100), ThumbnailIndex::kFresh);
+    EXPECT_EQ(index.state(a, kNormal, 100), ThumbnailIndex::kNeedGenerate);
+    EXPECT_EQ(index.state(b, kLarge, 200), ThumbnailIndex::kFailed);
+
+    // the file is modified
+    EXPECT_EQ(index.state(a, kLarge, 101), ThumbnailIndex::kNeedGenerate);
+    EXPECT_EQ(index.state(b, kLarge, 201), ThumbnailIndex::kNeedGenerate);
+
+    index.remove(a, kLarge);
+    EXPECT_EQ(index.state(a, kLarge, 100), ThumbnailIndex::kNeedGenerate);
+}
+
+TEST_F(UT_ThumbnailIndex, sharedByInstances)
+{
+    const QString &indexFile = cacheDir.filePath("thumbnail.index");
+    const QByteArray &a = md5Of("file:///tmp/a.png");
+
+    ThumbnailIndex writer(indexFile, 64);
+    ThumbnailIndex reader(indexFile, 1024);
+    writer.markFresh(a, kLarge, 100);
+    EXPECT_EQ(reader.state(a, kLarge, 100), ThumbnailIndex::kFresh);
+}
+
+TEST_F(UT_ThumbnailIndex, collectGarbage)
+{
+    ThumbnailIndex index(cacheDir.filePath("thumbnail.index"), 64);
+    const QByteArray &kept = md5Of("file:///tmp/kept.png");
+    const QByteArray &orphan = md5Of("file:///tmp/orphan.png");
+    const QByteArray &failed = md5Of("file:///tmp/failed.png");
+
+    QFile png(cacheDir.filePath(QString::fromLatin1(kept) + ".png"));
+    ASSERT_TRUE(png.open(QIODevice::WriteOnly));
+    png.close();
+
+    index.markFresh(kept, kLarge, 100);
+    index.markFresh(orphan, kLarge, 100);
+    index.markFailed(failed, kLarge, 100);
+
+    const QMap<ThumbnailSize, QString> dirs { { kLarge, cacheDir.path() } };
+    EXPECT_EQ(index.collectGarbage(dirs, 3600), 1);
+    EXPECT_EQ(index.state(kept, kLarge, 100), ThumbnailIndex::kFresh);
+    EXPECT_EQ(index.state(orphan, kLarge, 100), ThumbnailIndex::kNeedGenerate);
+    EXPECT_EQ(index.state(failed, kLarge, 100), ThumbnailIndex::kFailed);
+
+    // collected just now
+    EXPECT_EQ(index.collectGarbage(dirs, -1, 3600), 0);
+    EXPECT_EQ(index.collectGarbage(dirs, -1), 1);
+    EXPECT_EQ(index.state(failed, kLarge, 100), ThumbnailIndex::kNeedGenerate);
+}
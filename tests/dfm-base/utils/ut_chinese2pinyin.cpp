@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/chinese2pinyin.h"
+
+#include <gtest/gtest.h>
+
+TEST(UT_Chinese2Pinyin, testTones)
+{
+    // 中文 音乐 们
+    EXPECT_EQ(QString("zhong1wen2"), Pinyin::Chinese2Pinyin(QString::fromUtf8("中文")));
+    EXPECT_EQ(QString("yin1le4"), Pinyin::Chinese2Pinyin(QString::fromUtf8("音乐")));
+
+    // the keys drop the tones, the neutral tone too
+    QString full, initials;
+    EXPECT_TRUE(Pinyin::Chinese2PinyinKeys(QString::fromUtf8("音乐们"), &full, &initials));
+    EXPECT_EQ(QString("yinlemen"), full);
+    EXPECT_EQ(QString("ylm"), initials);
+}
+
+TEST(UT_Chinese2Pinyin, testPolyphones)
+{
+    // a polyphone always takes the reading in the dict, whatever the words around it:
+    // 行 xing2 (not hang2 in 银行), 重 zhong4, 长 chang2, 厦 sha4 (not xia4 in 厦门)
+    QString full, initials;
+    EXPECT_TRUE(Pinyin::Chinese2PinyinKeys(QString::fromUtf8("银行"), &full, &initials));
+    EXPECT_EQ(QString("yinxing"), full);
+    EXPECT_EQ(QString("yx"), initials);
+
+    full.clear();
+    initials.clear();
+    EXPECT_TRUE(Pinyin::Chinese2PinyinKeys(QString::fromUtf8("重长厦门"), &full, &initials));
+    EXPECT_EQ(QString("zhongchangshamen"), full);
+    EXPECT_EQ(QString("zcsm"), initials);
+
+    // the full pinyin and the initials agree on the reading
+    EXPECT_EQ(QString("xing2"), Pinyin::Chinese2Pinyin(QString::fromUtf8("行")));
+}
+
+TEST(UT_Chinese2Pinyin, testMixedName)
+{
+    // 2023年度报告-final.docx, 年 nian2 度 du4 报 bao4 告 gao4
+    QString full, initials;
+    EXPECT_TRUE(Pinyin::Chinese2PinyinKeys(QString::fromUtf8("2023年度报告-final.docx"), &full, &initials));
+    EXPECT_EQ(QString("2023niandubaogao-final.docx"), full);
+    EXPECT_EQ(QString("2023ndbg-final.docx"), initials);
+
+    // ascii only, nothing is converted
+    full.clear();
+    initials.clear();
+    EXPECT_FALSE(Pinyin::Chinese2PinyinKeys("Readme.md", &full, &initials));
+    EXPECT_EQ(QString("Readme.md"), full);
+    EXPECT_EQ(QString("Readme.md"), initials);
+
+    // the keys are appended, and either of them can be skipped
+    full = "a";
+    EXPECT_TRUE(Pinyin::Chinese2PinyinKeys(QString::fromUtf8("字"), &full, nullptr));
+    EXPECT_EQ(QString("azi"), full);
+}
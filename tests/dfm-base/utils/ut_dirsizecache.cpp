@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/dirsizecache.h"
+
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+class UT_DirSizeCache : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(dbDir.isValid());
+        ASSERT_TRUE(tree.isValid());
+        cache.reset(new DirSizeCache(dbDir.filePath("dirsize.db")));
+    }
+
+    void write(const QString &relativePath, int size)
+    {
+        const QString &path { tree.filePath(relativePath) };
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        QFile file(path);
+        file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        file.write(QByteArray(size, 'x'));
+    }
+
+    DirSizeCache::Statistics count(bool followLinks = true)
+    {
+        DirSizeCache::Statistics result;
+        EXPECT_TRUE(cache->statistics(tree.path(), &result, nullptr, followLinks));
+        return result;
+    }
+
+    QTemporaryDir dbDir;
+    QTemporaryDir tree;
+    QScopedPointer<DirSizeCache> cache;
+};
+
+TEST_F(UT_DirSizeCache, testCount)
+{
+    write("a/1", 10);
+    write("a/b/2", 20);
+    write("c/3", 30);
+
+    const auto &result = count();
+    EXPECT_EQ(60, result.totalSize);
+    EXPECT_EQ(3, result.filesCount);
+    EXPECT_EQ(4, result.directoryCount);   // the root, a, a/b, c
+
+    const auto &again = count();
+    EXPECT_EQ(60, again.totalSize);
+    EXPECT_EQ(3, again.filesCount);
+    EXPECT_EQ(4, again.directoryCount);
+}
+
+TEST_F(UT_DirSizeCache, testChangedDirectory)
+{
+    write("a/b/1", 10);
+    EXPECT_EQ(10, count().totalSize);
+
+    write("a/b/2", 20);
+    write("d/3", 30);
+    const auto &result = count();
+    EXPECT_EQ(60, result.totalSize);
+    EXPECT_EQ(3, result.filesCount);
+
+    QDir(tree.filePath("d")).removeRecursively();
+    EXPECT_EQ(30, count().totalSize);
+}
+
+TEST_F(UT_DirSizeCache, testMarkChanged)
+{
+    write("a/1", 10);
+    EXPECT_EQ(10, count().totalSize);
+
+    // rewriting a file keeps the mtime of its directory
+    write("a/1", 40);
+    cache->markChanged(QUrl::fromLocalFile(tree.filePath("a/1")));
+    EXPECT_EQ(40, count().totalSize);
+}
+
+TEST_F(UT_DirSizeCache, testCancel)
+{
+    write("a/1", 10);
+    write("b/2", 10);
+
+    int calls = 0;
+    DirSizeCache::Statistics result;
+    EXPECT_FALSE(cache->statistics(tree.path(), &result, [&calls](const DirSizeCache::Statistics &) {
+        return ++calls < 2;
+    }));
+    EXPECT_EQ(2, calls);
+
+    EXPECT_EQ(20, count().totalSize);
+}
+
+TEST_F(UT_DirSizeCache, testHardLinks)
+{
+    write("a/1", 10);
+    write("b/2", 20);
+    ASSERT_EQ(0, ::link(QFile::encodeName(tree.filePath("a/1")).constData(),
+                        QFile::encodeName(tree.filePath("b/1")).constData()));
+
+    // every name is a file, the size is counted once
+    const auto &result = count();
+    EXPECT_EQ(30, result.totalSize);
+    EXPECT_EQ(3, result.filesCount);
+
+    const auto &again = count();
+    EXPECT_EQ(30, again.totalSize);
+    EXPECT_EQ(3, again.filesCount);
+}
+
+TEST_F(UT_DirSizeCache, testSharedCounted)
+{
+    write("a/1", 10);
+    write("b/2", 20);
+    ASSERT_EQ(0, ::link(QFile::encodeName(tree.filePath("a/1")).constData(),
+                        QFile::encodeName(tree.filePath("b/1")).constData()));
+
+    // the trees counted in one job share the hard links
+    DirSizeCache::Counted counted;
+    DirSizeCache::Statistics first;
+    EXPECT_TRUE(cache->statistics(tree.filePath("a"), &first, nullptr, true, &counted));
+    DirSizeCache::Statistics second;
+    EXPECT_TRUE(cache->statistics(tree.filePath("b"), &second, nullptr, true, &counted));
+    EXPECT_EQ(10, first.totalSize);
+    EXPECT_EQ(20, second.totalSize);
+    EXPECT_EQ(2, second.filesCount);
+
+    // counted alone
+    DirSizeCache::Statistics alone;
+    EXPECT_TRUE(cache->statistics(tree.filePath("b"), &alone));
+    EXPECT_EQ(30, alone.totalSize);
+}
+
+TEST_F(UT_DirSizeCache, testLinkedDirs)
+{
+    QTemporaryDir outside;
+    ASSERT_TRUE(outside.isValid());
+    QFile file(outside.filePath("1"));
+    file.open(QIODevice::WriteOnly);
+    file.write(QByteArray(40, 'x'));
+    file.close();
+
+    write("a/2", 10);
+    ASSERT_TRUE(QFile::link(outside.path(), tree.filePath("outside")));
+    // a loop to the root, counted as a directory without walking into it
+    ASSERT_TRUE(QFile::link(tree.path(), tree.filePath("a/root")));
+
+    const auto &followed = count();
+    EXPECT_EQ(50, followed.totalSize);
+    EXPECT_EQ(2, followed.filesCount);
+    EXPECT_EQ(4, followed.directoryCount);   // the root, a, outside, a/root
+
+    const auto &unfollowed = count(false);
+    EXPECT_EQ(10, unfollowed.totalSize);
+    EXPECT_EQ(1, unfollowed.filesCount);
+    EXPECT_EQ(4, unfollowed.directoryCount);
+}
+
+TEST_F(UT_DirSizeCache, testRecordAge)
+{
+    write("a/1", 10);
+    EXPECT_EQ(10, count().totalSize);
+
+    // rewritten in place while nobody watched
+    write("a/1", 40);
+    EXPECT_EQ(10, count().totalSize);
+
+    cache->recordMaxAge = 0;
+    EXPECT_EQ(40, count().totalSize);
+}
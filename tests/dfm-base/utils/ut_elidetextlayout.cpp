@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/elidetextlayout.h"
+
+#include <QFont>
+#include <QImage>
+#include <QPainter>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+// the text is shaped only if it is not taken from the cache, and the options are
+// initialized then.
+class CountedLayout : public ElideTextLayout
+{
+public:
+    using ElideTextLayout::ElideTextLayout;
+    int shaped = 0;
+
+protected:
+    void initLayoutOption(QTextLayout *lay) override
+    {
+        ++shaped;
+        ElideTextLayout::initLayoutOption(lay);
+    }
+};
+
+class UT_ElideTextLayout : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ElideTextLayout::clearLayoutCache();
+    }
+
+    void TearDown() override
+    {
+        ElideTextLayout::clearLayoutCache();
+    }
+
+    // returns whether the layout is taken from the cache
+    bool lines(CountedLayout *layout, const QRectF &rect, Qt::TextElideMode mode, QStringList *ret, QPainter *painter = nullptr)
+    {
+        const int shaped = layout->shaped;
+        layout->layout(rect, mode, painter, Qt::NoBrush, ret);
+        return shaped == layout->shaped;
+    }
+};
+
+TEST_F(UT_ElideTextLayout, testCacheHit)
+{
+    CountedLayout layout("a file name long enough to be wrapped into lines");
+    const QRectF rect(0, 0, 80, 1000);
+
+    QStringList first;
+    const auto &firstRects = layout.layout(rect, Qt::ElideMiddle, nullptr, Qt::NoBrush, &first);
+    EXPECT_LT(1, first.size());
+
+    const int shaped = layout.shaped;
+    const quint64 hits = ElideTextLayout::layoutCacheHits();
+    const quint64 misses = ElideTextLayout::layoutCacheMisses();
+    QStringList second;
+    const auto &secondRects = layout.layout(rect.translated(10, 20), Qt::ElideMiddle, nullptr, Qt::NoBrush, &second);
+    EXPECT_EQ(shaped, layout.shaped);
+    EXPECT_EQ(hits + 1, ElideTextLayout::layoutCacheHits());
+    EXPECT_EQ(misses, ElideTextLayout::layoutCacheMisses());
+    EXPECT_EQ(first, second);
+    ASSERT_EQ(firstRects.size(), secondRects.size());
+    for (int i = 0; i < firstRects.size(); ++i)
+        EXPECT_EQ(firstRects.at(i).translated(10, 20), secondRects.at(i));
+
+    ElideTextLayout::clearLayoutCache();
+    QStringList third;
+    EXPECT_FALSE(lines(&layout, rect, Qt::ElideMiddle, &third));
+    EXPECT_EQ(misses + 1, ElideTextLayout::layoutCacheMisses());
+    EXPECT_EQ(first, third);
+}
+
+TEST_F(UT_ElideTextLayout, testKeyText)
+{
+    CountedLayout layout("first.txt");
+    const QRectF rect(0, 0, 200, 100);
+    QStringList ret;
+    EXPECT_FALSE(lines(&layout, rect, Qt::ElideMiddle, &ret));
+    EXPECT_EQ(QStringList { "first.txt" }, ret);
+
+    layout.setText("second.txt");
+    ret.clear();
+    EXPECT_FALSE(lines(&layout, rect, Qt::ElideMiddle, &ret));
+    EXPECT_EQ(QStringList { "second.txt" }, ret);
+
+    // the same text in another layout is taken from the cache
+    CountedLayout other("second.txt");
+    ret.clear();
+    EXPECT_TRUE(lines(&other, rect, Qt::ElideMiddle, &ret));
+    EXPECT_EQ(QStringList { "second.txt" }, ret);
+}
+
+TEST_F(UT_ElideTextLayout, testKeyWidth)
+{
+    CountedLayout layout("a file name long enough to be wrapped into lines");
+    QStringList wide;
+    EXPECT_FALSE(lines(&layout, QRectF(0, 0, 2000, 1000), Qt::ElideMiddle, &wide));
+    QStringList narrow;
+    EXPECT_FALSE(lines(&layout, QRectF(0, 0, 60, 1000), Qt::ElideMiddle, &narrow));
+    EXPECT_EQ(1, wide.size());
+    EXPECT_LT(1, narrow.size());
+}
+
+TEST_F(UT_ElideTextLayout, testKeyFont)
+{
+    CountedLayout layout("a file name long enough to be wrapped into lines");
+    const QRectF rect(0, 0, 120, 1000);
+    QFont font = layout.attribute<QFont>(ElideTextLayout::kFont);
+    font.setPixelSize(8);
+    layout.setAttribute(ElideTextLayout::kFont, font);
+    QStringList small;
+    EXPECT_FALSE(lines(&layout, rect, Qt::ElideMiddle, &small));
+
+    font.setPixelSize(40);
+    layout.setAttribute(ElideTextLayout::kFont, font);
+    QStringList large;
+    EXPECT_FALSE(lines(&layout, rect, Qt::ElideMiddle, &large));
+    EXPECT_LT(small.size(), large.size());
+}
+
+TEST_F(UT_ElideTextLayout, testKeyElideMode)
+{
+    // there is room for one line only, the rest is elided
+    CountedLayout layout("a file name long enough to be elided in one line");
+    const QRectF rect(0, 0, 80, layout.attribute<int>(ElideTextLayout::kLineHeight));
+
+    QStringList middle;
+    EXPECT_FALSE(lines(&layout, rect, Qt::ElideMiddle, &middle));
+    QStringList right;
+    EXPECT_FALSE(lines(&layout, rect, Qt::ElideRight, &right));
+    ASSERT_EQ(1, middle.size());
+    ASSERT_EQ(1, right.size());
+    EXPECT_NE(middle, right);
+    EXPECT_TRUE(right.first().endsWith(QChar(0x2026)));
+}
+
+TEST_F(UT_ElideTextLayout, testPaintHit)
+{
+    CountedLayout layout("painted.txt");
+    const QRectF rect(0, 0, 100, 40);
+
+    QImage missed(100, 40, QImage::Format_ARGB32_Premultiplied);
+    missed.fill(Qt::white);
+    {
+        QPainter pa(&missed);
+        EXPECT_FALSE(lines(&layout, rect, Qt::ElideMiddle, nullptr, &pa));
+    }
+
+    QImage hit(100, 40, QImage::Format_ARGB32_Premultiplied);
+    hit.fill(Qt::white);
+    {
+        QPainter pa(&hit);
+        EXPECT_TRUE(lines(&layout, rect, Qt::ElideMiddle, nullptr, &pa));
+    }
+
+    // both are drawn by the same text lines
+    EXPECT_EQ(missed, hit);
+}
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/journaledstore.h"
+
+#include <stubext.h>
+
+#include <QTemporaryDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+DFMBASE_USE_NAMESPACE
+
+class UT_JournaledStore : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(dir.isValid());
+        path = dir.filePath("test.layout");
+    }
+
+    QTemporaryDir dir;
+    QString path;
+};
+
+TEST_F(UT_JournaledStore, testReplay)
+{
+    {
+        JournaledStore store(path);
+        EXPECT_TRUE(store.isEmpty());
+        store.setValue("a/1", "one");
+        store.setValue("a/2", "two");
+        store.setValue("b/1", "three");
+        store.remove("a/2");
+    }
+
+    EXPECT_FALSE(QFile::exists(path));
+    EXPECT_TRUE(QFile::exists(path + ".journal"));
+
+    JournaledStore store(path);
+    EXPECT_EQ("one", store.value("a/1"));
+    EXPECT_FALSE(store.contains("a/2"));
+
+    const auto &values = store.values("a/");
+    ASSERT_EQ(1, values.size());
+    EXPECT_EQ("one", values.value("1"));
+}
+
+TEST_F(UT_JournaledStore, testCompact)
+{
+    {
+        JournaledStore store(path);
+        store.update({ { "a", "1" }, { "b", "2" } }, {});
+        EXPECT_TRUE(store.compact());
+        store.setValue("c", "3");
+    }
+
+    EXPECT_TRUE(QFile::exists(path));
+
+    JournaledStore store(path);
+    EXPECT_EQ("1", store.value("a"));
+    EXPECT_EQ("2", store.value("b"));
+    EXPECT_EQ("3", store.value("c"));
+}
+
+TEST_F(UT_JournaledStore, testTornJournal)
+{
+    {
+        JournaledStore store(path);
+        store.setValue("a", "1");
+        store.setValue("b", "2");
+    }
+
+    // cut the last record
+    QFile journal(path + ".journal");
+    const qint64 size = journal.size();
+    ASSERT_TRUE(journal.resize(size - 3));
+
+    {
+        JournaledStore store(path);
+        EXPECT_EQ("1", store.value("a"));
+        EXPECT_FALSE(store.contains("b"));
+        store.setValue("c", "3");
+    }
+
+    JournaledStore store(path);
+    EXPECT_EQ("1", store.value("a"));
+    EXPECT_EQ("3", store.value("c"));
+}
+
+TEST_F(UT_JournaledStore, testUnchangedNotJournaled)
+{
+    JournaledStore store(path);
+    store.setValue("a", "1");
+    const qint64 size = QFile(path + ".journal").size();
+
+    store.setValue("a", "1");
+    store.remove("none");
+    EXPECT_EQ(size, QFile(path + ".journal").size());
+}
+
+TEST_F(UT_JournaledStore, testFailedAppend)
+{
+    const QString &journalPath = path + ".journal";
+    JournaledStore store(path);
+    store.setValue("a", "1");
+    const qint64 size = QFile(journalPath).size();
+
+    // the record is torn on the disk, and the write is reported failed
+    {
+        stub_ext::StubExt stub;
+        stub.set_lamda(&QFileDevice::flush, [&journalPath] {
+            __DBG_STUB_INVOKE__
+            const int fd = ::open(QFile::encodeName(journalPath).constData(), O_WRONLY | O_APPEND);
+            if (fd >= 0) {
+                ::write(fd, "torn", 4);
+                ::close(fd);
+            }
+            return false;
+        });
+        store.setValue("b", "2");
+    }
+    EXPECT_EQ(size, QFile(journalPath).size());
+
+    store.setValue("c", "3");
+
+    JournaledStore loaded(path);
+    EXPECT_EQ("1", loaded.value("a"));
+    EXPECT_FALSE(loaded.contains("b"));
+    EXPECT_EQ("3", loaded.value("c"));
+}
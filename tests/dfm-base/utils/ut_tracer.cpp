@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/tracer.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+DFMBASE_USE_NAMESPACE
+
+class UT_Tracer : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Tracer::clear();
+    }
+
+    void TearDown() override
+    {
+        Tracer::setEnabled(false);
+        Tracer::clear();
+    }
+
+    static QJsonArray events()
+    {
+        const QJsonDocument &doc = QJsonDocument::fromJson(Tracer::toChromeTrace());
+        return doc.object().value("traceEvents").toArray();
+    }
+};
+
+TEST_F(UT_Tracer, testDisabled)
+{
+    {
+        dfmTraceSpan("test", "disabled span");
+        dfmTraceCounter("test", "disabled counter", 1);
+    }
+
+    EXPECT_TRUE(events().isEmpty());
+}
+
+TEST_F(UT_Tracer, testSpanAndCounter)
+{
+    Tracer::setEnabled(true);
+    {
+        dfmTraceSpan("test", "span");
+        dfmTraceCounter("test", "counter", 42);
+    }
+
+    const QJsonArray &array = events();
+    ASSERT_EQ(2, array.size());
+
+    const QJsonObject &counter = array.at(0).toObject();
+    EXPECT_EQ("counter", counter.value("name").toString());
+    EXPECT_EQ("C", counter.value("ph").toString());
+    EXPECT_EQ(42, counter.value("args").toObject().value("value").toInt());
+
+    const QJsonObject &span = array.at(1).toObject();
+    EXPECT_EQ("span", span.value("name").toString());
+    EXPECT_EQ("test", span.value("cat").toString());
+    EXPECT_EQ("X", span.value("ph").toString());
+    EXPECT_GE(span.value("dur").toDouble(), 0.0);
+}
+
+TEST_F(UT_Tracer, testThreads)
+{
+    Tracer::setEnabled(true);
+    std::thread worker([]() {
+        dfmTraceSpan("test", "worker");
+    });
+    worker.join();
+    {
+        dfmTraceSpan("test", "main");
+    }
+
+    const QJsonArray &array = events();
+    ASSERT_EQ(2, array.size());
+    EXPECT_NE(array.at(0).toObject().value("tid").toInt(), array.at(1).toObject().value("tid").toInt());
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "dfm-framework/log/private/logringbuffer_p.h"
+
+#include <QSet>
+
+#include <thread>
+#include <vector>
+
+DPF_USE_NAMESPACE
+
+TEST(UT_LogRingBuffer, test_fifo)
+{
+    LogRingBuffer ring(4);
+    EXPECT_EQ(4, ring.capacity());
+
+    ring.push(QString("a"));
+    ring.push(QString("b"));
+    EXPECT_EQ(2, ring.size());
+
+    QString record;
+    EXPECT_TRUE(ring.pop(&record));
+    EXPECT_EQ("a", record);
+    EXPECT_TRUE(ring.pop(&record));
+    EXPECT_EQ("b", record);
+    EXPECT_FALSE(ring.pop(&record));
+    EXPECT_EQ(0u, ring.dropped());
+}
+
+TEST(UT_LogRingBuffer, test_drop_oldest)
+{
+    LogRingBuffer ring(4);
+    for (int i = 0; i < 6; ++i)
+        ring.push(QString::number(i));
+
+    EXPECT_EQ(2u, ring.dropped());
+    EXPECT_EQ(4, ring.size());
+
+    QString record;
+    EXPECT_TRUE(ring.pop(&record));
+    EXPECT_EQ("2", record);
+}
+
+TEST(UT_LogRingBuffer, test_multi_producers)
+{
+    LogRingBuffer ring(1 << 12);
+    const int kThreads = 4;
+    const int kRecords = 1000;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&ring, t]() {
+            for (int i = 0; i < kRecords; ++i)
+                ring.push(QString("%1-%2").arg(t).arg(i));
+        });
+    }
+    for (auto &producer : producers)
+        producer.join();
+
+    QSet<QString> records;
+    QString record;
+    while (ring.pop(&record))
+        records.insert(record);
+
+    EXPECT_EQ(0u, ring.dropped());
+    EXPECT_EQ(kThreads * kRecords, records.size());
+}
@@ -18,6 +18,8 @@
 #include <gtest/gtest.h>
 #include <dfm-io/denumerator.h>
 
+#include <thread>
+
 DPFILEOPERATIONS_USE_NAMESPACE
 DFMBASE_USE_NAMESPACE
 class UT_FileOperateBaseWorker : public testing::Test
@@ -776,46 +778,31 @@ TEST_F(UT_FileOperateBaseWorker, testSetAllDirPermisson)
 TEST_F(UT_FileOperateBaseWorker, testGetWriteDataSize)
 {
     FileOperateBaseWorker worker;
-    stub_ext::StubExt stub;
     worker.workData.reset(new WorkerData);
-    worker.countWriteType = AbstractWorker::CountWriteSizeType::kTidType;
-    EXPECT_TRUE(0 == worker.getWriteDataSize());
-
-    worker.countWriteType = AbstractWorker::CountWriteSizeType::kCustomizeType;
     EXPECT_TRUE(0 == worker.getWriteDataSize());
 
-    worker.countWriteType = AbstractWorker::CountWriteSizeType::kWriteBlockType;
-    stub.set_lamda(&FileOperateBaseWorker::getSectorsWritten,[]{ __DBG_STUB_INVOKE__ return 10;});
-    EXPECT_TRUE(10 * 512 == worker.getWriteDataSize());
-}
-
-TEST_F(UT_FileOperateBaseWorker, testGetTidWriteSize)
-{
-    FileOperateBaseWorker worker;
-    stub_ext::StubExt stub;
-    typedef bool (*openfile)(QFile *,QFile::OpenMode);
-    stub.set_lamda((openfile)((bool (QFile::*)(QFile::OpenMode))(&QFile::open)),[](){return true;});
-    stub.set_lamda(VADDR(QFile, close), []{ __DBG_STUB_INVOKE__ });
-    stub.set_lamda(VADDR(QFile, readAll), []{ __DBG_STUB_INVOKE__ return QByteArray("write_bytes: 1000"); });
-    EXPECT_TRUE(1000 == worker.getTidWriteSize());
+    auto data = worker.workData;
+    std::thread copyThread([data]{
+        data->currentWriteSize += 100;
+    });
+    copyThread.join();
+    worker.workData->currentWriteSize += 50;
+    worker.workData->currentWriteSize -= 10;
+    worker.workData->skipWriteSize += 5;
+    worker.workData->zeroOrlinkOrDirWriteSize += 1;
+    EXPECT_TRUE(146 == worker.getWriteDataSize());
 
-    stub.set_lamda(VADDR(QFile, readAll), []{ __DBG_STUB_INVOKE__ return QByteArray(); });
-    EXPECT_TRUE(0 == worker.getTidWriteSize());
+    // the data is all written while it is synced
+    worker.sourceFilesTotalSize = 200;
+    worker.isSyncingFiles = true;
+    EXPECT_TRUE(200 == worker.getWriteDataSize());
 }
 
-TEST_F(UT_FileOperateBaseWorker, testGetSectorsWritten)
+TEST_F(UT_FileOperateBaseWorker, testDetermineCountProcessType)
 {
     FileOperateBaseWorker worker;
     stub_ext::StubExt stub;
 
-    EXPECT_TRUE(0 == worker.getSectorsWritten());
-
-    typedef bool (*openfile)(QFile *,QFile::OpenMode);
-    stub.set_lamda((openfile)((bool (QFile::*)(QFile::OpenMode))(&QFile::open)),[](){return true;});
-    stub.set_lamda(VADDR(QFile, close), []{ __DBG_STUB_INVOKE__ });
-    stub.set_lamda(VADDR(QFile, readAll), []{ __DBG_STUB_INVOKE__ return QByteArray("sdf dd dd dd ff oo 99 00"); });
-    EXPECT_TRUE(99 == worker.getSectorsWritten());
-
     auto url = QUrl::fromLocalFile(QDir::currentPath());
     worker.targetUrl = url;
     worker.determineCountProcessType();
@@ -829,7 +816,6 @@ TEST_F(UT_FileOperateBaseWorker, testSyncFilesToDevice)
     FileOperateBaseWorker worker;
     stub_ext::StubExt stub;
 
-    worker.countWriteType = AbstractWorker::CountWriteSizeType::kCustomizeType;
     worker.syncFilesToDevice();
 
     int index = 0;
@@ -841,7 +827,6 @@ TEST_F(UT_FileOperateBaseWorker, testSyncFilesToDevice)
         return true;
     });
     worker.sourceFilesTotalSize = 1;
-    worker.countWriteType = AbstractWorker::CountWriteSizeType::kWriteBlockType;
     stub.set_lamda(&FileOperateBaseWorker::getWriteDataSize,[]{ __DBG_STUB_INVOKE__ return 0;});
     worker.syncFilesToDevice();
 }
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "plugins/common/dfmplugin-burn/utils/burncheckstrategy.h"
+
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+using namespace dfmplugin_burn;
+
+class UT_BurnCheckStrategy : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(stage.isValid());
+    }
+
+    void touch(const QString &relativePath)
+    {
+        const QString &path { stage.filePath(relativePath) };
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+    }
+
+    QTemporaryDir stage;
+};
+
+TEST_F(UT_BurnCheckStrategy, ValidTree)
+{
+    for (int i = 0; i < 50; ++i)
+        touch(QString("dir%1/sub/file%2").arg(i % 5).arg(i));
+
+    JolietCheckStrategy strategy(stage.path());
+    EXPECT_TRUE(strategy.check());
+    EXPECT_TRUE(strategy.lastError().isEmpty());
+    EXPECT_TRUE(strategy.lastInvalidName().isEmpty());
+}
+
+TEST_F(UT_BurnCheckStrategy, FileNameTooLong)
+{
+    touch("dir/sub/file");
+    const QString &longName { QString(40, 'a') };
+    touch("dir/sub/" + longName);
+
+    ISO9660CheckStrategy iso(stage.path());
+    EXPECT_FALSE(iso.check());
+    EXPECT_EQ(longName, iso.lastInvalidName());
+    EXPECT_TRUE(iso.lastError().startsWith("Invalid FileNameCharacters Length"));
+
+    JolietCheckStrategy joliet(stage.path());
+    EXPECT_TRUE(joliet.check());
+}
+
+TEST_F(UT_BurnCheckStrategy, PathTooDeep)
+{
+    touch("1/2/3/4/5/6/7/8/9");
+
+    RockRidgeCheckStrategy strategy(stage.path());
+    EXPECT_FALSE(strategy.check());
+    EXPECT_EQ(QString("9"), strategy.lastInvalidName());
+}
+
+TEST_F(UT_BurnCheckStrategy, SkipHiddenAndLinks)
+{
+    touch(".hidden/" + QString(40, 'a'));
+    QFile::link("/", stage.filePath(QString(40, 'b')));
+
+    ISO9660CheckStrategy strategy(stage.path());
+    EXPECT_TRUE(strategy.check());
+}
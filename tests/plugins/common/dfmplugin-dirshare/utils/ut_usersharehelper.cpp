@@ -248,6 +248,48 @@ TEST_F(UT_UserShareHelper, ReadShareInfos)
     EXPECT_NO_FATAL_FAILURE(UserShareHelperInstance->readShareInfos(true));
 }
 
+TEST_F(UT_UserShareHelper, ReadChangedShareFiles)
+{
+    auto helper = UserShareHelperInstance;
+    const QString &shareFile { "/var/lib/samba/usershares/ut_share" };
+    ShareInfo info { { ShareInfoKeys::kName, "ut_share" }, { ShareInfoKeys::kPath, "/tmp" } };
+    stub.set_lamda(&UserShareHelper::readShareFile, [&info] { __DBG_STUB_INVOKE__ return info; });
+    stub.set_lamda(&ShareWatcherManager::add, [] { __DBG_STUB_INVOKE__ return nullptr; });
+    stub.set_lamda(&ShareWatcherManager::remove, [] { __DBG_STUB_INVOKE__ });
+    QStringList added, removed;
+    stub.set_lamda(&UserShareHelper::emitShareAdded, [&added](UserShareHelper *, const QString &path) { __DBG_STUB_INVOKE__ added << path; });
+    stub.set_lamda(&UserShareHelper::emitShareRemoved, [&removed](UserShareHelper *, const QString &path) { __DBG_STUB_INVOKE__ removed << path; });
+
+    helper->changedShareFiles.insert(shareFile);
+    helper->readChangedShareFiles(false);
+    EXPECT_TRUE(helper->isShared("/tmp"));
+    EXPECT_EQ(QStringList { "/tmp" }, added);
+    EXPECT_EQ(QString("/tmp"), helper->sharedAncestor("/tmp/a/b"));
+    EXPECT_TRUE(helper->changedShareFiles.isEmpty());
+
+    // the file is unchanged
+    helper->changedShareFiles.insert(shareFile);
+    helper->readChangedShareFiles(false);
+    EXPECT_EQ(1, added.count());
+
+    info.clear();
+    helper->changedShareFiles.insert(shareFile);
+    helper->readChangedShareFiles(false);
+    EXPECT_FALSE(helper->isShared("/tmp"));
+    EXPECT_EQ(QStringList { "/tmp" }, removed);
+    EXPECT_TRUE(helper->shareInfoByShareName("ut_share").isEmpty());
+}
+
+TEST_F(UT_UserShareHelper, SharedAncestor)
+{
+    UserShareHelperInstance->sharePathToShareName.insert("/home/test", QStringList { "hello" });
+    EXPECT_EQ(QString("/home/test"), UserShareHelperInstance->sharedAncestor("/home/test"));
+    EXPECT_EQ(QString("/home/test"), UserShareHelperInstance->sharedAncestor("/home/test/a/b/"));
+    EXPECT_TRUE(UserShareHelperInstance->sharedAncestor("/home/tester").isEmpty());
+    EXPECT_TRUE(UserShareHelperInstance->sharedAncestor("/home").isEmpty());
+    UserShareHelperInstance->sharePathToShareName.clear();
+}
+
 TEST_F(UT_UserShareHelper, OnShareChanged)
 {
     EXPECT_NO_FATAL_FAILURE(UserShareHelperInstance->onShareChanged("/"));
@@ -98,6 +98,74 @@ TEST_F(FileTagCacheTest, untaggeFiles)
     EXPECT_TRUE(!ins->getTagsByFiles({ QString("tag") }).contains(QString("tag1")));
 }
 
+TEST_F(FileTagCacheTest, renameTagOfFiles)
+{
+    QVariantMap map;
+    map["/tmp/dir/file"] = QStringList { "rename_a", "rename_b" };
+    ins->taggeFiles(map);
+
+    ins->changeTagName({ { "rename_a", QString("rename_c") } });
+    const auto &tags = ins->getTagsByFiles({ QString("/tmp/dir/file") });
+    EXPECT_TRUE(tags.contains("rename_c"));
+    EXPECT_TRUE(tags.contains("rename_b"));
+    EXPECT_FALSE(tags.contains("rename_a"));
+
+    ins->deleteTags({ "rename_c", "rename_b" });
+    EXPECT_TRUE(ins->getTagsByFiles({ QString("/tmp/dir/file") }).isEmpty());
+}
+
+TEST_F(FileTagCacheTest, tagsIntersection)
+{
+    QVariantMap map;
+    map["/tmp/dir/file1"] = QStringList { "inter_a", "inter_b" };
+    map["/tmp/dir/file2"] = QStringList { "inter_b" };
+    ins->taggeFiles(map);
+
+    EXPECT_EQ(ins->getTagsByFiles({ QString("/tmp/dir/file1"), QString("/tmp/dir/file2") }), QStringList { "inter_b" });
+    ins->untaggeFiles(map);
+    EXPECT_TRUE(ins->getTagsByFiles({ QString("/tmp/dir/file1") }).isEmpty());
+}
+
+TEST_F(FileTagCacheTest, loadDirs)
+{
+    stub.set_lamda(&TagProxyHandle::isValid, []() { __DBG_STUB_INVOKE__ return true; });
+    QStringList queried;
+    bool failed = false;
+    stub.set_lamda(&TagProxyHandle::getFilesWithTagsInDirs, [&queried, &failed](TagProxyHandle *, const QStringList &dirs, bool *ok) {
+        __DBG_STUB_INVOKE__
+        queried = dirs;
+        if (ok)
+            *ok = !failed;
+        if (failed)
+            return QVariantHash();
+        QVariantHash hash;
+        hash["/tmp/load/file"] = QStringList { "load_a" };
+        return hash;
+    });
+
+    EXPECT_EQ(ins->unloadedDirs({ QString("/tmp/load/file") }), QStringList { "/tmp/load" });
+    EXPECT_EQ(ins->loadDirs({ QString("/tmp/load") }), QStringList { "/tmp/load/file" });
+    EXPECT_EQ(queried, QStringList { "/tmp/load" });
+    EXPECT_TRUE(ins->unloadedDirs({ QString("/tmp/load/file") }).isEmpty());
+    EXPECT_EQ(ins->getTagsByFiles({ QString("/tmp/load/file") }), QStringList { "load_a" });
+
+    // loaded only once
+    queried.clear();
+    EXPECT_TRUE(ins->loadDirs({ QString("/tmp/load") }).isEmpty());
+    EXPECT_TRUE(queried.isEmpty());
+
+    // a failed query is not taken as a dir without tagged files
+    failed = true;
+    EXPECT_TRUE(ins->loadDirs({ QString("/tmp/failed") }).isEmpty());
+    EXPECT_EQ(ins->unloadedDirs({ QString("/tmp/failed/file") }), QStringList { "/tmp/failed" });
+
+    failed = false;
+    queried.clear();
+    ins->loadDirs({ QString("/tmp/failed") });
+    EXPECT_EQ(queried, QStringList { "/tmp/failed" });
+    EXPECT_TRUE(ins->unloadedDirs({ QString("/tmp/failed/file") }).isEmpty());
+}
+
 TEST_F(FileTagCacheTest, onTagAdded)
 {
     bool isRun = false;
@@ -111,8 +179,7 @@ TEST_F(FileTagCacheTest, onTagAdded)
 TEST_F(FileTagCacheTest, onTagsNameChanged)
 {
     bool isRun = false;
-    stub.set_lamda(&FileTagCache::changeTagName, []() {});
-    stub.set_lamda(&FileTagCache::changeFilesTagName, [&isRun]() {
+    stub.set_lamda(&FileTagCache::changeTagName, [&isRun]() {
         isRun = true;
     });
     QVariantMap map;
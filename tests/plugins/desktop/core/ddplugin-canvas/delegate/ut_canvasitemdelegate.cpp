@@ -81,6 +81,61 @@ TEST(CanvasItemDelegate, paint)
     EXPECT_TRUE(label);
 }
 
+TEST(CanvasItemDelegate, paintFromCache)
+{
+    CanvasProxyModel model;
+    CanvasView view;
+    view.setModel(&model);
+    CanvasItemDelegate obj(&view);
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(VADDR(CanvasItemDelegate,initStyleOption), [](){
+    });
+    stub.set_lamda(&CanvasItemDelegate::isTransparent, [](){
+        return false;
+    });
+    stub.set_lamda(&CanvasItemDelegatePrivate::isCacheable, [](){
+        return true;
+    });
+
+    int icon = 0;
+    stub.set_lamda(&CanvasItemDelegate::paintIcon, [&icon](){
+        icon++;
+        return QRect();
+    });
+    stub.set_lamda(&CanvasItemDelegate::paintEmblems, [](){
+        return QRectF();
+    });
+    stub.set_lamda(&CanvasItemDelegate::paintLabel, [](){
+    });
+    stub.set_lamda(&CanvasView::isPersistentEditorOpen, [](){
+        return false;
+    });
+
+    QPixmap pix(400, 400);
+    QPainter pa(&pix);
+    QStyleOptionViewItem indexOption;
+    indexOption.rect = QRect(50, 50, 200, 200);
+    obj.paint(&pa, indexOption, QModelIndex());
+    obj.paint(&pa, indexOption, QModelIndex());
+    EXPECT_EQ(icon, 1);
+    EXPECT_EQ(obj.d->itemPixmaps.size(), 1);
+    // the cost is the bytes of the pixmap with the shadow margin.
+    EXPECT_EQ(obj.d->itemPixmaps.totalCost(), 208 * 208 * 4);
+    EXPECT_EQ(obj.d->itemPixmaps.maxCost(), CanvasItemDelegatePrivate::kPixmapCacheCost);
+
+    // repaint it if data changed.
+    emit model.dataChanged(QModelIndex(), QModelIndex());
+    EXPECT_TRUE(obj.d->itemPixmaps.isEmpty());
+    obj.paint(&pa, indexOption, QModelIndex());
+    EXPECT_EQ(icon, 2);
+
+    // repaint it if size changed.
+    indexOption.rect = QRect(50, 50, 100, 100);
+    obj.paint(&pa, indexOption, QModelIndex());
+    EXPECT_EQ(icon, 3);
+}
+
 TEST(CanvasItemDelegate, updateItemSizeHint)
 {
     CanvasView view;
@@ -261,3 +261,63 @@ TEST(AppendOper, tryAppendAfter)
     EXPECT_TRUE(ao.overload.contains(QString("5")));
     EXPECT_EQ(ao.overload.size(), 1);
 }
+
+TEST(GridOccupancy, nextVoid)
+{
+    GridOccupancy occ(QSize(10, 20));
+    EXPECT_EQ(occ.cells(), 200);
+    EXPECT_EQ(occ.cursor, 0);
+
+    for (int i = 0; i < 130; ++i)
+        occ.setUsed(i, true);
+    EXPECT_EQ(occ.used, 130);
+    EXPECT_EQ(occ.cursor, 130);
+    EXPECT_EQ(occ.point(occ.cursor), QPoint(6, 10));
+
+    occ.setUsed(70, false);
+    EXPECT_EQ(occ.cursor, 70);
+    EXPECT_EQ(occ.nextVoid(71), 130);
+
+    for (int i = 0; i < 200; ++i)
+        occ.setUsed(i, true);
+    EXPECT_EQ(occ.cursor, 200);
+    EXPECT_EQ(occ.nextVoid(0), 200);
+}
+
+TEST_F(TestGridCore, occupancy)
+{
+    EXPECT_EQ(core.occupancy(1).used, 3);
+    EXPECT_FALSE(core.isFull(1));
+
+    core.insert(1, QPoint(0, 0), QString("0,0"));
+    EXPECT_EQ(core.occupancy(1).used, 4);
+    EXPECT_EQ(core.occupancy(1).cursor, 2);
+
+    core.remove(1, QString("0,1"));
+    EXPECT_EQ(core.occupancy(1).used, 3);
+    EXPECT_EQ(core.occupancy(1).cursor, 1);
+
+    // resized surface
+    core.surfaces[1] = QSize(1, 2);
+    EXPECT_EQ(core.occupancy(1).used, 1);
+    EXPECT_EQ(core.occupancy(1).cursor, 1);
+    EXPECT_EQ(core.voidPos(1), QList<QPoint>{QPoint(0, 1)});
+}
+
+TEST(AppendOper, append)
+{
+    GridCore core;
+    core.surfaces.insert(1, QSize(2, 2));
+    core.surfaces.insert(2, QSize(1, 1));
+    core.insert(1, QPoint(0, 1), QString("0"));
+
+    AppendOper ao(&core);
+    ao.append({"1", "2", "3", "4", "5"});
+    EXPECT_EQ(ao.posItem[1].value(QPoint(0, 0)), QString("1"));
+    EXPECT_EQ(ao.posItem[1].value(QPoint(1, 0)), QString("2"));
+    EXPECT_EQ(ao.posItem[1].value(QPoint(1, 1)), QString("3"));
+    EXPECT_EQ(ao.posItem[2].value(QPoint(0, 0)), QString("4"));
+    EXPECT_EQ(ao.overload, QStringList{"5"});
+    EXPECT_TRUE(ao.isFull(1));
+    EXPECT_TRUE(ao.isFull(2));
+}
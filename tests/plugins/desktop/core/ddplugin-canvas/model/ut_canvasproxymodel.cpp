@@ -773,6 +773,52 @@ TEST(CanvasProxyModelPrivate, sourceRowsAboutToBeRemoved)
     }
 }
 
+TEST(CanvasProxyModelPrivate, removeRowsInBatch)
+{
+    CanvasProxyModel model;
+    FileInfoModel fm;
+    model.d->srcModel = &fm;
+
+    QList<QUrl> urls;
+    for (int i = 0; i < 6; ++i) {
+        auto url = QUrl::fromLocalFile(QString("/home/test%0").arg(i));
+        urls.append(url);
+        model.d->fileList.append(url);
+        model.d->fileMap.insert(url, {});
+    }
+
+    // the rows 1, 2 and 4 of canvas are at the top of the source.
+    for (int i : { 1, 2, 4 }) {
+        fm.d->fileList.append(urls.at(i));
+        fm.d->fileMap.insert(urls.at(i), {});
+    }
+
+    EXPECT_EQ(model.d->rowOf(urls.at(4)), 4);
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(&CanvasProxyModelPrivate::removeFilter, [](CanvasProxyModelPrivate *, const QUrl &) {
+        return false;
+    });
+
+    QList<QPair<int, int>> ranges;
+    QObject::connect(&model, &CanvasProxyModel::rowsAboutToBeRemoved, &model, [&ranges](const QModelIndex &, int first, int last) {
+        ranges.append(qMakePair(first, last));
+    });
+
+    model.d->sourceRowsAboutToBeRemoved(QModelIndex(), 0, 2);
+
+    ASSERT_EQ(ranges.size(), 2);
+    EXPECT_EQ(ranges.at(0), qMakePair(4, 4));
+    EXPECT_EQ(ranges.at(1), qMakePair(1, 2));
+
+    QList<QUrl> expected { urls.at(0), urls.at(3), urls.at(5) };
+    EXPECT_EQ(model.d->fileList, expected);
+    EXPECT_EQ(model.d->rowOf(urls.at(5)), 2);
+    EXPECT_EQ(model.d->rowOf(urls.at(3)), 1);
+    EXPECT_EQ(model.d->rowOf(urls.at(4)), -1);
+    EXPECT_EQ(model.index(urls.at(5)).row(), 2);
+}
+
 TEST(CanvasProxyModelPrivate, sourceDataRenamed)
 {
     CanvasProxyModel model;
@@ -44,6 +44,7 @@ protected:
     virtual void SetUp() override {
         organize = new OrganizerConfig;
         organize->d->settings->clear();
+        organize->d->items->clear();
     }
     virtual void TearDown() override {
         delete organize->d->settings;
@@ -102,11 +103,12 @@ TEST_F(UT_OrganizerConfig, updateCollectionBase)
     organize->d->settings->beginGroup("temp_key");
     EXPECT_EQ(organize->d->settings->value(kKeyName).toString(),"temp_name");
     EXPECT_EQ(organize->d->settings->value(kKeyKey).toString(),"temp_key");
-    organize->d->settings->beginGroup(kGroupItems);
-    EXPECT_EQ(organize->d->settings->value(QString::number(0)),"temp_url");
+    EXPECT_FALSE(organize->d->settings->childGroups().contains(kGroupItems));
     organize->d->settings->endGroup();
     organize->d->settings->endGroup();
     organize->d->settings->endGroup();
+
+    EXPECT_EQ(organize->collectionBase(true, "temp_key")->items, base->items);
 }
 
 TEST_F(UT_OrganizerConfig, writeCollectionBase)
@@ -124,12 +126,36 @@ TEST_F(UT_OrganizerConfig, writeCollectionBase)
     organize->d->settings->beginGroup("temp_key");
     EXPECT_EQ(organize->d->settings->value(kKeyName),"temp_name");
     EXPECT_EQ(organize->d->settings->value(kKeyKey),"temp_key");
-    organize->d->settings->beginGroup(kGroupItems);
-    EXPECT_EQ(organize->d->settings->value(QString::number(0)),"temp_url");
-    organize->d->settings->endGroup();
+    EXPECT_FALSE(organize->d->settings->childGroups().contains(kGroupItems));
     organize->d->settings->endGroup();
     organize->d->settings->endGroup();
     organize->d->settings->endGroup();
+
+    EXPECT_EQ(organize->collectionBase(true, "temp_key")->items, base->items);
+}
+
+TEST_F(UT_OrganizerConfig, migrateCollectionItems)
+{
+    organize->d->settings->setValue("Collection_Normalized/CollectionBase/temp_key/Name", "temp_name");
+    organize->d->settings->setValue("Collection_Normalized/CollectionBase/temp_key/Key", "temp_key");
+    organize->d->settings->setValue("Collection_Normalized/CollectionBase/temp_key/Items/0", "file:///tmp/a");
+    organize->d->settings->setValue("Collection_Normalized/CollectionBase/old_key/Name", "old_name");
+    organize->d->settings->setValue("Collection_Normalized/CollectionBase/old_key/Key", "old_key");
+
+    CollectionBaseDataPtr base = organize->collectionBase(false, "temp_key");
+    ASSERT_TRUE(base);
+    EXPECT_EQ(base->items, QList<QUrl> { QUrl("file:///tmp/a") });
+
+    base->items.append(QUrl("file:///tmp/b"));
+    organize->writeCollectionBase(false, { base });
+
+    EXPECT_FALSE(organize->d->settings->contains("Collection_Normalized/CollectionBase/temp_key/Items/0"));
+    EXPECT_FALSE(organize->d->settings->contains("Collection_Normalized/CollectionBase/old_key/Name"));
+    EXPECT_TRUE(organize->d->items->contains("items/normalized/temp_key"));
+
+    QList<QUrl> expected { QUrl("file:///tmp/a"), QUrl("file:///tmp/b") };
+    EXPECT_EQ(organize->collectionBase(false, "temp_key")->items, expected);
+    EXPECT_EQ(organize->collectionBase(false).size(), 1);
 }
 
 TEST_F(UT_OrganizerConfig, collectionStyle)
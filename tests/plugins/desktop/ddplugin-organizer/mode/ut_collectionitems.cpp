@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mode/collectionitems.h"
+
+#include <gtest/gtest.h>
+
+using namespace ddplugin_organizer;
+
+namespace {
+QList<QUrl> urls(const QStringList &names)
+{
+    QList<QUrl> ret;
+    for (const QString &name : names)
+        ret.append(QUrl::fromLocalFile("/tmp/" + name));
+    return ret;
+}
+
+QUrl url(const QString &name)
+{
+    return QUrl::fromLocalFile("/tmp/" + name);
+}
+}
+
+TEST(CollectionItems, append)
+{
+    CollectionItems items;
+    items.append(url("a"));
+    items << url("b") << url("a");
+
+    EXPECT_EQ(items, urls({ "a", "b" }));
+    EXPECT_TRUE(items.contains(url("b")));
+    EXPECT_FALSE(items.contains(url("c")));
+    EXPECT_EQ(items.indexOf(url("b")), 1);
+    EXPECT_EQ(items.indexOf(url("c")), -1);
+}
+
+TEST(CollectionItems, insert_remove)
+{
+    CollectionItems items = urls({ "a", "b", "c" });
+    items.prepend(url("d"));
+    EXPECT_EQ(items, urls({ "d", "a", "b", "c" }));
+    EXPECT_EQ(items.indexOf(url("c")), 3);
+
+    EXPECT_TRUE(items.removeOne(url("a")));
+    EXPECT_FALSE(items.removeOne(url("a")));
+    EXPECT_EQ(items.indexOf(url("c")), 2);
+    EXPECT_EQ(items.indexOf(url("d")), 0);
+
+    items.insert(1, url("e"));
+    EXPECT_EQ(items, urls({ "d", "e", "b", "c" }));
+    EXPECT_EQ(items.indexOf(url("b")), 2);
+
+    items.replace(2, url("f"));
+    EXPECT_EQ(items, urls({ "d", "e", "f", "c" }));
+    EXPECT_FALSE(items.contains(url("b")));
+    EXPECT_EQ(items.indexOf(url("f")), 2);
+}
+
+TEST(CollectionItems, batch)
+{
+    CollectionItems items = urls({ "a", "b", "c", "d", "e" });
+
+    EXPECT_EQ(items.remove(urls({ "b", "x", "d" })), 2);
+    EXPECT_EQ(items, urls({ "a", "c", "e" }));
+    EXPECT_EQ(items.indexOf(url("e")), 2);
+
+    items.insert(1, urls({ "f", "a", "g" }));
+    EXPECT_EQ(items, urls({ "a", "f", "g", "c", "e" }));
+    EXPECT_EQ(items.indexOf(url("g")), 2);
+    EXPECT_EQ(items.indexOf(url("e")), 4);
+}
+
+TEST(CollectionItems, move)
+{
+    CollectionItems items = urls({ "a", "b", "c", "d", "e" });
+
+    // the same as removing them one by one and inserting before the origin 4th item.
+    items.move(urls({ "a", "e" }), 3);
+    EXPECT_EQ(items, urls({ "b", "c", "a", "e", "d" }));
+    EXPECT_EQ(items.indexOf(url("d")), 4);
+    EXPECT_EQ(items.indexOf(url("a")), 2);
+
+    items.move(urls({ "d" }), 0);
+    EXPECT_EQ(items, urls({ "d", "b", "c", "a", "e" }));
+    EXPECT_EQ(items.indexOf(url("e")), 4);
+}
@@ -76,3 +76,33 @@ TEST_F(TypeClassifierTest, classes_single)
         index++;
     }
 }
+
+TEST_F(TypeClassifierTest, classifyAll)
+{
+    TypeClassifier obj;
+    stub.set_lamda(VADDR(TypeClassifier, classify), [](TypeClassifier *, const QUrl &url) {
+        return url.fileName();
+    });
+
+    QList<QUrl> urls;
+    for (int i = 0; i < 200; ++i)
+        urls.append(QUrl::fromLocalFile(QString("/tmp/%0").arg(i)));
+
+    auto types = obj.classifyAll(urls);
+    ASSERT_EQ(types.size(), urls.size());
+    for (int i = 0; i < urls.size(); ++i)
+        EXPECT_EQ(types.at(i), QString::number(i));
+
+    types = obj.classifyAll(urls.mid(0, 2));
+    EXPECT_EQ(types, QStringList({ "0", "1" }));
+}
+
+TEST_F(TypeClassifierTest, forget)
+{
+    TypeClassifier obj;
+    QUrl url = QUrl::fromLocalFile("/tmp/test.txt");
+    obj.d->classified.insert(url, { 1, QString("Type_Documents") });
+
+    obj.remove(url);
+    EXPECT_FALSE(obj.d->classified.contains(url));
+}
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/completionindex.h"
+
+#include <gtest/gtest.h>
+
+DPTITLEBAR_USE_NAMESPACE
+
+TEST(UT_CompletionIndex, match)
+{
+    CompletionIndex index({ "music", "Documents", "Downloads", "desktop", "Pictures" });
+    EXPECT_EQ(index.size(), 5);
+
+    // case insensitive, the ones matching the case first
+    EXPECT_EQ(index.match("D"), QStringList({ "Documents", "Downloads", "desktop" }));
+    EXPECT_EQ(index.match("do"), QStringList({ "Documents", "Downloads" }));
+    EXPECT_EQ(index.match("x"), QStringList());
+    EXPECT_EQ(index.match("").size(), 5);
+    EXPECT_EQ(index.match("", {}, 2).size(), 2);
+}
+
+TEST(UT_CompletionIndex, matchWithWeights)
+{
+    CompletionIndex index({ "Documents", "Downloads", "desktop" });
+    const QHash<QString, int> weights { { "Downloads", 3 }, { "desktop", 1 } };
+    EXPECT_EQ(index.match("d", weights), QStringList({ "Downloads", "desktop", "Documents" }));
+}
+
+TEST(UT_CompletionIndex, recordVisit)
+{
+    CompletionIndex::recordVisit("/home/test", "Downloads");
+    CompletionIndex::recordVisit("/home/test", "Downloads");
+    EXPECT_EQ(CompletionIndex::visitWeights("/home/test").value("Downloads"), 2);
+    EXPECT_TRUE(CompletionIndex::visitWeights("/home/other").isEmpty());
+}
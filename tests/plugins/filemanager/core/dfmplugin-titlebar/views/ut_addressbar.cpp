@@ -165,4 +165,15 @@ TEST(AddressBarPrivateTest, ut_onCompletionHighlighted)
     bar.d->inputIsIpAddress = false;
     bar.d->onCompletionHighlighted("test");
     EXPECT_EQ("123test", bar.text());
+
+    // the completed part is selected
+    bar.d->completionPrefix = "TE";
+    bar.d->onCompletionHighlighted("test");
+    EXPECT_EQ("st", bar.selectedText());
+
+    // a name matched by pinyin is selected as a whole
+    bar.d->completionPrefix = "wd";
+    bar.d->onCompletionHighlighted(QString::fromUtf8("文档"));
+    EXPECT_EQ(QString::fromUtf8("123文档"), bar.text());
+    EXPECT_EQ(QString::fromUtf8("文档"), bar.selectedText());
 }
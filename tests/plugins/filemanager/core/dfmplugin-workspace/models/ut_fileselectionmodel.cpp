@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+
+#include "plugins/filemanager/core/dfmplugin-workspace/models/fileselectionmodel.h"
+#include "plugins/filemanager/core/dfmplugin-workspace/models/private/fileselectionmodel_p.h"
+
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QStandardItemModel>
+
+#include <gtest/gtest.h>
+
+DFMGLOBAL_USE_NAMESPACE
+DPWORKSPACE_USE_NAMESPACE
+
+class UT_FileSelectionModel : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // rows 0-3 are files of 10, 20, 30, 40 bytes, row 4 is a folder
+        for (int row = 0; row < 5; ++row) {
+            auto item = new QStandardItem;
+            item->setData(QUrl::fromLocalFile(QString("/tmp/%1").arg(row)), ItemRoles::kItemUrlRole);
+            item->setData(row == 4, ItemRoles::kItemFileIsDirRole);
+            item->setData(qint64(row + 1) * 10, ItemRoles::kItemFileSizeIntRole);
+            model.appendRow(item);
+        }
+        selectionModel = new FileSelectionModel(&model);
+    }
+
+    void TearDown() override
+    {
+        delete selectionModel;
+        stub.clear();
+    }
+
+    void selectRows(int first, int last)
+    {
+        selectionModel->select(QItemSelection(model.index(first, 0), model.index(last, 0)),
+                               QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+    }
+
+    QStandardItemModel model;
+    FileSelectionModel *selectionModel { nullptr };
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_FileSelectionModel, selectionStatistics)
+{
+    selectRows(1, 4);
+    const auto &statistics = selectionModel->selectionStatistics();
+    EXPECT_EQ(3, statistics.fileCount);
+    EXPECT_EQ(1, statistics.folderCount);
+    EXPECT_EQ(90, statistics.fileSize);
+    EXPECT_EQ(QList<QUrl> { QUrl::fromLocalFile("/tmp/4") }, statistics.folderUrls);
+
+    selectRows(0, 0);
+    EXPECT_EQ(1, selectionModel->selectionStatistics().fileCount);
+    EXPECT_EQ(10, selectionModel->selectionStatistics().fileSize);
+}
+
+TEST_F(UT_FileSelectionModel, dataChangedIncremental)
+{
+    selectRows(1, 2);
+    EXPECT_EQ(50, selectionModel->selectionStatistics().fileSize);
+
+    int rebuilds = 0;
+    stub.set_lamda(&FileSelectionModelPrivate::rebuildStatistics, [&rebuilds] {
+        __DBG_STUB_INVOKE__
+        ++rebuilds;
+    });
+
+    // a selected file is grown
+    model.item(1)->setData(qint64(200), ItemRoles::kItemFileSizeIntRole);
+    // the unselected rows are not counted in
+    model.item(0)->setData(qint64(1000), ItemRoles::kItemFileSizeIntRole);
+    model.item(3)->setData(qint64(1000), ItemRoles::kItemFileSizeIntRole);
+
+    auto statistics = selectionModel->selectionStatistics();
+    EXPECT_EQ(0, rebuilds);
+    EXPECT_EQ(2, statistics.fileCount);
+    EXPECT_EQ(230, statistics.fileSize);
+
+    // a selected file is replaced by a folder
+    model.item(2)->setData(true, ItemRoles::kItemFileIsDirRole);
+    statistics = selectionModel->selectionStatistics();
+    EXPECT_EQ(0, rebuilds);
+    EXPECT_EQ(1, statistics.fileCount);
+    EXPECT_EQ(1, statistics.folderCount);
+    EXPECT_EQ(200, statistics.fileSize);
+
+    // the changed rows are removed as they were counted
+    selectRows(0, 0);
+    statistics = selectionModel->selectionStatistics();
+    EXPECT_EQ(0, rebuilds);
+    EXPECT_EQ(1, statistics.fileCount);
+    EXPECT_EQ(0, statistics.folderCount);
+    EXPECT_EQ(1000, statistics.fileSize);
+}
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "utils/fileinfoprefetcher.h"
+
+#include <gtest/gtest.h>
+
+#include <QSignalSpy>
+
+using namespace testing;
+DPWORKSPACE_USE_NAMESPACE
+
+class FileInfoPrefetcherTest : public Test
+{
+public:
+    void SetUp() override
+    {
+        stub.set_lamda(&FileInfoPrefetcher::prepareFileInfo, [this](FileInfoPrefetcher *, const QUrl &url) {
+            __DBG_STUB_INVOKE__
+            prepared.append(url);
+            if (onPrepare)
+                onPrepare(url);
+        });
+    }
+    void TearDown() override
+    {
+        stub.clear();
+    }
+
+    static QList<QUrl> urls(const QString &dir, int count)
+    {
+        QList<QUrl> ret;
+        for (int i = 0; i < count; ++i)
+            ret.append(QUrl::fromLocalFile(QString("%1/%2").arg(dir).arg(i)));
+        return ret;
+    }
+
+    stub_ext::StubExt stub;
+    QList<QUrl> prepared;
+    std::function<void(const QUrl &)> onPrepare;
+};
+
+TEST_F(FileInfoPrefetcherTest, prefetchHit)
+{
+    FileInfoPrefetcher prefetcher;
+    QSignalSpy spy(&prefetcher, &FileInfoPrefetcher::fileInfoPrepared);
+    const auto &visible = urls("/tmp/a", 2);
+    const auto &around = urls("/tmp/b", 2);
+
+    prefetcher.setRequests(visible, around + visible);
+    EXPECT_TRUE(prefetcher.isPending(visible.first()));
+    EXPECT_TRUE(prefetcher.isPending(around.first()));
+
+    prefetcher.processRequests();
+    // the visible rows first, every url once
+    EXPECT_EQ(visible + around, prepared);
+    EXPECT_EQ(4, spy.count());
+    EXPECT_EQ(visible.first(), spy.first().first().toUrl());
+    EXPECT_FALSE(prefetcher.isPending(visible.first()));
+    EXPECT_FALSE(prefetcher.isPending(around.last()));
+}
+
+TEST_F(FileInfoPrefetcherTest, cancelOnDirChanged)
+{
+    FileInfoPrefetcher prefetcher;
+    QSignalSpy spy(&prefetcher, &FileInfoPrefetcher::fileInfoPrepared);
+    const auto &visible = urls("/tmp/a", 3);
+
+    prefetcher.setRequests(visible, {});
+    prefetcher.cancel();
+    EXPECT_FALSE(prefetcher.isPending(visible.first()));
+    prefetcher.processRequests();
+    EXPECT_TRUE(prepared.isEmpty());
+
+    // the directory is changed while a url is being prepared
+    prefetcher.setRequests(visible, {});
+    onPrepare = [&prefetcher](const QUrl &) { prefetcher.cancel(); };
+    prefetcher.processRequests();
+    EXPECT_EQ(1, prepared.size());
+    EXPECT_EQ(0, spy.count());
+    EXPECT_FALSE(prefetcher.isPending(visible.last()));
+}
+
+TEST_F(FileInfoPrefetcherTest, invalidateByNewRange)
+{
+    FileInfoPrefetcher prefetcher;
+    QSignalSpy spy(&prefetcher, &FileInfoPrefetcher::fileInfoPrepared);
+    const auto &scrolledAway = urls("/tmp/a", 3);
+    const auto &visible = urls("/tmp/b", 2);
+
+    prefetcher.setRequests(scrolledAway, {});
+    prefetcher.setRequests(visible, {});
+    EXPECT_FALSE(prefetcher.isPending(scrolledAway.first()));
+    EXPECT_TRUE(prefetcher.isPending(visible.first()));
+
+    prefetcher.processRequests();
+    EXPECT_EQ(visible, prepared);
+    EXPECT_EQ(2, spy.count());
+
+    // the url requested again while it is prepared stays pending
+    prepared.clear();
+    prefetcher.setRequests(visible, {});
+    bool requested = false;
+    onPrepare = [&prefetcher, &visible, &requested](const QUrl &) {
+        if (!requested) {
+            requested = true;
+            prefetcher.setRequests(visible, {});
+        }
+    };
+    prefetcher.processRequests();
+    EXPECT_EQ(visible.first(), prepared.first());
+    EXPECT_EQ(3, prepared.size());
+    EXPECT_FALSE(prefetcher.isPending(visible.first()));
+}
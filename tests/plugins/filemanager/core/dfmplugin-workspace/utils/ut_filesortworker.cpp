@@ -70,3 +70,62 @@ TEST_F(UT_FileSortWorker, Bug_199473_handleUpdateFile)
 
     EXPECT_EQ(selectAndEditFile, updateFile);
 }
+
+TEST_F(UT_FileSortWorker, handleIteratorChildren_coalesced)
+{
+    stub.set_lamda(ADDR(FileSortWorker, checkFilters), []{
+        return true;
+    });
+
+    QList<QPair<int, int>> inserted;
+    QObject::connect(worker, &FileSortWorker::insertRows, worker, [&inserted](int first, int count){
+        inserted.append({ first, count });
+    });
+
+    auto makeSortInfo = [this](const QString &name) {
+        QUrl fileUrl(url);
+        fileUrl.setPath(url.path() + "/" + name);
+        SortInfoPointer sortInfo(new SortFileInfo());
+        sortInfo->setUrl(fileUrl);
+        sortInfo->setFile(true);
+        return sortInfo;
+    };
+
+    worker->handleIteratorChildren(key, { makeSortInfo("a") }, {});
+    worker->handleIteratorChildren(key, { makeSortInfo("b"), makeSortInfo("c") }, {});
+    EXPECT_TRUE(inserted.isEmpty());
+
+    // handling any other request inserts the pending children first
+    worker->handleTraversalFinish(key);
+    ASSERT_EQ(inserted.size(), 1);
+    EXPECT_EQ(inserted.first().first, 0);
+    EXPECT_EQ(inserted.first().second, 3);
+    EXPECT_EQ(worker->childrenCount(), 3);
+}
+
+TEST_F(UT_FileSortWorker, getChildShowIndex_afterRemove)
+{
+    stub.set_lamda(ADDR(FileSortWorker, checkFilters), []{
+        return true;
+    });
+
+    QList<SortInfoPointer> sortInfos;
+    for (const QString &name : { "a", "b", "c", "d" }) {
+        QUrl fileUrl(url);
+        fileUrl.setPath(url.path() + "/" + name);
+        SortInfoPointer sortInfo(new SortFileInfo());
+        sortInfo->setUrl(fileUrl);
+        sortInfo->setFile(true);
+        sortInfos.append(sortInfo);
+    }
+
+    worker->handleIteratorChildren(key, sortInfos, {});
+    worker->handleTraversalFinish(key);
+    EXPECT_EQ(worker->getChildShowIndex(sortInfos.at(2)->fileUrl()), 2);
+
+    worker->handleWatcherRemoveChildren({ sortInfos.at(1) });
+    EXPECT_EQ(worker->getChildShowIndex(sortInfos.at(1)->fileUrl()), -1);
+    EXPECT_EQ(worker->getChildShowIndex(sortInfos.at(0)->fileUrl()), 0);
+    EXPECT_EQ(worker->getChildShowIndex(sortInfos.at(2)->fileUrl()), 1);
+    EXPECT_EQ(worker->getChildShowIndex(sortInfos.at(3)->fileUrl()), 2);
+}